@@ -1,204 +1,601 @@
-#include <iostream>
-#include <unordered_map> 
-#include <list>
-#include <chrono>
-
-template <typename K, typename V>
-class LRUCache { 
-public:
-    using TimePoint = std::chrono::steady_clock::time_point; // 时间点(using 在这里等价于 typedef)
-
-    LRUCache();
-
-    LRUCache(size_t capacity); // 构造函数
-
-    bool get(const K& k, V& v); // 获取数据
-
-    void put(const K& k, const V& v, int ttl_seconds); // 存储数据
-
-    bool remove(const K& k); // 移除数据
-
-    void display(); // 打印缓存中的数据
-
-    void remove_expired(); // 移除过期数据
-
-private:
-    // 缓存节点
-    struct CacheNode {
-        K key;
-        V value;
-        TimePoint expire_time; // 过期时间
-    };
-    
-
-    // 缓存容量
-    size_t _capacity;
-
-    // key -> list iterator
-    // 哈希表（cache_map）：键是缓存数据的键，值是指向双向链表节点的迭代器/指针。
-    std::unordered_map<K, typename std::list<CacheNode>::iterator> cache_map;
-    
-    // list iterator -> key
-    // 存储缓存的键值对，最近使用的元素在链表的头部，最久未使用的元素在尾部。
-    std::list<CacheNode> cache_list;
-
-    // 判断是否过期
-    bool is_expired(const TimePoint& expire_time) const;
-};
-
-/*
- * 默认构造函数
- * 默认容量为3
- */
-template <typename K, typename V>
-LRUCache<K, V>::LRUCache() { 
-    this->_capacity = 3; // 默认容量为3
-}
-
-
-/**
- * 含参构造函数
- * @param capacity 缓存容量
- */
-template <typename K, typename V>
-LRUCache<K, V>::LRUCache(size_t capacity) { 
-    this->_capacity = capacity;
-}
-
-
-/**
- * 获取数据，更新访问顺序
- * @param key 键
- * @param value 值
- * @return bool
- */
-template <typename K, typename V>
-bool LRUCache<K, V>::get(const K& key, V& value) {
-    
-    auto it = cache_map.find(key);  // 在哈希表中查找键
-    
-    // 如果键不存在或者已经过期，返回false
-    if (it == cache_map.end()) { 
-        return false; // 如果键不存在，返回false
-    }
-
-    /*
-     * 惰性删除策略
-     * 在 get() 函数中：当从哈希表中找到某个键值时，我们不仅要返回数据，还要检查该数据是否过期。
-     * 过期处理：如果该数据过期，就将其从双向链表和哈希表中移除。
-     * 这就是“惰性删除”的核心，它只在访问时才删除过期的数据，而不在其他时间做定期清理。
-     * 未过期数据的处理：如果数据未过期，将该节点移动到双向链表的头部，表示它是最近使用的。
-     */
-    if (is_expired((*it->second).expire_time)) { 
-        cache_list.pop_back(); // 删除链表尾部节点
-        cache_map.erase(it); // 删除哈希表中对应的项
-        return false; // 如果键不存在，返回false
-    }
-
-    // 将数据移到链表头部，标识最近使用
-    cache_list.splice(cache_list.begin(), cache_list, it->second);
-    value = it->second->value; // 获取值
-
-    return true;
-}
-
-/**
- * 插入数据，更新访问顺序，支持过期时间
- * @param key 键
- * @param value 值
- * @param ttl_seconds 过期时间
- * @return void 
- */
-template <typename K, typename V>    
-void LRUCache<K, V>::put(const K& key, const V& value, int ttl_seconds) { 
-    
-    auto it = cache_map.find(key);
-
-    TimePoint expire_time = std::chrono::steady_clock::now() + std::chrono::seconds(ttl_seconds); // 计算过期时间
-
-    // 如果该键已经存在于缓存中，更新值并将其移动到链表头部
-    if (it != cache_map.end()) { 
-        // 更新已有节点
-        it->second->value = value; // 更新值
-        it->second->expire_time = expire_time; // 更新过期时间
-        cache_list.splice(cache_list.begin(), cache_list, it->second); // 移动到头部
-    } else { 
-        // 如果缓存容量已满，移除最久未使用的元素
-        if (cache_list.size() >= _capacity) { 
-            // 删除最久未使用的数据
-            K expired_key = cache_list.back().key; // 获取最久未使用的元素的键
-            cache_list.pop_back(); // 删除链表尾部节点
-            cache_map.erase(expired_key); // 删除哈希表中对应的项
-        }
-
-        // 插入新节点到链表头部
-        cache_list.emplace_front(CacheNode{key, value, expire_time}); 
-        cache_map[key] = cache_list.begin(); // 更新哈希表中对应的项
-    }
-
-    return;
-}
-
-/**
- * 打印缓存中的数据
- * @param void
- * @return void 
- */
-template <typename K, typename V>
-void LRUCache<K, V>::display() { 
-    for (const auto& item : cache_list) {
-        std::cout << item.key <<  ": " << item.value << std::endl;
-    }
-    std::cout << std::endl;
-
-    return;
-}
-
-/**
- * 移除数据
- * @param key 键 
- */
-template <typename K, typename V>
-bool LRUCache<K, V>::remove(const K& key) { 
-    auto it = cache_map.find(key); // 在哈希表中查找键
-
-    // 如果键不存在，返回false
-    if (it == cache_map.end()) { 
-        return false;
-    }
-
-    cache_list.erase(it->second); // 删除链表中的节点
-    cache_map.erase(it); // 删除哈希表中对应的项
-
-    return true;
-}
-
-/**
- * 移除过期数据
- * @param void
- * @return void
- * @note 主要用于定期清理过期数据
- */
-template <typename K, typename V>
-void LRUCache<K, V>::remove_expired() { 
-    
-    auto now = std::chrono::steady_clock::now(); // 获取当前时间
-
-    while (!cache_list.empty() && is_expired(cache_list.back().expire_time)) {
-        K expired_key = cache_list.back().key; // 获取最久未使用的元素的键
-        cache_list.pop_back(); // 删除链表尾部节点
-        cache_map.erase(expired_key); // 删除哈希表中对应的项
-    }
-
-    return;
-}
-
-/**
- * 判断是否过期
- * @param expire_time 过期时间
- * @return bool
- */
-template <typename K, typename V>
-bool LRUCache<K, V>::is_expired(const TimePoint& expire_time) const{
-    return std::chrono::steady_clock::now() > expire_time;
-}
\ No newline at end of file
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include "cache_policy.h"
+
+#define LRU_DEFAULT_SHARDS 16 // ShardedLRUCache 默认的分片数
+#define LRU_MIN_SHARD_CAPACITY 64 // 每个分片的最小容量，容量较小时减少分片数，保持接近全局 LRU 的淘汰顺序
+
+/* ************************************************************************
+> LRU 缓存
+> 存储结构：
+    > 槽位数组 _nodes：构造时按容量一次分配，每个槽位存放键、值、过期时间和键的哈希值；空闲槽位的下标存放在 _free 栈中
+    > 索引 _index：开放寻址的 Robin Hood 哈希表，桶中只存槽位下标和 32 位哈希值
+    > 淘汰策略 _policy：由模板参数 Policy 指定（见 cache_policy.h），默认为 LRUPolicy；
+      访问顺序等元数据由策略自己按槽位下标保存，缓存满时由策略选出被淘汰的槽位
+    > 过期索引 _expiry_heap：按过期时间排列的二叉小顶堆，元素为槽位下标，槽位记录自己在堆中的位置；
+      永不过期的条目不进堆。remove_expired 只需不断弹出堆顶，代价为 O(过期条目数 × log n)，
+      不依赖过期条目恰好位于 LRU 链表的尾部
+> 与 std::list + std::unordered_map 相比：
+    > 缓存填满之后，put / get / remove 都不再申请内存（键值类型自身的内存除外）
+    > 每个条目省去了链表节点、哈希节点两次分配以及它们的指针开销，查找时也少了两次指针跳转
+> 下标使用 uint32_t，容量上限约为 40 亿
+ ************************************************************************/
+
+template <typename K, typename V, typename Policy = LRUPolicy>
+class LRUCache { 
+public:
+    using TimePoint = std::chrono::steady_clock::time_point; // 时间点(using 在这里等价于 typedef)
+
+    LRUCache();
+
+    LRUCache(size_t capacity); // 构造函数
+
+    bool get(const K& k, V& v); // 获取数据
+
+    void put(const K& k, const V& v, int ttl_seconds); // 存储数据
+
+    bool remove(const K& k); // 移除数据
+
+    void display(); // 打印缓存中的数据
+
+    void remove_expired(); // 移除过期数据
+
+    void clear(); // 清空缓存
+
+    size_t size() const; // 当前条目数
+
+private:
+    static const uint32_t NIL = 0xFFFFFFFF; // 空下标
+
+    // 缓存节点（槽位）
+    struct CacheNode {
+        K key;
+        V value;
+        TimePoint expire_time; // 过期时间
+        uint32_t hash; // 键的哈希值，淘汰时不必重新计算
+        uint32_t heap_pos; // 在 _expiry_heap 中的位置，不在堆中时为 NIL
+    };
+
+    // 索引桶，slot 为 NIL 表示空桶
+    struct Bucket {
+        uint32_t slot; // 槽位下标
+        uint32_t hash; // 键的哈希值，探测时先比较哈希值，避免访问槽位
+    };
+
+    // 缓存容量
+    size_t _capacity;
+    size_t _size; // 当前条目数
+
+    std::vector<CacheNode> _nodes; // 槽位数组
+    std::vector<Bucket> _index; // 开放寻址索引，大小为 2 的幂
+    size_t _index_mask; // _index.size() - 1
+
+    std::vector<uint32_t> _free; // 空闲槽位栈
+    std::vector<uint32_t> _expiry_heap; // 按过期时间排列的小顶堆，容量已预留
+    Policy _policy; // 淘汰策略
+
+    void init(size_t capacity); // 分配槽位和索引
+    static uint32_t hash_of(const K& k); // 计算键的哈希值
+    size_t find_bucket(const K& k, uint32_t hash) const; // 查找键所在的桶，找不到返回 NIL
+    void index_insert(uint32_t slot, uint32_t hash); // 把槽位插入索引
+    void index_erase(size_t bucket); // 从索引中删除一个桶（后移删除，不留墓碑）
+    void erase_slot(uint32_t slot, size_t bucket); // 删除条目并归还槽位
+    void heap_set_expire(uint32_t slot, const TimePoint& expire_time); // 设置过期时间并调整过期索引
+    void heap_erase(uint32_t slot); // 从过期索引中删除槽位
+    void heap_sift_up(size_t pos); // 向上调整
+    void heap_sift_down(size_t pos); // 向下调整
+
+    // 判断是否过期
+    bool is_expired(const TimePoint& expire_time) const;
+};
+
+/*
+ * 默认构造函数
+ * 默认容量为3
+ */
+template <typename K, typename V, typename Policy>
+LRUCache<K, V, Policy>::LRUCache() { 
+    init(3); // 默认容量为3
+}
+
+
+/**
+ * 含参构造函数
+ * @param capacity 缓存容量
+ */
+template <typename K, typename V, typename Policy>
+LRUCache<K, V, Policy>::LRUCache(size_t capacity) { 
+    init(capacity);
+}
+
+/**
+ * 分配槽位和索引
+ * @param capacity 缓存容量
+ * @note 索引的负载因子不超过 3/4，Robin Hood 探测在这个负载下平均探测长度很短
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::init(size_t capacity) {
+    this->_capacity = capacity > 0 ? capacity : 1;
+    this->_size = 0;
+
+    _nodes.assign(_capacity, CacheNode{K{}, V{}, TimePoint{}, 0, NIL});
+    _free.resize(_capacity);
+    for (size_t i = 0; i < _capacity; i++) { // 所有槽位都空闲，从 0 号开始使用
+        _free[i] = (uint32_t)(_capacity - 1 - i);
+    }
+    _expiry_heap.clear();
+    _expiry_heap.reserve(_capacity);
+    _policy.init(_capacity);
+
+    size_t buckets = 8;
+    while (buckets * 3 < _capacity * 4) {
+        buckets *= 2;
+    }
+    _index.assign(buckets, Bucket{NIL, 0});
+    _index_mask = buckets - 1;
+}
+
+/**
+ * 计算键的哈希值
+ * @note std::hash 对整数是恒等映射，乘以黄金分割常数打散后取高 32 位；
+ *       ShardedLRUCache 用乘积的最高几位选择分片，与这里使用的低位互不相关
+ */
+template <typename K, typename V, typename Policy>
+uint32_t LRUCache<K, V, Policy>::hash_of(const K& k) {
+    uint64_t h = (uint64_t)std::hash<K>{}(k) * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(h >> 32);
+}
+
+/**
+ * 查找键所在的桶
+ * @return size_t 桶下标，找不到返回 NIL
+ * @note Robin Hood 不变式：探测距离超过当前桶中元素的探测距离时，键一定不存在
+ */
+template <typename K, typename V, typename Policy>
+size_t LRUCache<K, V, Policy>::find_bucket(const K& k, uint32_t hash) const {
+    size_t pos = hash & _index_mask;
+    for (size_t dist = 0; ; dist++, pos = (pos + 1) & _index_mask) {
+        const Bucket& b = _index[pos];
+        if (b.slot == NIL || ((pos - (b.hash & _index_mask)) & _index_mask) < dist) {
+            return NIL;
+        }
+        if (b.hash == hash && _nodes[b.slot].key == k) {
+            return pos;
+        }
+    }
+}
+
+/**
+ * 把槽位插入索引
+ * @note 探测过程中遇到比自己"富"（探测距离更短）的元素就与它交换，继续为被换出的元素找位置
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::index_insert(uint32_t slot, uint32_t hash) {
+    Bucket cur{slot, hash};
+    size_t pos = hash & _index_mask;
+    for (size_t dist = 0; ; dist++, pos = (pos + 1) & _index_mask) {
+        Bucket& b = _index[pos];
+        if (b.slot == NIL) {
+            b = cur;
+            return;
+        }
+        size_t b_dist = (pos - (b.hash & _index_mask)) & _index_mask;
+        if (b_dist < dist) {
+            std::swap(b, cur);
+            dist = b_dist;
+        }
+    }
+}
+
+/**
+ * 从索引中删除一个桶
+ * @note 把后面不在自己理想位置上的元素依次前移一格，不需要墓碑
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::index_erase(size_t pos) {
+    size_t next = (pos + 1) & _index_mask;
+    while (_index[next].slot != NIL && ((next - (_index[next].hash & _index_mask)) & _index_mask) != 0) {
+        _index[pos] = _index[next];
+        pos = next;
+        next = (next + 1) & _index_mask;
+    }
+    _index[pos].slot = NIL;
+}
+
+/**
+ * 删除条目并归还槽位
+ * @param slot 槽位
+ * @param bucket 该条目在索引中的桶
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::erase_slot(uint32_t slot, size_t bucket) {
+    index_erase(bucket);
+    _policy.on_erase(slot);
+    heap_erase(slot); // 键值保留在槽位中，下次使用时直接赋值覆盖，复用其内存
+    _free.push_back(slot); // 容量已预留，不会重新分配
+    _size--;
+}
+
+/**
+ * 设置过期时间并调整过期索引
+ * @param slot 槽位
+ * @param expire_time 过期时间，TimePoint::max() 表示永不过期，此时从堆中移除
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::heap_set_expire(uint32_t slot, const TimePoint& expire_time) {
+    CacheNode& n = _nodes[slot];
+    TimePoint old_time = n.expire_time;
+    n.expire_time = expire_time;
+
+    if (expire_time == TimePoint::max()) {
+        heap_erase(slot);
+    } else if (n.heap_pos == NIL) {
+        n.heap_pos = (uint32_t)_expiry_heap.size();
+        _expiry_heap.push_back(slot);
+        heap_sift_up(n.heap_pos);
+    } else if (expire_time < old_time) {
+        heap_sift_up(n.heap_pos);
+    } else {
+        heap_sift_down(n.heap_pos);
+    }
+}
+
+/**
+ * 从过期索引中删除槽位
+ * @note 用堆的最后一个元素填补空位，再按它的过期时间向上或向下调整
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::heap_erase(uint32_t slot) {
+    uint32_t pos = _nodes[slot].heap_pos;
+    if (pos == NIL) {
+        return;
+    }
+    _nodes[slot].heap_pos = NIL;
+    uint32_t last = _expiry_heap.back();
+    _expiry_heap.pop_back();
+    if (last == slot) {
+        return;
+    }
+    _expiry_heap[pos] = last;
+    _nodes[last].heap_pos = pos;
+    heap_sift_up(pos);
+    heap_sift_down(_nodes[last].heap_pos);
+}
+
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::heap_sift_up(size_t pos) {
+    uint32_t slot = _expiry_heap[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!(_nodes[slot].expire_time < _nodes[_expiry_heap[parent]].expire_time)) {
+            break;
+        }
+        _expiry_heap[pos] = _expiry_heap[parent];
+        _nodes[_expiry_heap[pos]].heap_pos = (uint32_t)pos;
+        pos = parent;
+    }
+    _expiry_heap[pos] = slot;
+    _nodes[slot].heap_pos = (uint32_t)pos;
+}
+
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::heap_sift_down(size_t pos) {
+    uint32_t slot = _expiry_heap[pos];
+    size_t n = _expiry_heap.size();
+    while (true) {
+        size_t child = pos * 2 + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n && _nodes[_expiry_heap[child + 1]].expire_time < _nodes[_expiry_heap[child]].expire_time) {
+            child++;
+        }
+        if (!(_nodes[_expiry_heap[child]].expire_time < _nodes[slot].expire_time)) {
+            break;
+        }
+        _expiry_heap[pos] = _expiry_heap[child];
+        _nodes[_expiry_heap[pos]].heap_pos = (uint32_t)pos;
+        pos = child;
+    }
+    _expiry_heap[pos] = slot;
+    _nodes[slot].heap_pos = (uint32_t)pos;
+}
+
+
+/**
+ * 获取数据，更新访问顺序
+ * @param key 键
+ * @param value 值
+ * @return bool
+ */
+template <typename K, typename V, typename Policy>
+bool LRUCache<K, V, Policy>::get(const K& key, V& value) {
+    
+    uint32_t hash = hash_of(key);
+    _policy.record(hash); // 未命中也计入访问频率
+    size_t bucket = find_bucket(key, hash);  // 在索引中查找键
+    
+    // 如果键不存在或者已经过期，返回false
+    if (bucket == NIL) { 
+        return false; // 如果键不存在，返回false
+    }
+    uint32_t slot = _index[bucket].slot;
+
+    /*
+     * 惰性删除策略
+     * 在 get() 函数中：当从哈希表中找到某个键值时，我们不仅要返回数据，还要检查该数据是否过期。
+     * 过期处理：如果该数据过期，就将其从双向链表和哈希表中移除。
+     * 这就是“惰性删除”的核心，它只在访问时才删除过期的数据，而不在其他时间做定期清理。
+     * 未过期数据的处理：如果数据未过期，将该节点移动到双向链表的头部，表示它是最近使用的。
+     */
+    if (is_expired(_nodes[slot].expire_time)) { 
+        erase_slot(slot, bucket); // 删除过期的节点（不一定在链表尾部）
+        return false; // 如果键不存在，返回false
+    }
+
+    _policy.on_hit(slot); // 更新访问顺序，LRU 策略下移到链表头部，标识最近使用
+    value = _nodes[slot].value; // 获取值
+
+    return true;
+}
+
+/**
+ * 插入数据，更新访问顺序，支持过期时间
+ * @param key 键
+ * @param value 值
+ * @param ttl_seconds 过期时间
+ * @return void 
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::put(const K& key, const V& value, int ttl_seconds) { 
+    
+    uint32_t hash = hash_of(key);
+    _policy.record(hash);
+    size_t bucket = find_bucket(key, hash);
+
+    // 计算过期时间，ttl_seconds 为 -1 时永不过期（与 SkipListWithCache 的 PERMANENT_TTL 一致）
+    TimePoint expire_time = ttl_seconds < 0 ? TimePoint::max() : std::chrono::steady_clock::now() + std::chrono::seconds(ttl_seconds);
+
+    // 如果该键已经存在于缓存中，更新值并将其移动到链表头部
+    if (bucket != NIL) { 
+        uint32_t slot = _index[bucket].slot;
+        _nodes[slot].value = value; // 更新值
+        heap_set_expire(slot, expire_time); // 更新过期时间
+        _policy.on_hit(slot); // 移动到头部
+        return;
+    }
+
+    // 如果缓存容量已满，由策略选出被淘汰的元素（LRU 策略下为最久未使用的元素），空出它的槽位
+    if (_size >= _capacity) { 
+        uint32_t victim = _policy.victim(hash);
+        erase_slot(victim, find_bucket(_nodes[victim].key, _nodes[victim].hash));
+    }
+
+    // 取一个空闲槽位，交给策略记录（LRU 策略下插入到链表头部）
+    uint32_t slot = _free.back();
+    _free.pop_back();
+    _nodes[slot].key = key;
+    _nodes[slot].value = value;
+    _nodes[slot].expire_time = TimePoint::max(); // 槽位不在堆中，由 heap_set_expire 放入
+    _nodes[slot].hash = hash;
+    heap_set_expire(slot, expire_time);
+    _policy.on_insert(slot, hash);
+    index_insert(slot, hash); // 更新索引
+    _size++;
+
+    return;
+}
+
+/**
+ * 打印缓存中的数据
+ * @param void
+ * @return void 
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::display() { 
+    _policy.for_each([this](uint32_t slot) { // 按策略的顺序，LRU 策略下从最近使用到最久未使用
+        std::cout << _nodes[slot].key <<  ": " << _nodes[slot].value << std::endl;
+    });
+    std::cout << std::endl;
+
+    return;
+}
+
+/**
+ * 移除数据
+ * @param key 键 
+ */
+template <typename K, typename V, typename Policy>
+bool LRUCache<K, V, Policy>::remove(const K& key) { 
+    size_t bucket = find_bucket(key, hash_of(key)); // 在索引中查找键
+
+    // 如果键不存在，返回false
+    if (bucket == NIL) { 
+        return false;
+    }
+
+    erase_slot(_index[bucket].slot, bucket); // 删除链表中的节点和索引中对应的项
+
+    return true;
+}
+
+/**
+ * 移除过期数据
+ * @param void
+ * @return void
+ * @note 主要用于定期清理过期数据；过期条目不一定位于 LRU 链表的尾部，按过期索引从最早过期的开始删除
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::remove_expired() { 
+    
+    TimePoint now = std::chrono::steady_clock::now();
+    while (!_expiry_heap.empty() && now > _nodes[_expiry_heap[0]].expire_time) {
+        uint32_t slot = _expiry_heap[0]; // 最早过期的条目
+        erase_slot(slot, find_bucket(_nodes[slot].key, _nodes[slot].hash));
+    }
+
+    return;
+}
+
+/**
+ * 清空缓存
+ * @param void
+ * @return void
+ */
+template <typename K, typename V, typename Policy>
+void LRUCache<K, V, Policy>::clear() {
+    init(_capacity);
+}
+
+/**
+ * 当前条目数
+ * @return size_t
+ */
+template <typename K, typename V, typename Policy>
+size_t LRUCache<K, V, Policy>::size() const {
+    return _size;
+}
+
+/**
+ * 判断是否过期
+ * @param expire_time 过期时间
+ * @return bool
+ */
+template <typename K, typename V, typename Policy>
+bool LRUCache<K, V, Policy>::is_expired(const TimePoint& expire_time) const{
+    return std::chrono::steady_clock::now() > expire_time;
+}
+
+/* ************************************************************************
+> 分片的 LRU 缓存（锁分段）
+> 思路：
+    > LRUCache 本身不是线程安全的，整个缓存共用一把锁时，所有线程在这把锁上排队
+    > 把缓存按键的哈希值分成 N 个独立的 LRUCache，每个分片有自己的锁，不同分片上的操作互不影响
+    > 每个分片独立淘汰，总容量与单个 LRUCache 相同；淘汰顺序只在分片内是严格的 LRU
+> 分片数为 2 的幂，且保证每个分片至少 LRU_MIN_SHARD_CAPACITY 个位置；容量很小时退化为单个分片
+ ************************************************************************/
+
+template <typename K, typename V, typename Policy = LRUPolicy, typename Hash = std::hash<K>>
+class ShardedLRUCache {
+public:
+    ShardedLRUCache(size_t capacity, size_t shard_count = LRU_DEFAULT_SHARDS); // 构造函数
+    ShardedLRUCache(const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+    bool get(const K& k, V& v); // 获取数据
+    void put(const K& k, const V& v, int ttl_seconds); // 存储数据
+    bool remove(const K& k); // 移除数据
+    void display(); // 按分片顺序打印缓存中的数据
+    void remove_expired(); // 移除所有分片中的过期数据
+    void clear(); // 清空缓存
+    size_t shard_count() const; // 分片数
+
+private:
+    // 每个分片独占缓存行，避免相邻分片的锁发生伪共享
+    struct alignas(64) Shard {
+        std::mutex mtx; // 分片锁
+        LRUCache<K, V, Policy> cache; // 分片内的缓存
+    };
+
+    Shard& shard_for(const K& k); // 根据键的哈希值选择分片
+
+    std::unique_ptr<Shard[]> _shards; // 分片数组
+    size_t _shard_count; // 分片数
+    int _shard_bits; // log2(_shard_count)
+    Hash _hash; // 哈希函数
+};
+
+/**
+ * 构造函数
+ * @param capacity 总容量
+ * @param shard_count 期望的分片数，会向下调整为 2 的幂，并保证每个分片的容量不小于 LRU_MIN_SHARD_CAPACITY
+ */
+template <typename K, typename V, typename Policy, typename Hash>
+ShardedLRUCache<K, V, Policy, Hash>::ShardedLRUCache(size_t capacity, size_t shard_count) {
+    size_t n = 1;
+    _shard_bits = 0;
+    while (n * 2 <= shard_count && capacity / (n * 2) >= LRU_MIN_SHARD_CAPACITY) {
+        n *= 2;
+        _shard_bits++;
+    }
+    _shard_count = n;
+    _shards.reset(new Shard[n]);
+
+    size_t per_shard = (capacity + n - 1) / n; // 向上取整，总容量不小于 capacity
+    for (size_t i = 0; i < n; i++) {
+        _shards[i].cache = LRUCache<K, V, Policy>(per_shard);
+    }
+}
+
+/**
+ * 根据键选择分片
+ * @param k 键
+ * @return Shard& 分片
+ * @note std::hash 对整数是恒等映射，先乘以黄金分割常数打散，再取最高的几位；
+ *       分片内的 LRUCache 用第 32 位起的低位定位桶，两者互不相关
+ */
+template <typename K, typename V, typename Policy, typename Hash>
+typename ShardedLRUCache<K, V, Policy, Hash>::Shard& ShardedLRUCache<K, V, Policy, Hash>::shard_for(const K& k) {
+    uint64_t h = (uint64_t)_hash(k) * 0x9E3779B97F4A7C15ULL;
+    return _shards[_shard_bits == 0 ? 0 : (h >> (64 - _shard_bits))];
+}
+
+template <typename K, typename V, typename Policy, typename Hash>
+bool ShardedLRUCache<K, V, Policy, Hash>::get(const K& k, V& v) {
+    Shard& shard = shard_for(k);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    return shard.cache.get(k, v);
+}
+
+template <typename K, typename V, typename Policy, typename Hash>
+void ShardedLRUCache<K, V, Policy, Hash>::put(const K& k, const V& v, int ttl_seconds) {
+    Shard& shard = shard_for(k);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.cache.put(k, v, ttl_seconds);
+}
+
+template <typename K, typename V, typename Policy, typename Hash>
+bool ShardedLRUCache<K, V, Policy, Hash>::remove(const K& k) {
+    Shard& shard = shard_for(k);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    return shard.cache.remove(k);
+}
+
+template <typename K, typename V, typename Policy, typename Hash>
+void ShardedLRUCache<K, V, Policy, Hash>::display() {
+    for (size_t i = 0; i < _shard_count; i++) {
+        std::lock_guard<std::mutex> lock(_shards[i].mtx);
+        _shards[i].cache.display();
+    }
+}
+
+/**
+ * 移除过期数据
+ * @note 逐个分片加锁，任意时刻只阻塞一个分片
+ */
+template <typename K, typename V, typename Policy, typename Hash>
+void ShardedLRUCache<K, V, Policy, Hash>::remove_expired() {
+    for (size_t i = 0; i < _shard_count; i++) {
+        std::lock_guard<std::mutex> lock(_shards[i].mtx);
+        _shards[i].cache.remove_expired();
+    }
+}
+
+template <typename K, typename V, typename Policy, typename Hash>
+void ShardedLRUCache<K, V, Policy, Hash>::clear() {
+    for (size_t i = 0; i < _shard_count; i++) {
+        std::lock_guard<std::mutex> lock(_shards[i].mtx);
+        _shards[i].cache.clear();
+    }
+}
+
+template <typename K, typename V, typename Policy, typename Hash>
+size_t ShardedLRUCache<K, V, Policy, Hash>::shard_count() const {
+    return _shard_count;
+}
@@ -0,0 +1,90 @@
+#ifndef BLOCK_PROBE_H
+#define BLOCK_PROBE_H
+
+#include <cstdint>
+#include <algorithm>
+#if !defined(BLOCK_PROBE_SCALAR) && (defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+/* ************************************************************************
+> 块内查找：在 count 个升序排列的键中找第一个不小于 key 的位置
+> 通用版本：二分查找，只要求键类型提供 operator<
+> int 键：块内的键连续存放，"第一个不小于 key 的位置" 就是 "小于 key 的键的个数"，
+  一条比较指令比较一整组键，没有依赖数据的分支。键有序，小于 key 的键是一段前缀，
+  比较结果的掩码是低位连续的 1，个数为 ctz(~mask)，不依赖 popcnt 指令：
+    > AVX-512：一次比较 16 个键
+    > AVX2：一次比较 8 个键
+    > SSE2：一次比较 4 个键
+    > 不足一组的尾部和没有 SIMD 的平台用标量逐个累加比较结果（同样没有分支，编译器可能自动向量化）
+> 按编译选项在编译期选择指令集（-mavx512f / -mavx2 / -march=native），默认的 x86-64 只有 SSE2；
+  定义 BLOCK_PROBE_SCALAR 可以强制使用标量版本，便于对照
+> 只读取前 count 个键，不会越过有效范围
+ ************************************************************************/
+
+/**
+ * 块内查找（通用版本）
+ * @param keys 有序的键数组
+ * @param count 键数
+ * @param key 要查找的键
+ * @return int 第一个不小于 key 的位置，都小于 key 时返回 count
+ */
+template <typename K>
+inline int block_lower_bound(const K* keys, int count, const K& key) {
+    return (int)(std::lower_bound(keys, keys + count, key) - keys);
+}
+
+/**
+ * 块内查找（标量计数版本）
+ * @return int 小于 key 的键的个数，对有序数组即第一个不小于 key 的位置
+ */
+inline int block_count_less_scalar(const int* keys, int count, int key) {
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        n += keys[i] < key;
+    }
+    return n;
+}
+
+/**
+ * 块内查找（int 键）
+ * @param keys 有序的键数组
+ * @param count 键数
+ * @param key 要查找的键
+ * @return int 第一个不小于 key 的位置，都小于 key 时返回 count
+ */
+inline int block_lower_bound(const int* keys, int count, const int& key) {
+    int n = 0;
+    int i = 0;
+#if defined(BLOCK_PROBE_SCALAR)
+#elif defined(__AVX512F__)
+    __m512i needle = _mm512_set1_epi32(key);
+    for (; i + 16 <= count; i += 16) {
+        __m512i block = _mm512_loadu_si512((const void*)(keys + i));
+        n += __builtin_ctz(~(unsigned)_mm512_cmplt_epi32_mask(block, needle));
+    }
+    if (i < count) { // 尾部用掩码加载，无效的位置不参与比较
+        __mmask16 valid = (__mmask16)((1u << (count - i)) - 1);
+        __m512i block = _mm512_maskz_loadu_epi32(valid, keys + i);
+        n += __builtin_ctz(~(unsigned)_mm512_mask_cmplt_epi32_mask(valid, block, needle));
+        i = count;
+    }
+#elif defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi32(key);
+    for (; i + 8 <= count; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(keys + i));
+        __m256i less = _mm256_cmpgt_epi32(needle, block); // keys[i] < key 的位置全为 1
+        n += __builtin_ctz(~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(less)));
+    }
+#elif defined(__SSE2__)
+    __m128i needle = _mm_set1_epi32(key);
+    for (; i + 4 <= count; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(keys + i));
+        __m128i less = _mm_cmplt_epi32(block, needle);
+        n += __builtin_ctz(~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(less)));
+    }
+#endif
+    return n + block_count_less_scalar(keys + i, count - i, key);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#define BLOOM_HASH_COUNT 3 // 每个键置位的个数
+
+/* ************************************************************************
+> 只记录"最近"键的布隆过滤器
+> 位数组用原子整数存放，多个线程可以在共享锁下同时 add / contains
+> 添加的键数达到上限后整体清空，重新开始记录，因此只反映最近一段时间内出现过的键，内存固定不变
+> 判断结果可能误报（不存在的键返回 true），不会漏报（清空之前添加过的键一定返回 true）
+ ************************************************************************/
+
+template <typename K, typename Hash = std::hash<K>>
+class RecentBloomFilter {
+public:
+    RecentBloomFilter(size_t capacity); // 构造函数
+    RecentBloomFilter(const RecentBloomFilter&) = delete;
+    RecentBloomFilter& operator=(const RecentBloomFilter&) = delete;
+
+    bool add(const K& k); // 添加键，返回添加之前是否已经存在
+    bool contains(const K& k) const; // 键是否（可能）存在
+    void clear(); // 清空
+
+private:
+    void positions(const K& k, size_t pos[BLOOM_HASH_COUNT]) const; // 计算键对应的位
+
+    std::unique_ptr<std::atomic<uint64_t>[]> _bits; // 位数组
+    size_t _words; // 位数组的字数
+    size_t _bit_mask; // 位数 - 1，位数为 2 的幂
+    size_t _capacity; // 清空之前最多添加的键数
+    std::atomic<size_t> _count; // 自上次清空以来添加的键数
+    Hash _hash; // 哈希函数
+};
+
+/**
+ * 构造函数
+ * @param capacity 清空之前最多记录的键数
+ * @note 每个键约 10 位，3 个哈希时误报率约 2%
+ */
+template <typename K, typename Hash>
+RecentBloomFilter<K, Hash>::RecentBloomFilter(size_t capacity) : _capacity(capacity > 0 ? capacity : 1), _count(0) {
+    size_t bits = 64;
+    while (bits < _capacity * 10) {
+        bits *= 2;
+    }
+    _bit_mask = bits - 1;
+    _words = bits / 64;
+    _bits.reset(new std::atomic<uint64_t>[_words]);
+    for (size_t i = 0; i < _words; i++) {
+        _bits[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * 计算键对应的位
+ * @note 双重哈希：第 i 个位置为 h1 + i * h2，h1、h2 取自打散后哈希值的高低 32 位
+ */
+template <typename K, typename Hash>
+void RecentBloomFilter<K, Hash>::positions(const K& k, size_t pos[BLOOM_HASH_COUNT]) const {
+    uint64_t h = (uint64_t)_hash(k) * 0x9E3779B97F4A7C15ULL;
+    uint32_t h1 = (uint32_t)(h >> 32);
+    uint32_t h2 = (uint32_t)h | 1;
+    for (int i = 0; i < BLOOM_HASH_COUNT; i++) {
+        pos[i] = (h1 + (size_t)i * h2) & _bit_mask;
+    }
+}
+
+/**
+ * 添加键
+ * @param k 键
+ * @return bool 添加之前是否已经（可能）存在
+ */
+template <typename K, typename Hash>
+bool RecentBloomFilter<K, Hash>::add(const K& k) {
+    size_t pos[BLOOM_HASH_COUNT];
+    positions(k, pos);
+    bool existed = true;
+    for (int i = 0; i < BLOOM_HASH_COUNT; i++) {
+        uint64_t bit = 1ULL << (pos[i] & 63);
+        if (!(_bits[pos[i] >> 6].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+            existed = false;
+        }
+    }
+    if (!existed && _count.fetch_add(1, std::memory_order_relaxed) + 1 >= _capacity) {
+        clear(); // 记录的键太多，误报率上升，重新开始
+    }
+    return existed;
+}
+
+template <typename K, typename Hash>
+bool RecentBloomFilter<K, Hash>::contains(const K& k) const {
+    size_t pos[BLOOM_HASH_COUNT];
+    positions(k, pos);
+    for (int i = 0; i < BLOOM_HASH_COUNT; i++) {
+        if (!(_bits[pos[i] >> 6].load(std::memory_order_relaxed) & (1ULL << (pos[i] & 63)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename K, typename Hash>
+void RecentBloomFilter<K, Hash>::clear() {
+    for (size_t i = 0; i < _words; i++) {
+        _bits[i].store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+}
+
+#endif
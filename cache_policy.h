@@ -0,0 +1,334 @@
+#ifndef CACHE_POLICY_H
+#define CACHE_POLICY_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/* ************************************************************************
+> LRUCache 的淘汰/准入策略
+> LRUCache 负责存储（槽位数组 + 开放寻址索引），策略只负责决定"淘汰谁"，两者之间只传递槽位下标和键的哈希值
+> 策略需要提供的接口：
+    > init(capacity)：按容量分配元数据，之后不再申请内存
+    > record(hash)：每次访问（命中或未命中）都会调用，用于频率统计
+    > on_insert(slot, hash)：新条目放进了 slot
+    > on_hit(slot)：slot 被访问
+    > on_erase(slot)：slot 被删除（remove、过期）
+    > victim(hash)：缓存已满，哈希为 hash 的新键即将插入，返回要淘汰的槽位
+    > for_each(f)：按策略自己的顺序遍历所有条目，用于 display
+> 已实现的策略：
+    > LRUPolicy：最近最少使用，淘汰链表尾部
+    > ClockPolicy：CLOCK 近似 LRU，新条目的访问位为 0，只被访问过一次的条目（如扫描）会先被淘汰
+    > WTinyLFUPolicy：W-TinyLFU，1% 的窗口 LRU + 99% 的分段 LRU 主区，
+      窗口淘汰出的候选者与主区的淘汰者比较 Count-Min Sketch 中的访问频率，频率低的被淘汰，抗扫描
+ ************************************************************************/
+
+#define CACHE_POLICY_NIL 0xFFFFFFFFu // 空下标
+
+/*
+ * 侵入式双向链表，节点为槽位下标，前后指针存放在外部数组中
+ * 多个链表可以共用同一组 prev / next 数组（每个槽位同一时刻只属于一个链表）
+ */
+struct SlotList {
+    uint32_t head = CACHE_POLICY_NIL; // 最近使用
+    uint32_t tail = CACHE_POLICY_NIL; // 最久未使用
+    size_t size = 0;
+
+    void push_front(uint32_t slot, std::vector<uint32_t>& prev, std::vector<uint32_t>& next) {
+        prev[slot] = CACHE_POLICY_NIL;
+        next[slot] = head;
+        if (head != CACHE_POLICY_NIL) {
+            prev[head] = slot;
+        } else {
+            tail = slot;
+        }
+        head = slot;
+        size++;
+    }
+
+    void unlink(uint32_t slot, std::vector<uint32_t>& prev, std::vector<uint32_t>& next) {
+        if (prev[slot] != CACHE_POLICY_NIL) {
+            next[prev[slot]] = next[slot];
+        } else {
+            head = next[slot];
+        }
+        if (next[slot] != CACHE_POLICY_NIL) {
+            prev[next[slot]] = prev[slot];
+        } else {
+            tail = prev[slot];
+        }
+        size--;
+    }
+};
+
+/************************************************************************
+> LRU 策略
+ ************************************************************************/
+
+class LRUPolicy {
+public:
+    void init(size_t capacity) {
+        _prev.assign(capacity, CACHE_POLICY_NIL);
+        _next.assign(capacity, CACHE_POLICY_NIL);
+        _list = SlotList();
+    }
+    void record(uint32_t) {}
+    void on_insert(uint32_t slot, uint32_t) {
+        _list.push_front(slot, _prev, _next);
+    }
+    void on_hit(uint32_t slot) {
+        if (_list.head != slot) { // 移到链表头部
+            _list.unlink(slot, _prev, _next);
+            _list.push_front(slot, _prev, _next);
+        }
+    }
+    void on_erase(uint32_t slot) {
+        _list.unlink(slot, _prev, _next);
+    }
+    uint32_t victim(uint32_t) {
+        return _list.tail;
+    }
+    template <typename F>
+    void for_each(F f) const {
+        for (uint32_t slot = _list.head; slot != CACHE_POLICY_NIL; slot = _next[slot]) {
+            f(slot);
+        }
+    }
+
+private:
+    std::vector<uint32_t> _prev; // 前一个槽位
+    std::vector<uint32_t> _next; // 后一个槽位
+    SlotList _list; // 访问顺序
+};
+
+/************************************************************************
+> CLOCK 策略
+> 槽位排成一个环，指针 _hand 顺时针扫描：访问位为 1 的清零后跳过，访问位为 0 的被淘汰
+ ************************************************************************/
+
+class ClockPolicy {
+public:
+    void init(size_t capacity) {
+        _referenced.assign(capacity, 0);
+        _used.assign(capacity, 0);
+        _hand = 0;
+    }
+    void record(uint32_t) {}
+    void on_insert(uint32_t slot, uint32_t) {
+        _used[slot] = 1;
+        _referenced[slot] = 0; // 新条目需要再被访问一次才能躲过下一轮扫描
+    }
+    void on_hit(uint32_t slot) {
+        _referenced[slot] = 1;
+    }
+    void on_erase(uint32_t slot) {
+        _used[slot] = 0;
+    }
+    uint32_t victim(uint32_t) {
+        size_t n = _used.size();
+        while (true) { // 最多转两圈：第一圈清掉所有访问位，第二圈必然找到
+            uint32_t slot = (uint32_t)_hand;
+            _hand = (_hand + 1) % n;
+            if (!_used[slot]) {
+                continue;
+            }
+            if (_referenced[slot]) {
+                _referenced[slot] = 0;
+                continue;
+            }
+            return slot;
+        }
+    }
+    template <typename F>
+    void for_each(F f) const {
+        size_t n = _used.size();
+        for (size_t i = 0; i < n; i++) {
+            size_t slot = (_hand + i) % n;
+            if (_used[slot]) {
+                f((uint32_t)slot);
+            }
+        }
+    }
+
+private:
+    std::vector<uint8_t> _referenced; // 访问位
+    std::vector<uint8_t> _used; // 槽位是否有条目
+    size_t _hand; // 时钟指针
+};
+
+/************************************************************************
+> Count-Min Sketch，4 行、每个计数器 4 位（上限 15）
+> 每记录 10 × 容量 次后所有计数器减半（老化），使频率反映近期的访问
+ ************************************************************************/
+
+class CountMinSketch {
+public:
+    void init(size_t capacity) {
+        size_t width = 16;
+        while (width < capacity) {
+            width *= 2;
+        }
+        _mask = width - 1;
+        _table.assign(width * 4 / 16, 0); // 每个 uint64_t 存 16 个 4 位计数器
+        _samples = 0;
+        _sample_limit = (capacity > 0 ? capacity : 1) * 10;
+    }
+
+    void increment(uint32_t hash) {
+        bool added = false;
+        for (int row = 0; row < 4; row++) {
+            size_t index = counter_index(hash, row);
+            uint64_t& word = _table[index >> 4];
+            int shift = (index & 15) * 4;
+            if (((word >> shift) & 0xF) < 15) {
+                word += (uint64_t)1 << shift;
+                added = true;
+            }
+        }
+        if (added && ++_samples >= _sample_limit) {
+            reset();
+        }
+    }
+
+    int frequency(uint32_t hash) const {
+        int freq = 15;
+        for (int row = 0; row < 4; row++) {
+            size_t index = counter_index(hash, row);
+            int count = (int)((_table[index >> 4] >> ((index & 15) * 4)) & 0xF);
+            freq = count < freq ? count : freq;
+        }
+        return freq;
+    }
+
+private:
+    // 第 row 行计数器在 4 行拼接后的表中的下标
+    size_t counter_index(uint32_t hash, int row) const {
+        static const uint64_t seeds[4] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+        uint64_t h = (hash + seeds[row]) * seeds[(row + 1) & 3];
+        return (size_t)row * (_mask + 1) + ((h >> 32) & _mask);
+    }
+
+    void reset() { // 所有计数器减半
+        for (uint64_t& word : _table) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        _samples /= 2;
+    }
+
+    std::vector<uint64_t> _table; // 4 行计数器
+    size_t _mask; // 每行宽度 - 1
+    size_t _samples; // 自上次老化以来的记录次数
+    size_t _sample_limit; // 触发老化的记录次数
+};
+
+/************************************************************************
+> W-TinyLFU 策略
+> 窗口区（约 1%）：LRU，新条目都先进入窗口，给新出现的热点键积累频率的机会
+> 主区（约 99%）：分段 LRU，试用段（20%）+ 保护段（80%）；试用段中的条目再次被访问时晋升到保护段
+> 缓存已满时：窗口尾部的候选者与试用段尾部的淘汰者比较频率，频率高的留下，
+  因此一次扫描中只出现一次的键无法挤掉主区中的热点键
+ ************************************************************************/
+
+class WTinyLFUPolicy {
+public:
+    void init(size_t capacity) {
+        _prev.assign(capacity, CACHE_POLICY_NIL);
+        _next.assign(capacity, CACHE_POLICY_NIL);
+        _segment.assign(capacity, WINDOW);
+        _hash.assign(capacity, 0);
+        _window = SlotList();
+        _probation = SlotList();
+        _protected = SlotList();
+
+        _window_capacity = capacity / 100 > 0 ? capacity / 100 : 1;
+        size_t main_capacity = capacity > _window_capacity ? capacity - _window_capacity : 0;
+        _protected_capacity = main_capacity * 8 / 10;
+        _sketch.init(capacity);
+    }
+
+    void record(uint32_t hash) {
+        _sketch.increment(hash);
+    }
+
+    void on_insert(uint32_t slot, uint32_t hash) {
+        _hash[slot] = hash;
+        _segment[slot] = WINDOW;
+        _window.push_front(slot, _prev, _next);
+        if (_window.size > _window_capacity) { // 窗口溢出，尾部进入主区试用段
+            uint32_t candidate = _window.tail;
+            _window.unlink(candidate, _prev, _next);
+            _segment[candidate] = PROBATION;
+            _probation.push_front(candidate, _prev, _next);
+        }
+    }
+
+    void on_hit(uint32_t slot) {
+        SlotList& list = list_of(slot);
+        list.unlink(slot, _prev, _next);
+        if (_segment[slot] == PROBATION) { // 晋升到保护段
+            _segment[slot] = PROTECTED;
+            _protected.push_front(slot, _prev, _next);
+            if (_protected.size > _protected_capacity) { // 保护段溢出，尾部降回试用段
+                uint32_t demoted = _protected.tail;
+                _protected.unlink(demoted, _prev, _next);
+                _segment[demoted] = PROBATION;
+                _probation.push_front(demoted, _prev, _next);
+            }
+        } else {
+            list.push_front(slot, _prev, _next);
+        }
+    }
+
+    void on_erase(uint32_t slot) {
+        list_of(slot).unlink(slot, _prev, _next);
+    }
+
+    uint32_t victim(uint32_t) {
+        uint32_t main_victim = _probation.tail != CACHE_POLICY_NIL ? _probation.tail : _protected.tail;
+        if (_window.size < _window_capacity || _window.tail == CACHE_POLICY_NIL) { // 窗口未满，新条目进窗口，从主区淘汰
+            return main_victim != CACHE_POLICY_NIL ? main_victim : _window.tail;
+        }
+        uint32_t candidate = _window.tail;
+        if (main_victim == CACHE_POLICY_NIL) {
+            return candidate;
+        }
+        if (_sketch.frequency(_hash[candidate]) > _sketch.frequency(_hash[main_victim])) {
+            // 候选者胜出：进入试用段，为新条目腾出窗口位置，淘汰主区的条目
+            _window.unlink(candidate, _prev, _next);
+            _segment[candidate] = PROBATION;
+            _probation.push_front(candidate, _prev, _next);
+            return main_victim;
+        }
+        return candidate; // 候选者频率不高，直接淘汰
+    }
+
+    template <typename F>
+    void for_each(F f) const {
+        const SlotList* lists[3] = {&_window, &_probation, &_protected};
+        for (const SlotList* list : lists) {
+            for (uint32_t slot = list->head; slot != CACHE_POLICY_NIL; slot = _next[slot]) {
+                f(slot);
+            }
+        }
+    }
+
+private:
+    enum Segment : uint8_t { WINDOW, PROBATION, PROTECTED };
+
+    SlotList& list_of(uint32_t slot) {
+        return _segment[slot] == WINDOW ? _window : (_segment[slot] == PROBATION ? _probation : _protected);
+    }
+
+    std::vector<uint32_t> _prev; // 前一个槽位
+    std::vector<uint32_t> _next; // 后一个槽位
+    std::vector<uint8_t> _segment; // 槽位所在的区
+    std::vector<uint32_t> _hash; // 槽位中键的哈希值
+    SlotList _window; // 窗口区
+    SlotList _probation; // 主区试用段
+    SlotList _protected; // 主区保护段
+    size_t _window_capacity; // 窗口区容量
+    size_t _protected_capacity; // 保护段容量
+    CountMinSketch _sketch; // 访问频率
+};
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <thread>
+
+#define EPOCH_MAX_THREADS 256       // 同时访问同一结构的线程数上限
+#define EPOCH_COLLECT_THRESHOLD 64  // 每个线程积攒多少个待回收对象后尝试推进纪元
+
+/* ************************************************************************
+> 基于纪元（Epoch-Based Reclamation）的延迟内存回收
+> 思路：
+    > 全局纪元 _global_epoch 单调递增
+    > 线程访问共享结构前调用 pin()：记录当前全局纪元并把自己标记为活跃
+    > 被摘除的节点不会立刻释放，而是 retire() 到当前线程的待回收列表，并记下摘除时的全局纪元
+    > 只有当所有活跃线程都已经观察到当前纪元时，全局纪元才能推进
+    > 全局纪元比摘除时的纪元大 2 及以上时，不可能还有读线程持有该节点，此时才真正释放
+> 读线程只需要两次原子写（进入/离开），不会被写线程阻塞
+ ************************************************************************/
+
+/*
+ * 线程编号分配器
+ * 为每个线程分配一个 [0, EPOCH_MAX_THREADS) 内的编号，线程退出时归还，供后来的线程复用
+ */
+class EpochThreadRegistry {
+public:
+    static int current_id(); // 获取当前线程的编号
+
+private:
+    struct Holder {
+        int id;
+        Holder();
+        ~Holder();
+    };
+
+    static std::atomic<bool>* used_slots(); // 编号占用表
+};
+
+inline std::atomic<bool>* EpochThreadRegistry::used_slots() {
+    static std::atomic<bool> slots[EPOCH_MAX_THREADS] = {};
+    return slots;
+}
+
+inline EpochThreadRegistry::Holder::Holder() : id(-1) {
+    std::atomic<bool>* slots = used_slots();
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        bool expected = false;
+        if (!slots[i].load(std::memory_order_relaxed) &&
+            slots[i].compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            id = i;
+            return;
+        }
+    }
+    throw std::runtime_error("EpochThreadRegistry: too many threads");
+}
+
+inline EpochThreadRegistry::Holder::~Holder() {
+    used_slots()[id].store(false, std::memory_order_release);
+}
+
+inline int EpochThreadRegistry::current_id() {
+    thread_local Holder holder;
+    return holder.id;
+}
+
+/************************************************************************
+> 纪元回收器，每个并发结构持有一个
+> public方法：
+    > pin：进入临界区，返回的 Guard 析构时自动离开；支持同一线程嵌套调用
+    > retire：登记一个已经从结构中摘除的对象，等到安全时调用 deleter 释放
+    > collect：尝试推进全局纪元，并释放本线程中已经安全的对象
+    > synchronize：等待一个完整的宽限期，返回时调用前进入临界区的读者都已离开（调用者自己不能处于临界区中）
+    > reclaim_all：立即释放所有待回收对象，只能在没有其他线程访问结构时调用
+ ************************************************************************/
+
+class EpochReclaimer {
+public:
+    using Deleter = void (*)(void* ctx, void* ptr); // ctx 一般为所属的结构，ptr 为待释放的对象
+
+    class Guard {
+    public:
+        Guard() : _reclaimer(nullptr) {} // 空的 Guard，不处于临界区
+        explicit Guard(EpochReclaimer* reclaimer);
+        Guard(Guard&& other) noexcept;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard();
+
+    private:
+        EpochReclaimer* _reclaimer;
+    };
+
+    EpochReclaimer();
+    ~EpochReclaimer();
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    Guard pin(); // 进入临界区
+    void retire(void* ptr, Deleter deleter, void* ctx); // 延迟释放
+    void collect(); // 推进纪元并回收
+    void synchronize(); // 等待宽限期结束
+    void reclaim_all(); // 立即释放全部待回收对象
+
+private:
+    struct Retired {
+        void* ptr;
+        Deleter deleter;
+        void* ctx;
+        uint64_t epoch; // 摘除时的全局纪元
+    };
+
+    // 每个线程一个槽位，按缓存行对齐避免伪共享
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> state{0}; // (纪元 << 1) | 是否活跃
+        int nesting = 0;                // 嵌套 pin 的层数，只由所属线程访问
+        std::vector<Retired> limbo;     // 待回收对象，只由所属线程访问
+    };
+
+    void enter();
+    void leave();
+    bool try_advance(); // 所有活跃线程都观察到当前纪元时，推进全局纪元
+    void collect_slot(Slot& slot);
+
+    std::atomic<uint64_t> _global_epoch; // 全局纪元
+    std::atomic<int> _slot_limit;        // 用到的最大线程编号 + 1，缩小扫描范围
+    Slot _slots[EPOCH_MAX_THREADS];
+};
+
+inline EpochReclaimer::Guard::Guard(EpochReclaimer* reclaimer) : _reclaimer(reclaimer) {
+    _reclaimer->enter();
+}
+
+inline EpochReclaimer::Guard::Guard(Guard&& other) noexcept : _reclaimer(other._reclaimer) {
+    other._reclaimer = nullptr;
+}
+
+inline EpochReclaimer::Guard::~Guard() {
+    if (_reclaimer != nullptr) {
+        _reclaimer->leave();
+    }
+}
+
+inline EpochReclaimer::EpochReclaimer() : _global_epoch(2), _slot_limit(0) {}
+
+inline EpochReclaimer::~EpochReclaimer() {
+    reclaim_all();
+}
+
+inline EpochReclaimer::Guard EpochReclaimer::pin() {
+    return Guard(this);
+}
+
+inline void EpochReclaimer::enter() {
+    int id = EpochThreadRegistry::current_id();
+    Slot& slot = _slots[id];
+
+    if (slot.nesting++ > 0) { // 已经在临界区中
+        return;
+    }
+
+    // 让推进纪元的线程能看到这个槽位
+    int limit = _slot_limit.load(std::memory_order_relaxed);
+    while (limit < id + 1 && !_slot_limit.compare_exchange_weak(limit, id + 1, std::memory_order_relaxed)) {
+    }
+
+    uint64_t epoch = _global_epoch.load(std::memory_order_relaxed);
+    slot.state.store((epoch << 1) | 1, std::memory_order_relaxed);
+    // 活跃标记必须先于之后对结构的读取对其他线程可见
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void EpochReclaimer::leave() {
+    Slot& slot = _slots[EpochThreadRegistry::current_id()];
+    if (--slot.nesting > 0) {
+        return;
+    }
+    slot.state.store(0, std::memory_order_release);
+}
+
+inline void EpochReclaimer::retire(void* ptr, Deleter deleter, void* ctx) {
+    Slot& slot = _slots[EpochThreadRegistry::current_id()];
+    uint64_t epoch = _global_epoch.load(std::memory_order_acquire);
+    slot.limbo.push_back(Retired{ptr, deleter, ctx, epoch});
+
+    if (slot.limbo.size() >= EPOCH_COLLECT_THRESHOLD) {
+        collect_slot(slot);
+    }
+}
+
+inline void EpochReclaimer::collect() {
+    collect_slot(_slots[EpochThreadRegistry::current_id()]);
+}
+
+inline void EpochReclaimer::synchronize() {
+    // 纪元前进两次后，调用前就已进入临界区的读者必然都已离开
+    uint64_t target = _global_epoch.load(std::memory_order_acquire) + 2;
+    while (_global_epoch.load(std::memory_order_acquire) < target) {
+        if (!try_advance()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline bool EpochReclaimer::try_advance() {
+    uint64_t epoch = _global_epoch.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int limit = _slot_limit.load(std::memory_order_relaxed);
+    for (int i = 0; i < limit; i++) {
+        uint64_t state = _slots[i].state.load(std::memory_order_acquire);
+        if ((state & 1) && (state >> 1) != epoch) { // 仍有线程停留在旧纪元
+            return false;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return _global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_release, std::memory_order_relaxed);
+}
+
+inline void EpochReclaimer::collect_slot(Slot& slot) {
+    try_advance();
+    uint64_t epoch = _global_epoch.load(std::memory_order_acquire);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < slot.limbo.size(); i++) {
+        Retired& r = slot.limbo[i];
+        if (r.epoch + 2 <= epoch) {
+            r.deleter(r.ctx, r.ptr);
+        } else {
+            slot.limbo[kept++] = r;
+        }
+    }
+    slot.limbo.resize(kept);
+}
+
+inline void EpochReclaimer::reclaim_all() {
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        for (Retired& r : _slots[i].limbo) {
+            r.deleter(r.ctx, r.ptr);
+        }
+        _slots[i].limbo.clear();
+    }
+}
+
+#endif
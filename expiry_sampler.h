@@ -0,0 +1,95 @@
+#ifndef EXPIRY_SAMPLER_H
+#define EXPIRY_SAMPLER_H
+
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#define EXPIRY_SAMPLE_COUNT 20 // 每轮抽样的键数
+#define EXPIRY_ACCEPTABLE_STALE 10 // 抽样中过期的比例（%）不超过它时结束本次清理
+#define EXPIRY_CYCLE_BUDGET_US 1000 // 每次清理的默认时间预算（微秒）
+
+/* ************************************************************************
+> 带过期时间的键的集合，支持 O(1) 的添加、删除和均匀随机抽样，用于 Redis 式的主动过期
+> 思路（与 Redis 的 activeExpireCycle 相同）：
+    > 每轮随机抽取 EXPIRY_SAMPLE_COUNT 个带过期时间的键，删除其中已经过期的
+    > 抽样中过期的比例超过 EXPIRY_ACCEPTABLE_STALE% 时，说明过期的键还很多，继续下一轮
+    > 整个过程有时间预算，超出预算立即停止，剩下的过期键留给下一次清理或访问时的惰性删除
+> 存储：数组 _entries 存放键和过期时间，_positions 记录键在数组中的下标；删除时用最后一个元素填补空位
+> 本身不是线程安全的，由使用者加锁
+ ************************************************************************/
+
+template <typename K>
+class ExpirySampleSet {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Entry {
+        K key;
+        TimePoint expire_time; // 过期时间
+    };
+
+    void add(const K& key, TimePoint expire_time); // 添加键，已存在时更新过期时间
+    void remove(const K& key); // 删除键，不存在时什么也不做
+    const Entry& sample(uint64_t& seed) const; // 均匀随机取一个键，集合不能为空
+    size_t size() const; // 键数
+    void clear(); // 清空
+
+private:
+    std::vector<Entry> _entries; // 键和过期时间
+    std::unordered_map<K, size_t> _positions; // 键在 _entries 中的下标
+};
+
+template <typename K>
+void ExpirySampleSet<K>::add(const K& key, TimePoint expire_time) {
+    auto it = _positions.find(key);
+    if (it != _positions.end()) {
+        _entries[it->second].expire_time = expire_time;
+        return;
+    }
+    _positions.emplace(key, _entries.size());
+    _entries.push_back(Entry{key, expire_time});
+}
+
+template <typename K>
+void ExpirySampleSet<K>::remove(const K& key) {
+    auto it = _positions.find(key);
+    if (it == _positions.end()) {
+        return;
+    }
+    size_t pos = it->second;
+    _positions.erase(it);
+    if (pos + 1 != _entries.size()) { // 用最后一个元素填补空位
+        _entries[pos] = std::move(_entries.back());
+        _positions[_entries[pos].key] = pos;
+    }
+    _entries.pop_back();
+}
+
+/**
+ * 均匀随机取一个键
+ * @param seed xorshift 随机数状态，调用者各自持有，不同线程互不干扰
+ * @return const Entry& 键和过期时间
+ */
+template <typename K>
+const typename ExpirySampleSet<K>::Entry& ExpirySampleSet<K>::sample(uint64_t& seed) const {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return _entries[seed % _entries.size()];
+}
+
+template <typename K>
+size_t ExpirySampleSet<K>::size() const {
+    return _entries.size();
+}
+
+template <typename K>
+void ExpirySampleSet<K>::clear() {
+    _entries.clear();
+    _positions.clear();
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef KEY_PREFIX_H
+#define KEY_PREFIX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/* ************************************************************************
+> 节点内嵌的键前缀
+> 字符串键的内容通常在堆上（超过短字符串优化的长度时），查找路径上每比较一个节点都要多读一次不在缓存中的内存。
+  节点在自身中保存键的前 8 个字节，按大端序打包成一个 uint64_t：
+    > 字符串按无符号字节逐个比较，大端序打包后整数的大小关系与前 8 个字节的字典序一致，不足 8 字节的补 0
+    > 前缀不同时，前缀的大小关系就是键的大小关系，不访问字符串的内容
+    > 前缀相同（前 8 个字节相同，或较短的键补 0 后相同）时，才比较完整的键
+> KeyPrefix<K>：键类型的前缀规则，默认关闭；std::string 和 SnapshotString（mapped_snapshot.h）已开启，
+  其它按字节序比较的字符串类型可以特化它
+> NodeKeyPrefix<K>：节点的基类，开启时保存前缀，关闭时是空基类，不占节点的空间
+ ************************************************************************/
+
+template <typename K>
+struct KeyPrefix {
+    static const bool enabled = false; // 是否在节点中保存前缀
+    static uint64_t of(const K&) { return 0; }
+};
+
+/**
+ * 打包前缀
+ * @param data 键的内容
+ * @param size 键的长度
+ * @return uint64_t 前 8 个字节按大端序组成的整数，不足 8 字节的低位补 0
+ */
+inline uint64_t pack_key_prefix(const char* data, size_t size) {
+    uint64_t prefix = 0;
+    std::memcpy(&prefix, data, size < 8 ? size : 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    prefix = __builtin_bswap64(prefix);
+#endif
+    return prefix;
+}
+
+template <>
+struct KeyPrefix<std::string> {
+    static const bool enabled = true;
+    static uint64_t of(const std::string& key) { return pack_key_prefix(key.data(), key.size()); }
+};
+
+/**
+ * 节点的前缀基类（关闭时）
+ * @description 空基类，比较直接使用键的 operator< 和 operator==
+ */
+template <typename K, bool Enabled = KeyPrefix<K>::enabled>
+class NodeKeyPrefix {
+public:
+    NodeKeyPrefix() {}
+    explicit NodeKeyPrefix(const K&) {}
+
+    static bool key_less(const K& mine, const K& key, uint64_t) { return mine < key; }
+    static bool key_equals(const K& mine, const K& key, uint64_t) { return mine == key; }
+};
+
+/**
+ * 节点的前缀基类（开启时）
+ * @description 构造时计算一次前缀；比较时先比较前缀，相同时才比较完整的键
+ */
+template <typename K>
+class NodeKeyPrefix<K, true> {
+public:
+    NodeKeyPrefix() : _key_prefix(0) {}
+    explicit NodeKeyPrefix(const K& key) : _key_prefix(KeyPrefix<K>::of(key)) {}
+
+    bool key_less(const K& mine, const K& key, uint64_t prefix) const {
+        if (_key_prefix != prefix) {
+            return _key_prefix < prefix;
+        }
+        return mine < key;
+    }
+    bool key_equals(const K& mine, const K& key, uint64_t prefix) const {
+        return _key_prefix == prefix && mine == key;
+    }
+
+private:
+    uint64_t _key_prefix; // 键的前 8 个字节，大端序
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef LEVEL_GENERATOR_H
+#define LEVEL_GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+#define AUTO_MAX_LEVEL 0 // 构造跳表时传入，表示最大层数由元素个数决定
+#define LEVEL_GENERATOR_MAX_LEVEL 32 // 自动确定最大层数时头节点的层数上限
+
+// 节点晋升到上一层的概率 p
+enum class LevelProbability {
+    HALF, // p = 1/2：每个节点平均 2 个指针，查找时每层平均前进 1 步
+    QUARTER, // p = 1/4：每个节点平均 1.33 个指针，层数减半，每层平均前进 3 步
+    INV_E // p = 1/e：查找代价 (1/p) * log_{1/p}(n) 取最小值的理论最优点，每个节点平均 1.58 个指针
+};
+
+/* ************************************************************************
+> 跳表的随机层数生成器
+> 随机数：线程本地的 xorshift64*，每个线程一份状态，不加锁
+  （libc 的 rand() 内部有一把全局锁，多线程插入时是隐藏的串行点）
+> 层数：第 i 层出现的概率为 p^i，不用逐位循环：
+    > p = 1/2：层数 = 随机数末尾 0 的个数（ctz），每一位为 0 的概率是 1/2
+    > p = 1/4：层数 = ctz / 2，连续两位为 0 的概率是 1/4
+    > p = 1/e：层数 = floor(-ln u)，u 为 (0, 1] 上的均匀分布，P(层数 >= i) = P(u <= e^-i) = e^-i
+> 最大层数：有 n 个元素时，高于 ceil(log_{1/p} n) 的层期望不到一个节点，
+  level_cap(n) 按当前元素个数限制新节点的层数，小表不会出现很高的节点
+ ************************************************************************/
+
+class LevelGenerator {
+public:
+    explicit LevelGenerator(LevelProbability p = LevelProbability::HALF);
+
+    int next(int max_level) const; // 随机层数，范围 [0, max_level]
+    int sequence_level(uint64_t seq) const; // 批量构建时第 seq 个节点（从 1 开始）的层数，按 p 均匀分布
+    int level_cap(size_t n) const; // 有 n 个元素时新节点的最高层数 ceil(log_{1/p} n)，至少为 1
+    LevelProbability probability() const; // 晋升概率
+    static uint64_t random(); // 线程本地的 64 位随机数
+
+private:
+    LevelProbability _p; // 晋升概率
+};
+
+inline LevelGenerator::LevelGenerator(LevelProbability p) : _p(p) {}
+
+inline LevelProbability LevelGenerator::probability() const {
+    return _p;
+}
+
+/**
+ * 线程本地的 xorshift64* 随机数
+ * @return uint64_t 随机数
+ * @note 种子取线程编号的哈希与当前时间，保证非零；不同线程的序列互不相关
+ */
+inline uint64_t LevelGenerator::random() {
+    thread_local uint64_t state = (std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+                                   (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count()) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * 随机层数
+ * @param max_level 最大层数
+ * @return int 范围 [0, max_level]，第 i 层出现的概率为 p^i
+ */
+inline int LevelGenerator::next(int max_level) const {
+    uint64_t r = random();
+    int level;
+    switch (_p) {
+    case LevelProbability::QUARTER:
+        level = __builtin_ctzll(r | (1ULL << 63)) >> 1; // 最高位置 1，保证 ctz 有定义
+        break;
+    case LevelProbability::INV_E:
+        level = (int)-std::log((double)((r >> 11) + 1) * (1.0 / 9007199254740992.0)); // 取 53 位构造 (0, 1] 上的 u
+        break;
+    default:
+        level = __builtin_ctzll(r | (1ULL << 63));
+        break;
+    }
+    return level < max_level ? level : max_level;
+}
+
+/**
+ * 批量构建时第 seq 个节点的层数
+ * @param seq 节点序号，从 1 开始
+ * @return int p = 1/2 时为 ctz(seq)，即每 2^i 个节点出现一个第 i 层节点；p = 1/4 时为 ctz(seq) / 2；
+ *             p = 1/e 不是 2 的幂次，退回随机层数
+ */
+inline int LevelGenerator::sequence_level(uint64_t seq) const {
+    switch (_p) {
+    case LevelProbability::QUARTER:
+        return __builtin_ctzll(seq) >> 1;
+    case LevelProbability::INV_E:
+        return next(LEVEL_GENERATOR_MAX_LEVEL);
+    default:
+        return __builtin_ctzll(seq);
+    }
+}
+
+/**
+ * 有 n 个元素时新节点的最高层数
+ * @param n 元素个数
+ * @return int ceil(log_{1/p} n)，至少为 1；只用整数运算，每次插入都可以调用
+ */
+inline int LevelGenerator::level_cap(size_t n) const {
+    int bits = n > 1 ? 64 - __builtin_clzll((uint64_t)(n - 1)) : 0; // ceil(log2 n)
+    int cap;
+    switch (_p) {
+    case LevelProbability::QUARTER:
+        cap = (bits + 1) / 2;
+        break;
+    case LevelProbability::INV_E:
+        cap = (bits * 693 + 999) / 1000; // ln n = log2 n * ln 2
+        break;
+    default:
+        cap = bits;
+        break;
+    }
+    return cap > 1 ? cap : 1;
+}
+
+#endif
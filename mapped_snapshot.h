@@ -0,0 +1,375 @@
+#ifndef MAPPED_SNAPSHOT_H
+#define MAPPED_SNAPSHOT_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "snapshot.h"
+#include "key_prefix.h"
+
+/* ************************************************************************
+> 通过 mmap 加载二进制快照（格式见 snapshot.h）
+> 思路：
+    > 整个快照文件只读映射进地址空间，不经过 ifstream，也不为每个键值申请 std::string
+    > 键和值使用 SnapshotString：解码时只记录指向映射区的指针和长度（零拷贝）
+    > 只有在修改 SnapshotString 时才把内容复制到自己申请的内存中（写时复制）
+    > 映射由 std::shared_ptr<MappedFile> 管理，持有视图的结构必须同时持有映射
+    > 键值通过 scan、游标、multi_get 离开跳表时复制为拥有状态（snapshot_detach），不依赖映射
+> 快照写入时总是先写临时文件再 rename，新的快照不会改写已映射的旧文件
+ ************************************************************************/
+
+/*
+ * 只读的文件映射，析构时自动解除映射
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path); // 映射整个文件
+    const char* data() const; // 映射区起始地址
+    size_t size() const; // 文件大小
+
+private:
+    void* _addr; // 映射区起始地址
+    size_t _size; // 映射区大小
+};
+
+inline MappedFile::MappedFile() : _addr(nullptr), _size(0) {}
+
+inline MappedFile::~MappedFile() {
+    if (_addr != nullptr) {
+        munmap(_addr, _size);
+    }
+}
+
+/**
+ * 映射整个文件
+ * @param path 文件路径
+ * @return bool 是否成功
+ */
+inline bool MappedFile::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        std::cerr << "Failed to stat file: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // 映射建立后文件描述符就可以关闭了
+    if (addr == MAP_FAILED) {
+        std::cerr << "Failed to mmap file: " << path << std::endl;
+        return false;
+    }
+    madvise(addr, st.st_size, MADV_SEQUENTIAL); // 加载时顺序扫描一遍
+
+    _addr = addr;
+    _size = st.st_size;
+    return true;
+}
+
+inline const char* MappedFile::data() const {
+    return static_cast<const char*>(_addr);
+}
+
+inline size_t MappedFile::size() const {
+    return _size;
+}
+
+/************************************************************************
+> 写时复制的字符串
+> 两种状态：
+    > 视图：_data 指向外部内存（通常是映射区），不负责释放
+    > 拥有：_data 指向自己申请的内存
+> 复制视图只复制指针；修改（assign / append / mutable_data）时才转为拥有状态
+ ************************************************************************/
+
+class SnapshotString {
+public:
+    SnapshotString();
+    SnapshotString(const char* s);
+    SnapshotString(const std::string& s);
+    SnapshotString(const SnapshotString& other);
+    SnapshotString(SnapshotString&& other) noexcept;
+    SnapshotString& operator=(const SnapshotString& other);
+    SnapshotString& operator=(SnapshotString&& other) noexcept;
+    ~SnapshotString();
+
+    static SnapshotString view_of(const char* data, size_t size); // 构造一个不拥有内存的视图
+
+    const char* data() const; // 内容
+    size_t size() const; // 长度
+    bool empty() const; // 是否为空
+    bool is_view() const; // 是否仍指向外部内存
+    std::string_view view() const; // 以 string_view 访问
+    std::string str() const; // 复制为 std::string
+
+    void assign(const char* data, size_t size); // 替换内容
+    void append(const char* data, size_t size); // 追加内容
+    char* mutable_data(); // 获取可写指针，视图会先复制一份
+    void detach(); // 视图复制为拥有状态，不再引用外部内存
+
+private:
+    void own(const char* data, size_t size, size_t capacity); // 复制到自己申请的内存
+    void release(); // 释放自己申请的内存
+
+    const char* _data; // 内容
+    size_t _size; // 长度
+    bool _owned; // 是否拥有 _data
+};
+
+inline SnapshotString::SnapshotString() : _data(""), _size(0), _owned(false) {}
+
+inline SnapshotString::SnapshotString(const char* s) : _data(""), _size(0), _owned(false) {
+    own(s, strlen(s), strlen(s));
+}
+
+inline SnapshotString::SnapshotString(const std::string& s) : _data(""), _size(0), _owned(false) {
+    own(s.data(), s.size(), s.size());
+}
+
+inline SnapshotString::SnapshotString(const SnapshotString& other) : _data(other._data), _size(other._size), _owned(false) {
+    if (other._owned) {
+        own(other._data, other._size, other._size);
+    }
+}
+
+inline SnapshotString::SnapshotString(SnapshotString&& other) noexcept
+    : _data(other._data), _size(other._size), _owned(other._owned) {
+    other._data = "";
+    other._size = 0;
+    other._owned = false;
+}
+
+inline SnapshotString& SnapshotString::operator=(const SnapshotString& other) {
+    if (this != &other) {
+        SnapshotString copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+inline SnapshotString& SnapshotString::operator=(SnapshotString&& other) noexcept {
+    if (this != &other) {
+        release();
+        _data = other._data;
+        _size = other._size;
+        _owned = other._owned;
+        other._data = "";
+        other._size = 0;
+        other._owned = false;
+    }
+    return *this;
+}
+
+inline SnapshotString::~SnapshotString() {
+    release();
+}
+
+inline SnapshotString SnapshotString::view_of(const char* data, size_t size) {
+    SnapshotString s;
+    s._data = data;
+    s._size = size;
+    return s;
+}
+
+inline void SnapshotString::own(const char* data, size_t size, size_t capacity) {
+    char* buf = new char[capacity + 1];
+    memcpy(buf, data, size);
+    buf[size] = '\0';
+    release();
+    _data = buf;
+    _size = size;
+    _owned = true;
+}
+
+inline void SnapshotString::release() {
+    if (_owned) {
+        delete[] _data;
+    }
+    _data = "";
+    _size = 0;
+    _owned = false;
+}
+
+inline const char* SnapshotString::data() const {
+    return _data;
+}
+
+inline size_t SnapshotString::size() const {
+    return _size;
+}
+
+inline bool SnapshotString::empty() const {
+    return _size == 0;
+}
+
+inline bool SnapshotString::is_view() const {
+    return !_owned && _size > 0;
+}
+
+inline std::string_view SnapshotString::view() const {
+    return std::string_view(_data, _size);
+}
+
+inline std::string SnapshotString::str() const {
+    return std::string(_data, _size);
+}
+
+inline void SnapshotString::assign(const char* data, size_t size) {
+    own(data, size, size);
+}
+
+inline void SnapshotString::append(const char* data, size_t size) {
+    size_t old_size = _size;
+    char* buf = new char[old_size + size + 1];
+    memcpy(buf, _data, old_size);
+    memcpy(buf + old_size, data, size);
+    buf[old_size + size] = '\0';
+    release();
+    _data = buf;
+    _size = old_size + size;
+    _owned = true;
+}
+
+inline char* SnapshotString::mutable_data() {
+    if (!_owned) {
+        own(_data, _size, _size);
+    }
+    return const_cast<char*>(_data);
+}
+
+inline void SnapshotString::detach() {
+    if (is_view()) {
+        own(_data, _size, _size);
+    }
+}
+
+inline bool operator<(const SnapshotString& a, const SnapshotString& b) {
+    return a.view() < b.view();
+}
+
+inline bool operator==(const SnapshotString& a, const SnapshotString& b) {
+    return a.view() == b.view();
+}
+
+inline bool operator!=(const SnapshotString& a, const SnapshotString& b) {
+    return !(a == b);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SnapshotString& s) {
+    return os << s.view();
+}
+
+// 按字节序比较，节点中保存前 8 个字节，查找时前缀不同就不再访问映射区
+template <>
+struct KeyPrefix<SnapshotString> {
+    static const bool enabled = true;
+    static uint64_t of(const SnapshotString& key) { return pack_key_prefix(key.data(), key.size()); }
+};
+
+// 键值离开跳表（scan、游标、multi_get）时调用：视图复制为拥有状态，不随跳表 clear() 或析构解除的映射失效
+template <typename T>
+inline void snapshot_detach(T&) {}
+
+inline void snapshot_detach(SnapshotString& s) {
+    s.detach();
+}
+
+// 通用的解码复制出内容：SnapshotReader、预写日志重放的缓冲区解码之后就会被复用或释放
+template <>
+struct SnapshotCodec<SnapshotString> {
+    static void encode(const SnapshotString& v, std::string& out) {
+        out.append(v.data(), v.size());
+    }
+    static bool decode(const char* data, size_t len, SnapshotString& v) {
+        v.assign(data, len);
+        return true;
+    }
+};
+
+// 在映射区上解码时直接引用映射区，不复制
+template <>
+struct SnapshotViewCodec<SnapshotString> {
+    static bool decode(const char* data, size_t len, SnapshotString& v) {
+        v = SnapshotString::view_of(data, len);
+        return true;
+    }
+};
+
+/**
+ * 遍历映射区中的快照
+ * @param file 已映射的快照文件
+ * @param consume 每条记录的回调 consume(SnapshotRecord<K, V>&)
+ * @param corrupted 输出，是否发现损坏
+ * @return uint64_t 交给 consume 的记录数
+ * @description 逐块校验 CRC 后直接在映射区上解码，K、V 为 SnapshotString 时记录中只保存指针
+ */
+template <typename K, typename V, typename Consume>
+uint64_t snapshot_for_each_mapped(const MappedFile& file, Consume consume, bool& corrupted) {
+    corrupted = true;
+    const char* p = file.data();
+    const char* end = p + file.size();
+
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "Not a snapshot file" << std::endl;
+        return 0;
+    }
+    memcpy(&header, p, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, 8) != 0 || header.version != SNAPSHOT_VERSION ||
+        header.header_crc != snapshot_crc32(&header, offsetof(SnapshotHeader, header_crc))) {
+        std::cerr << "Snapshot header corrupted" << std::endl;
+        return 0;
+    }
+    p += sizeof(header);
+
+    uint64_t consumed = 0;
+    SnapshotRecord<K, V> record;
+    while (true) {
+        uint32_t meta[3];
+        if ((size_t)(end - p) < sizeof(meta)) {
+            std::cerr << "Snapshot truncated" << std::endl;
+            return consumed;
+        }
+        memcpy(meta, p, sizeof(meta));
+        p += sizeof(meta);
+        if (meta[0] == 0 && meta[1] == 0) { // 结束块
+            break;
+        }
+        if ((size_t)(end - p) < meta[0] || snapshot_crc32(p, meta[0]) != meta[2]) {
+            std::cerr << "Snapshot block corrupted" << std::endl;
+            return consumed;
+        }
+
+        const char* block_end = p + meta[0];
+        for (uint32_t i = 0; i < meta[1]; i++) {
+            if (!SnapshotReader::decode_record<K, V, true>(p, block_end, header.flags, record.key, record.value, record.ttl)) {
+                std::cerr << "Snapshot record corrupted" << std::endl;
+                return consumed;
+            }
+            consume(record);
+            consumed++;
+        }
+        p = block_end;
+    }
+    corrupted = false;
+    return consumed;
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#define ARENA_CHUNK_SIZE (1 << 20) // 每次向系统申请 1MB
+
+/* ************************************************************************
+> 跳表节点的内存池（Arena / Slab）
+> 思路：
+    > 节点和它的 forward 指针数组放在同一块连续内存里：[ 节点对象 | forward[0..level] ]
+    > 从大块内存（chunk）中顺序切分，省去每次插入两次 malloc 的开销，节点在内存中也更紧凑
+    > 释放的节点不归还系统，而是挂到对应层数的空闲链表上，下次分配同样层数的节点时直接复用
+    > 析构时整块释放所有 chunk，不需要逐个 free
+> 说明：
+    > NodeArena 本身不加锁，调用者需要保证分配与释放是串行的（跳表中都在写锁内进行）
+    > NodeArena 只管理内存，不负责调用节点的构造函数和析构函数
+ ************************************************************************/
+
+template <typename NodeT, typename LinkT>
+class NodeArena {
+public:
+    NodeArena();
+    ~NodeArena();
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    static size_t block_size(int level); // 层数为 level 的节点占用的字节数
+    static LinkT* links_of(void* block); // 节点内存块中 forward 数组的起始地址
+
+    void* allocate(int level); // 分配一个层数为 level 的节点内存块
+    void deallocate(void* block, int level); // 归还节点内存块到空闲链表
+    void release_all(); // 释放全部 chunk，之前分配的内存块全部失效
+    size_t bytes_reserved() const; // 向系统申请的总字节数
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::vector<char*> _chunks; // 已申请的大块内存
+    char* _cursor; // 当前 chunk 中下一个可用位置
+    char* _end; // 当前 chunk 的末尾
+    std::vector<FreeBlock*> _free_lists; // 按层数划分的空闲链表
+    size_t _bytes_reserved; // 向系统申请的总字节数
+};
+
+template <typename NodeT, typename LinkT>
+NodeArena<NodeT, LinkT>::NodeArena() : _cursor(nullptr), _end(nullptr), _bytes_reserved(0) {}
+
+template <typename NodeT, typename LinkT>
+NodeArena<NodeT, LinkT>::~NodeArena() {
+    release_all();
+}
+
+/**
+ * 计算节点内存块大小
+ * @param level 节点层数
+ * @return size_t 节点对象 + (level + 1) 个指针，按 max_align_t 对齐
+ */
+template <typename NodeT, typename LinkT>
+size_t NodeArena<NodeT, LinkT>::block_size(int level) {
+    const size_t align = alignof(std::max_align_t);
+    size_t size = sizeof(NodeT) + sizeof(LinkT) * (level + 1);
+    return (size + align - 1) / align * align;
+}
+
+template <typename NodeT, typename LinkT>
+LinkT* NodeArena<NodeT, LinkT>::links_of(void* block) {
+    return reinterpret_cast<LinkT*>(static_cast<char*>(block) + sizeof(NodeT));
+}
+
+/**
+ * 分配节点内存块
+ * @param level 节点层数
+ * @return void* 优先从空闲链表中复用，否则从当前 chunk 中切分
+ */
+template <typename NodeT, typename LinkT>
+void* NodeArena<NodeT, LinkT>::allocate(int level) {
+    if (level < (int)_free_lists.size() && _free_lists[level] != nullptr) {
+        FreeBlock* block = _free_lists[level];
+        _free_lists[level] = block->next;
+        return block;
+    }
+
+    size_t size = block_size(level);
+    if (_cursor == nullptr || (size_t)(_end - _cursor) < size) {
+        size_t chunk_size = size > ARENA_CHUNK_SIZE ? size : ARENA_CHUNK_SIZE;
+        char* chunk = static_cast<char*>(std::malloc(chunk_size));
+        if (chunk == nullptr) {
+            throw std::bad_alloc();
+        }
+        _chunks.push_back(chunk);
+        _bytes_reserved += chunk_size;
+        _cursor = chunk;
+        _end = chunk + chunk_size;
+    }
+
+    void* block = _cursor;
+    _cursor += size;
+    return block;
+}
+
+/**
+ * 归还节点内存块
+ * @param block 节点内存块，调用前节点对象应已析构
+ * @param level 节点层数
+ */
+template <typename NodeT, typename LinkT>
+void NodeArena<NodeT, LinkT>::deallocate(void* block, int level) {
+    if (level >= (int)_free_lists.size()) {
+        _free_lists.resize(level + 1, nullptr);
+    }
+    FreeBlock* free_block = static_cast<FreeBlock*>(block);
+    free_block->next = _free_lists[level];
+    _free_lists[level] = free_block;
+}
+
+template <typename NodeT, typename LinkT>
+void NodeArena<NodeT, LinkT>::release_all() {
+    for (char* chunk : _chunks) {
+        std::free(chunk);
+    }
+    _chunks.clear();
+    _free_lists.clear();
+    _cursor = nullptr;
+    _end = nullptr;
+    _bytes_reserved = 0;
+}
+
+template <typename NodeT, typename LinkT>
+size_t NodeArena<NodeT, LinkT>::bytes_reserved() const {
+    return _bytes_reserved;
+}
+
+#endif
@@ -1,578 +1,1418 @@
-#include <iostream>
-#include <cstring>
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
-#include <cmath>
-#include <mutex>
-
-# define STORE_FILE "store/dumpFile" // 存储文件
-
-std::mutex mtx; // 互斥锁
-std::mutex file_mtx; // 文件互斥锁
-std::string delimiter = ":"; // 分隔符
-
-/* ************************************************************************
-> 跳表的节点类的实现
-> 成员属性：
-    > key：节点的键值
-    > value：节点的值
-    > forward：指针数组，用于指向后继节点
-    > node_level：节点的层数
-> public方法：
-    > 构造函数：初始化节点
-    > 析构函数：销毁节点
-    > getKey：获取节点的键值
-    > getValue：获取节点的值
-    > setValue：设置节点的值
- ************************************************************************/
-
-template <typename K, typename V>
-class Node { 
-
-public: 
-
-    Node() {} // 默认构造函数
-
-    Node(K k, V v, int); // 构造函数
-
-    ~Node(); // 析构函数
-
-    K getKey() const;  // get key
-
-    V getValue() const; // get value
-
-    void setValue(V);
-
-    Node<K, V> **forward; // 在C++中，二维指针等价于指针数组
-
-    int node_level; // 节点的层数
-
-private:
-    K key;
-    V value;
-};
-
-/* ************************************************************************
-> 关键点1. 同一节点的多层跳转：在相同键值、不同层级节点之间的跳转
-> 关键点2. 不同节点的单层跳转：在相同层级、不同键值节点之间的跳转
-> 通过这两种跳转方式，可以实现跳表的查找、插入、删除等操作
-
-> 关键点1的解决方法：Node<K, V> **forward
-> 描述：使用一个指针数组forward，数组中的每个指针对应节点在一个特定层级的后继节点
-        通过变更数组下标，可以实现同一节点的多层跳转。
-> 关键点2的解决方法：*forward
-> 描述：参考单链表中的指针域，通过指针域实现节点之间的连接
-
-> 例子：假设一个节点的层数为3，那么这个节点的forward指针数组的大小为3。其中forward[0]
-        指向该节点在第0层的后继节点，forward[1]指向该节点在第1层的后继节点，forward[2]
- ************************************************************************/
-
-template <typename K, typename V>
-Node<K, V>::Node(const K k, const V v, int level) {
-    this->key = k;
-    this->value = v;
-    this->node_level = level;
-
-    // 申请指针数组的空间
-    this->forward = new Node<K, V>*[level + 1]; // 申请指针数组的空间
-    
-    // Fill forward array with 0(NULL)
-    memset(forward, 0, sizeof(Node<K, V>*) * (level + 1)); // 初始化指针数组
-}
-
-template <typename K, typename V>
-Node<K, V>::~Node() {
-    delete [] forward; // 释放指针数组的空间
-}
-
-template <typename K, typename V>
-K Node<K, V>::getKey() const {
-    return key;
-}
-
-template <typename K, typename V>
-V Node<K, V>::getValue() const {
-    return value;
-}
-
-template <typename K, typename V>
-void Node<K, V>::setValue(V v) {
-    this->value = v;
-}
-
-/************************************************************************
-> 跳表类的实现
-> 成员属性：
-    > _max_level：跳表中允许的最大层数
-    > _header：跳表的头节点，用于指向跳表中的第一个节点
-    > _skip_list_level：跳表中的当前层数
-    > _element_count：跳表中的节点数量
-    > _file_writer & _file_reader：跳表生成持久化文件和读取持久化文件的写入器和读取器
-> public方法：
-    > 构造函数：初始化跳表
-    > 析构函数：销毁跳表
-    > get_random_level：生成一个随机层数
-    > create_node：创建一个新的节点
-    > insert_element：将节点插入到跳表中合适的位置
-    > display_list：显示跳表中当前的节点的信息
-    > search_element：从跳表中查找指定的元素
-    > delete_element：从跳表中删除指定的元素
-    > dump_file：将跳表的数据持久化到磁盘中
-    > load_file：从磁盘加载持久化的数据到跳表中
-    > clear：清空跳表，并回收其内存空间
-    > size：返回跳表的元素个数
-> private方法：
-    > get_key_value_from_string：从字符串中获取键值对
-    > is_valid_string：判断字符串是否为有效字符串
- ************************************************************************/
-
-template <typename K, typename V>
-class SkipList { 
-
-public:
-    SkipList(int);
-    ~SkipList();
-    int get_random_level(); // 生成随机层数（用于插入元素时决定该元素应该位于跳表的哪一层，是决定性能的关键。）
-    Node<K, V>* create_node(K, V, int); // 创建节点
-    int insert_element(K, V); // 插入元素
-    void display_list(); // 显示跳表
-    void display_list_prettily(); // 以更美观的方式显示跳表
-    bool search_element(K); // 查找元素
-    void delete_element(K); // 删除元素
-    void dump_file(); // 将跳表持久化到文件
-    void load_file(); // 从文件中加载跳表
-
-    void clear(Node<K, V>*); // 清空跳表
-    int size(); // 返回跳表的元素个数
-
-private:
-    int _max_level; // 跳表的最大层数
-
-    int _skip_list_level; // 跳表的当前的最大层数
-
-    Node<K, V> *_header; // 跳表的头节点
-
-    std::ofstream _file_writer; // 文件写入流
-    std::ifstream _file_reader; // 文件读取流
-
-    int _element_count; // 跳表的元素个数
-
-private:
-    bool is_valid_string(const std::string& str); // 判断字符串是否为有效字符串
-    void get_key_value_from_string(const std::string& str, std::string* key, std::string* value); // 从字符串中获取键值对
-};
-
-/**
- * 构造函数
- * @param max_level 跳表的最大层数
- * @return void 
- */
-
-template <typename K, typename V>
-SkipList<K, V>::SkipList(int max_level) {
-    this->_max_level = max_level;
-    this->_skip_list_level = 0;
-    this->_element_count = 0;
-
-    // 创建头节点
-    K k{}; // 使用默认初始化，不然编译器可能会报未初始化变量的错误
-    V v{}; 
-    this->_header = create_node(k, v, max_level);
-}
-
-template <typename K, typename V>
-SkipList<K, V>::~SkipList() {
-    
-    if (_file_reader.is_open()) { // 关闭文件读取流
-        _file_reader.close();
-    }
-    if (_file_writer.is_open()) { // 关闭文件写入流
-        _file_writer.close();
-    }
-
-    // 清空跳表
-    if (_header->forward[0] != nullptr) { 
-        clear(_header->forward[0]);
-    }
-    delete _header; // 释放头节点的空间
-}
-
-template <typename K, typename V>
-int SkipList<K, V>::get_random_level() {
-    int k = 1; // 初始化层级，每个节点至少出现在第一层
-
-    while (rand() % 2) { // 生成随机数，如果是奇数，则层级+1
-        k++;
-    }
-    // 返回层级，但不能超过最大层级
-    return (k < _max_level) ? k : _max_level;
-}
-
-/**
- * 创建节点
- * @param k 节点的键
- * @param v 节点的值
- * @param level 节点的层数
- * @return Node<K, V>* 返回创建的节点
- */
-template <typename K, typename V>
-Node<K, V>* SkipList<K, V>::create_node(const K key, const V value, const int level) { 
-    Node<K, V>* n = new Node<K, V>(key, value, level); // 创建节点
-    return n;
-}
-
-// Insert given key and value in skip list 
-// return 1 means element exists  
-// return 0 means insert successfully
-/* 
-                           +------------+
-                           |  insert 50 |
-                           +------------+
-level 4     +-->1+                                                      100
-                 |
-                 |                      insert +----+
-level 3         1+-------->10+---------------> | 50 |          70       100
-                                               |    |
-                                               |    |
-level 2         1          10         30       | 50 |          70       100
-                                               |    |
-                                               |    |
-level 1         1    4     10         30       | 50 |          70       100
-                                               |    |
-                                               |    |
-level 0         1    4   9 10         30   40  | 50 |  60      70       100
-                                               +----+
-
-*/
-
-/**
- * 插入元素
- * @param key 要插入的元素的键
- * @param value 要插入的元素的值
- * @return 如果元素已存在，返回 1；否则，进行更新 value 操作并返回 0。
- * @description 插入元素的过程是：
- *                  1. 确定节点层级；
- *                  2. 从头节点开始，查找每一层的节点，找到插入位置；
- *                  3. 更新每一层的节点的指针。
-*/
-template <typename K, typename V>
-int SkipList<K, V>::insert_element(const K key, const V value) {
-
-    mtx.lock(); 
-    Node<K, V>* current = this->_header; // 从头节点开始
-
-    Node<K, V>* update[_max_level + 1]; // 用于记录每一层中待更新指针的节点
-    memset(update, 0, sizeof(Node<K, V>*) * (_max_level + 1)); // 初始化 update 数组
-
-    // 从最大层级开始，逐层查找节点
-    for (int i = _skip_list_level; i >= 0; i--) { 
-        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
-            current = current->forward[i];
-        }
-        // 记录每一层中待更新指针的节点
-        update[i] = current; 
-    }
-
-    // 移动到最底层的下一个节点，准备插入操作
-    current = current->forward[0];
-    // 检查待插入节点的键是否已经存在
-    if (current != nullptr && current->getKey() == key) { 
-        /*
-         * 这里可以考虑插入覆盖操作
-         * current->set_value(value);
-         */
-        //std::cout << "Element with key " << key << " already exists." << std::endl;
-        mtx.unlock(); 
-        return 1; // 元素已存在
-    } else { // 键不存在或者当前节点为空
-    // current == nullptr || current->get_key() != key
-        int random_level = get_random_level(); // 生成随机层级
-        // 如果随机层级大于当前跳表的层级，则更新 update 数组
-        if (random_level > _skip_list_level) { 
-            // 对所有新的更高层级，将头节点设置为它们的前驱节点
-            for (int i = _skip_list_level + 1; i < random_level + 1; i++) { 
-                update[i] = _header;
-            }
-            _skip_list_level = random_level; // 更新跳表的层级
-        } 
-
-        // 创建新节点
-        Node<K, V>* inserted_node = create_node(key, value, random_level);
-        // 更新每一层的节点的指针
-        for (int i = 0; i <= random_level; i++) { 
-            // 新节点指向当前节点的下一个节点
-            inserted_node->forward[i] = update[i]->forward[i];
-            // 当前节点指向新节点
-            update[i]->forward[i] = inserted_node;
-        }
-        //std::cout << "Element with key " << key << " inserted successfully." << std::endl;
-        _element_count++; // 更新元素计数
-    }
-    mtx.unlock();
-    return 0; // 插入成功
-}
-
-// Display skip list
-/**
- * 打印跳表
- * @param void
- * @return void
- * @description 遍历每一层的节点，输出节点的键和值 
- */
-template <typename K, typename V>
-void SkipList<K, V>::display_list() { 
-    std::cout << "\n*****Skip List*****" << "\n";
-    // 遍历每一层
-    for (int i = _skip_list_level - 1; i >= 0; i--) { 
-        Node<K, V>* node = this->_header->forward[i];
-        std::cout << "Level " << i << ": _header ";
-        // 遍历每一层的节点
-        while (node != nullptr) { 
-            std::cout << node->getKey() << ":" << node->getValue() << " ";
-            node = node->forward[i];
-        }
-        std::cout << std::endl;
-    }
-}
-
-
-// Display skip list prettily
-/**
- * 整齐打印跳表
- * @param void
- * @return void
- * @description 遍历每一层的节点，输出节点的键和值 
- */
-template <typename K, typename V>
-void SkipList<K, V>::display_list_prettily() { 
-    
-    std::cout << "\n*****Skip List*****" << "\n";
-    // 遍历每一层
-    for (int i = _skip_list_level - 1; i >= 0; i--) { 
-        Node<K, V>* node = this->_header->forward[i];
-        std::cout << "Level " << i << ": _header ";
-        Node<K, V>* prev_node = this->_header;
-
-        // 遍历每一层的节点
-        while (node != nullptr) { 
-
-            int key_diff = 0;                          // 计算相邻节点之间的 key 差值
-            int total_length_between_nodes = 0;        // 计算中间节点之间的总长度
-            Node<K, V>* temp_node = prev_node;         // 临时节点
-
-            while (temp_node != node) { 
-
-                std::stringstream temp_ss_key, temp_ss_value;
-                temp_ss_key << temp_node->getKey();
-                temp_ss_value << temp_node->getValue();
-
-                key_diff++;
-                if (key_diff > 1) {
-                    total_length_between_nodes += temp_ss_key.str().length() + temp_ss_value.str().length();
-                } else {
-                    total_length_between_nodes = 0;
-                }
-                                       
-                temp_node = temp_node->forward[0];
-            }
-
-            int arrow_length = 0;
-            // 计算箭头长度：假设可以用 key 值之间的差值来决定距离
-            if (key_diff == 1) {
-                arrow_length = 2;
-            } else {
-                arrow_length = 2 * key_diff + 4 * (key_diff - 1) + total_length_between_nodes;
-            }
-                
-            std::string arrows(arrow_length, '-');     // 生成箭头字符串
-
-            std::cout << arrows << "> " << node->getKey() << ":" << node->getValue() << " ";
-            
-            prev_node = node;                           // 更新前一个节点
-            node = node->forward[i];
-        }
-        std::cout << std::endl;
-    }
-}
-
-// Search for element in skip list 
-/*
-                           +------------+
-                           |  select 60 |
-                           +------------+
-level 4     +-->1+                                                      100
-                 |
-                 |
-level 3         1+-------->10+------------------>50+           70       100
-                                                   |
-                                                   |
-level 2         1          10         30         50|           70       100
-                                                   |
-                                                   |
-level 1         1    4     10         30         50|           70       100
-                                                   |
-                                                   |
-level 0         1    4   9 10         30   40    50+-->60      70       100
-*/
-
-/**
- * 查找元素
- * @param key 要查找的元素的键
- * @return bool 如果找到返回true，否则返回false
-*/
-template <typename K, typename V>
-bool SkipList<K, V>::search_element(K key) {
-
-    //std::cout << "search_element-----------------" << std::endl;
-    // 定义一个指针 current，初始化为跳表的头节点 _header
-    Node<K, V>* current = _header;
-
-    for (int i = _skip_list_level; i >= 0; i--) { // 从跳表的最高层开始查找
-        // 遍历当前层级，直到下一个节点的键值大于要查找的键值
-        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
-            // 移动到下一个节点
-            current = current->forward[i];
-        }
-        // 当前节点的下一个节点的键值大于待查找的键值时，进行下层操作
-    }
-    // 检查当前层（最底层）的下一个节点的键值是否为要查找的键值
-    current = current->forward[0];
-    if (current != nullptr && current->getKey() == key) { 
-        //std::cout << "Found key: " << key << ", value: " << current->getValue() << std::endl;
-        return true; // 找到了
-    }
-
-    //std::cout << " Not found key: " << key << std::endl;
-    return false; // 没找到
-}
-
-/**
- * 删除跳表中的节点
- * @param key 要删除的节点的键
- * @return void 
- * @description 删除元素的过程是：
- *                  1. 定位待删除节点：通过搜索确定需要删除的节点位置；
- *                  2. 更新指针关系：调整相关节点的指针，以从跳表中移除目标节点；
- *                  3. 内存回收：释放被删除节点所占用的资源。
- */
-template <typename K, typename V>
-void SkipList<K, V>::delete_element(K key) { 
-    mtx.lock(); // 加锁
-    Node<K, V>* current = _header; // 从头节点开始
-
-    Node<K, V>* update[_max_level + 1]; // 用于记录每一层中待更新指针的节点
-    memset(update, 0, sizeof(Node<K, V>*) * (_max_level + 1)); // 初始化 update 数组
-
-    // 从最大层级开始向下搜索待删除结点
-    for (int i = _skip_list_level; i >= 0; i--) { 
-        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) { 
-            current = current->forward[i];
-        }
-        update[i] = current; // 记录每一层中待更新指针的节点
-    }
-
-    current = current->forward[0]; // 移动到底层的下一个节点
-    // 检查待删除节点的键是否存在
-    if (current != nullptr && current->getKey() == key) { 
-        // 更新每一层的指针
-        for (int i = 0; i <= _skip_list_level; i++) { 
-            // 如果当前层的节点的下一个节点是待删除节点
-            if (update[i]->forward[i] == current) { 
-                // 将当前层的节点的下一个节点指向待删除节点的下一个节点
-                update[i]->forward[i] = current->forward[i];
-            } else { 
-                break; // 如果当前层的节点的下一个节点不是待删除节点，说明待删除节点不存在，直接退出
-            }
-        }
-
-        // 如果删除节点后，跳表的最高层没有节点了，降低跳表的层级
-        while (_skip_list_level > 0 && _header->forward[_skip_list_level] == nullptr) { 
-            _skip_list_level--;
-        }
-
-        //std::cout << "Element with key " << key << " deleted successfully." << std::endl;
-        delete current; // 释放被删除节点的内存
-        _element_count--; // 更新元素计数
-    }
-    mtx.unlock(); // 解锁
-    return;
-}
-
-// Dump data in memory to file
-template <typename K, typename V>
-void SkipList<K, V>::dump_file() { 
-    
-    std::cout << "Dumping data to file..." << std::endl;
-    file_mtx.lock(); // 加锁
-    _file_writer.open(STORE_FILE); // 打开文件，STORE_FILE是路径
-    Node<K, V>* current  = this->_header->forward[0]; // 从头节点开始遍历
-
-    while (current != nullptr) { 
-        _file_writer << current->getKey() << ":" << current->getValue() << std::endl; // 将节点的键值对写入文件
-        current = current->forward[0]; // 移动到下一个节点
-    }
-    file_mtx.unlock(); // 解锁
-    _file_writer.flush(); // 刷新文件
-    _file_writer.close(); // 关闭文件
-    
-    return;
-}
-
-// 验证字符串的合法性
-template <typename K, typename V>
-bool SkipList<K, V>::is_valid_string(const std::string& str) { 
-    // 如果字符串str非空，并且字符串中包含分隔符delimiter，那么返回true
-    // find()函数返回字符串中第一个匹配的位置，如果没有找到匹配的位置，则返回std::string::npos
-    if (!str.empty()&& str.find(delimiter) != std::string::npos) { 
-        return true;
-    }
-
-    return false;
-}
-
-// 将字符串分割为键和值
-template <typename K, typename V>
-void SkipList<K, V>::get_key_value_from_string(const std::string& str, std::string* key, std::string* value) { 
-    
-    if (!is_valid_string(str)) { 
-        return;
-    }
-
-    *key = str.substr(0, str.find(delimiter)); // 获取键
-    *value = str.substr(str.find(delimiter) + 1); // 获取值
-
-    return;
-}
-
-// Load data from file to memory
-template <typename K, typename V>
-void SkipList<K, V>::load_file() {
-    file_mtx.lock(); // 加锁
-    _file_reader.open(STORE_FILE); // 打开文件
-    std::cout << "Loading data from file..." << std::endl;
-
-    std::string line; // 用于存储文件中的每一行数据
-    K* key = new K(); // 用于存储键
-    V* value = new V(); // 用于存储值
-
-    while (getline(_file_reader, line)) { // 逐行读取文件
-        get_key_value_from_string(line, key, value); // 将每一行数据分割为键和值
-        if (key->empty() || value->empty()) { // 如果键或值为空，跳过
-            continue;
-        }
-
-        // stoi()函数将字符串转换为整数
-        //insert_element(stoi(*key), *value); // 将键值对插入跳表
-        insert_element(*key, *value); // 将键值对插入跳表
-        std::cout << "key: " << *key << ", " << "value: " << *value << std::endl;
-    }
-
-    delete key; // 释放内存
-    delete value; // 释放内存
-    
-    _file_reader.close(); // 关闭文件
-    file_mtx.unlock(); // 解锁
-
-    return;
-}
\ No newline at end of file
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <type_traits>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include "epoch.h"
+#include "node_arena.h"
+#include "level_generator.h"
+#include "key_prefix.h"
+#include "snapshot.h"
+#include "mapped_snapshot.h"
+
+# define STORE_FILE "store/dumpFile" // 存储文件
+# define SEARCH_BATCH_WIDTH 16 // multi_search 同时进行的查找个数
+
+std::string delimiter = ":"; // 分隔符
+
+/* ************************************************************************
+> 跳表的节点类的实现
+> 成员属性：
+    > key：节点的键值
+    > value：节点的值
+    > forward：原子指针数组，用于指向后继节点。写线程以 release 语义发布，读线程以 acquire 语义读取，查找无需加锁
+    > node_level：节点的层数
+    > 基类 NodeKeyPrefix：字符串键在节点中保存前 8 个字节（key_prefix.h），其它键类型不占空间
+> public方法：
+    > 构造函数：初始化节点。可以单独申请 forward 数组，也可以使用内存池中紧跟在节点之后的空间
+    > 析构函数：销毁节点
+    > getKey：获取节点的键值（常引用）
+    > getValue：获取节点的值（常引用）
+    > setValue：设置节点的值
+    > key_less / key_equals：与查找的键比较，字符串键先比较前缀，相同时才访问完整的键
+ ************************************************************************/
+
+template <typename K, typename V>
+class Node : private NodeKeyPrefix<K> { 
+
+public: 
+
+    Node() {} // 默认构造函数
+
+    Node(K k, V v, int); // 构造函数，单独申请 forward 数组
+
+    Node(const K& k, const V& v, int level, std::atomic<Node<K, V>*>* links); // 构造函数，forward 数组使用外部内存
+
+    ~Node(); // 析构函数
+
+    const K& getKey() const;  // get key，返回引用，查找时原地比较，不复制键
+
+    const V& getValue() const; // get value
+
+    void setValue(V);
+
+    bool key_less(const K& k, uint64_t prefix) const; // 节点的键 < k，prefix 为 KeyPrefix<K>::of(k)
+
+    bool key_equals(const K& k, uint64_t prefix) const; // 节点的键 == k
+
+    std::atomic<Node<K, V>*> *forward; // 原子指针数组，每个元素指向该层的后继节点
+
+    int node_level; // 节点的层数
+
+private:
+    bool owns_forward; // forward 数组是否由节点自己申请
+    K key;
+    V value;
+};
+
+/* ************************************************************************
+> 关键点1. 同一节点的多层跳转：在相同键值、不同层级节点之间的跳转
+> 关键点2. 不同节点的单层跳转：在相同层级、不同键值节点之间的跳转
+> 通过这两种跳转方式，可以实现跳表的查找、插入、删除等操作
+
+> 关键点1的解决方法：Node<K, V> **forward
+> 描述：使用一个指针数组forward，数组中的每个指针对应节点在一个特定层级的后继节点
+        通过变更数组下标，可以实现同一节点的多层跳转。
+> 关键点2的解决方法：*forward
+> 描述：参考单链表中的指针域，通过指针域实现节点之间的连接
+
+> 例子：假设一个节点的层数为3，那么这个节点的forward指针数组的大小为3。其中forward[0]
+        指向该节点在第0层的后继节点，forward[1]指向该节点在第1层的后继节点，forward[2]
+ ************************************************************************/
+
+template <typename K, typename V>
+Node<K, V>::Node(const K k, const V v, int level) : NodeKeyPrefix<K>(k) {
+    this->key = k;
+    this->value = v;
+    this->node_level = level;
+    this->owns_forward = true;
+
+    // 申请指针数组的空间
+    this->forward = new std::atomic<Node<K, V>*>[level + 1]; // 申请指针数组的空间
+    
+    // Fill forward array with 0(NULL)
+    for (int i = 0; i <= level; i++) { // 初始化指针数组
+        forward[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * 构造函数，forward 数组使用外部提供的内存
+ * @param links 至少能容纳 level + 1 个指针的内存，一般是内存池中紧跟在节点之后的空间
+ */
+template <typename K, typename V>
+Node<K, V>::Node(const K& k, const V& v, int level, std::atomic<Node<K, V>*>* links)
+    : NodeKeyPrefix<K>(k), forward(links), node_level(level), owns_forward(false), key(k), value(v) {
+    for (int i = 0; i <= level; i++) { // 在外部内存上构造并初始化指针数组
+        new (&forward[i]) std::atomic<Node<K, V>*>(nullptr);
+    }
+}
+
+template <typename K, typename V>
+Node<K, V>::~Node() {
+    if (owns_forward) {
+        delete [] forward; // 释放指针数组的空间
+    }
+}
+
+template <typename K, typename V>
+const K& Node<K, V>::getKey() const {
+    return key;
+}
+
+template <typename K, typename V>
+const V& Node<K, V>::getValue() const {
+    return value;
+}
+
+template <typename K, typename V>
+void Node<K, V>::setValue(V v) {
+    this->value = v;
+}
+
+template <typename K, typename V>
+bool Node<K, V>::key_less(const K& k, uint64_t prefix) const {
+    return NodeKeyPrefix<K>::key_less(key, k, prefix);
+}
+
+template <typename K, typename V>
+bool Node<K, V>::key_equals(const K& k, uint64_t prefix) const {
+    return NodeKeyPrefix<K>::key_equals(key, k, prefix);
+}
+
+/* ************************************************************************
+> 查找结果的句柄，由 find 返回
+> 句柄持有读保护（SkipList 为纪元临界区，SkipListWithCache 为跳表的共享锁），
+  存续期间节点不会被释放，通过 * 和 -> 直接读取节点中的值，不复制键和值
+> 没有找到时句柄为空，不持有读保护
+> 句柄应尽快析构：持有期间同一线程不能再修改同一个跳表（SkipListWithCache 的写操作、SkipList 的 clear 会等待它）
+ ************************************************************************/
+
+template <typename V, typename Guard>
+class ValueRef {
+public:
+    ValueRef() : _value(nullptr) {} // 空句柄
+    ValueRef(const V* value, Guard&& guard) : _value(value), _guard(std::move(guard)) {}
+    ValueRef(ValueRef&& other) = default;
+
+    explicit operator bool() const { return _value != nullptr; } // 是否找到
+    const V& operator*() const { return *_value; }
+    const V* operator->() const { return _value; }
+
+private:
+    const V* _value; // 节点中的值
+    Guard _guard; // 读保护，随句柄析构释放
+};
+
+/************************************************************************
+> 跳表类的实现
+> 成员属性：
+    > _max_level：跳表中允许的最大层数，构造时传入 AUTO_MAX_LEVEL 则取 LEVEL_GENERATOR_MAX_LEVEL
+    > _level_generator：随机层数生成器，晋升概率 p 可选 1/2、1/4、1/e，新节点的层数同时受元素个数限制
+    > _header：跳表的头节点，用于指向跳表中的第一个节点
+    > _skip_list_level：跳表中的当前层数（原子变量，查找时无锁读取）
+    > _element_count：跳表中的节点数量
+    > _reclaimer：纪元回收器，被删除的节点在所有无锁读者离开后才真正释放
+    > _arena：节点内存池，节点与 forward 数组一次分配、连续存放，释放的节点按层数回收复用
+    > _file_writer & _file_reader：跳表生成持久化文件和读取持久化文件的写入器和读取器
+    > _mtx：读写锁，每个跳表实例独立持有。打印、持久化共享加锁，插入、删除独占加锁，查找不加锁
+    > _file_mtx：文件互斥锁，每个跳表实例独立持有
+> public方法：
+    > 构造函数：初始化跳表
+    > 析构函数：销毁跳表
+    > get_random_level：生成一个随机层数
+    > create_node：创建一个新的节点
+    > insert_element：将节点插入到跳表中合适的位置
+    > display_list：显示跳表中当前的节点的信息
+    > search_element：从跳表中查找指定的元素
+    > find：查找元素并返回引用节点中的值的句柄，不复制
+    > scan：按键的顺序读取 [start, end) 内最多 limit 个元素
+    > cursor：创建有序游标（Cursor），可以向前、向后遍历
+    > delete_element：从跳表中删除指定的元素
+    > dump_file：将跳表的数据持久化到磁盘中
+    > load_file：从磁盘加载持久化的数据到跳表中，跳表为空时线性批量构建
+    > bulk_load：从有序数组批量构建跳表，O(n)
+    > multi_get / multi_put：批量查找、批量插入，按键排序后从上一个键的前驱继续查找（finger search）
+    > multi_search：批量判断是否存在，多个查找交错执行，每一步预取下一个节点，访存延迟互相重叠
+    > load_mapped_file：mmap 快照文件，配合 SnapshotString 时键值零拷贝
+    > clear()：运行时清空跳表（重置键空间），整块释放内存池，不逐个释放节点
+    > clear(Node*)：迭代地析构从某个节点开始的整条第 0 层链表，栈空间 O(1)
+    > size：返回跳表的元素个数
+> private方法：
+    > get_key_value_from_string：从字符串中获取键值对
+    > is_valid_string：判断字符串是否为有效字符串
+    > load_snapshot_file / load_text_file：分别读取二进制快照和旧版文本格式
+    > bulk_append：批量构建时在每层的尾指针后追加节点
+    > load_records：load_snapshot_file 和 load_mapped_file 共用的构建逻辑
+    > find_node：无锁查找等于 key 的节点，search_element 和 find 共用
+    > find_less_than / find_last：无锁查找最后一个小于 key 的节点 / 最后一个节点，scan 和游标使用
+    > find_predecessors：从上一个键的前驱数组继续查找每层的前驱，multi_get 和 multi_put 共用
+ ************************************************************************/
+
+template <typename K, typename V>
+class SkipList { 
+
+public:
+    using Ref = ValueRef<V, EpochReclaimer::Guard>; // find 的返回值
+    class Cursor; // 有序游标
+
+    SkipList(int, LevelProbability p = LevelProbability::HALF);
+    ~SkipList();
+    int get_random_level(); // 生成随机层数（用于插入元素时决定该元素应该位于跳表的哪一层，是决定性能的关键。）
+    Node<K, V>* create_node(K, V, int); // 创建节点
+    int insert_element(K, V); // 插入元素
+    void display_list(); // 显示跳表
+    void display_list_prettily(); // 以更美观的方式显示跳表
+    bool search_element(const K&); // 查找元素
+    Ref find(const K&); // 查找元素，返回引用节点中的值的句柄
+    std::vector<std::pair<K, V>> scan(const K& start, const K& end, size_t limit = SIZE_MAX); // 范围读取 [start, end)
+    Cursor cursor(); // 创建游标，定位之前无效
+    void delete_element(const K&); // 删除元素
+    void dump_file(); // 将跳表持久化到文件
+    void load_file(); // 从文件中加载跳表
+    int bulk_load(const std::vector<std::pair<K, V>>& elements); // 从有序数组批量构建跳表
+    std::vector<std::optional<V>> multi_get(const std::vector<K>& keys); // 批量查找，结果与 keys 一一对应
+    std::vector<bool> multi_search(const std::vector<K>& keys); // 批量判断是否存在，交错执行并预取节点
+    int multi_put(const std::vector<std::pair<K, V>>& elements); // 批量插入，只加一次写锁
+    void load_mapped_file(const std::string& path = STORE_FILE); // 通过 mmap 加载快照，键值可直接引用映射区
+
+    void clear(); // 清空跳表
+    void clear(Node<K, V>*); // 析构从该节点开始的所有节点，内存由内存池整块回收
+    int size(); // 返回跳表的元素个数
+    size_t memory_usage(); // 节点占用的内存，即内存池向系统申请的字节数
+
+private:
+    int _max_level; // 跳表的最大层数
+
+    LevelGenerator _level_generator; // 随机层数生成器
+
+    std::atomic<int> _skip_list_level; // 跳表的当前的最大层数
+
+    Node<K, V> *_header; // 跳表的头节点
+
+    std::ofstream _file_writer; // 文件写入流
+    std::ifstream _file_reader; // 文件读取流
+
+    std::atomic<int> _element_count; // 跳表的元素个数
+
+    std::atomic<uint64_t> _delete_version; // 删除版本号，每摘除一个节点（或清空）加 1，游标据此判断当前节点是否仍在表中
+
+    std::shared_mutex _mtx; // 读写锁，不同实例之间互不影响
+    std::mutex _file_mtx; // 文件互斥锁
+
+    NodeArena<Node<K, V>, std::atomic<Node<K, V>*>> _arena; // 节点内存池，只在写锁内访问
+
+    std::vector<std::shared_ptr<MappedFile>> _mappings; // load_mapped_file 建立的映射，节点中的 SnapshotString 可能引用它们
+
+    EpochReclaimer _reclaimer; // 纪元回收器，保护无锁的查找路径（须在 _arena 之后声明，先于它析构）
+
+private:
+    bool is_valid_string(const std::string& str); // 判断字符串是否为有效字符串
+    void get_key_value_from_string(const std::string& str, std::string* key, std::string* value); // 从字符串中获取键值对
+    void load_snapshot_file(const std::string& path); // 读取二进制快照
+    void load_text_file(const std::string& path); // 读取旧版的文本格式
+    bool bulk_append(Node<K, V>** tails, uint64_t& seq, const K& key, const V& value); // 批量构建时在末尾追加节点
+    template <typename ForEach>
+    uint64_t load_records(ForEach for_each); // 把有序的记录流加载进跳表
+    void destroy_node(Node<K, V>* node); // 析构节点并把内存归还内存池
+    Node<K, V>* find_node(const K& key); // 查找等于 key 的节点，调用者需处于纪元临界区
+    Node<K, V>* find_less_than(const K& key); // 最后一个小于 key 的节点，没有时返回头节点，调用者需处于纪元临界区
+    Node<K, V>* find_last(); // 最后一个节点，空表时返回头节点，调用者需处于纪元临界区
+    void find_predecessors(const K& key, Node<K, V>** update); // 从 update 继续查找 key 在每层的前驱
+    static void free_node(void* ctx, void* node); // 纪元回收器的回调，释放被删除的节点
+};
+
+/**
+ * 构造函数
+ * @param max_level 跳表的最大层数，AUTO_MAX_LEVEL 表示由元素个数决定（上限 LEVEL_GENERATOR_MAX_LEVEL）
+ * @param p 节点晋升到上一层的概率
+ * @return void 
+ */
+
+template <typename K, typename V>
+SkipList<K, V>::SkipList(int max_level, LevelProbability p) : _level_generator(p) {
+    if (max_level <= AUTO_MAX_LEVEL) { // 头节点按上限分配，新节点的层数由 level_cap 随元素个数增长
+        max_level = LEVEL_GENERATOR_MAX_LEVEL;
+    }
+    this->_max_level = max_level;
+    this->_skip_list_level = 0;
+    this->_element_count = 0;
+    this->_delete_version = 0;
+
+    // 创建头节点。头节点不放在内存池中，clear() 整块释放内存池时它保持不变
+    K k{}; // 使用默认初始化，不然编译器可能会报未初始化变量的错误
+    V v{}; 
+    this->_header = new Node<K, V>(k, v, max_level);
+}
+
+template <typename K, typename V>
+SkipList<K, V>::~SkipList() {
+    
+    if (_file_reader.is_open()) { // 关闭文件读取流
+        _file_reader.close();
+    }
+    if (_file_writer.is_open()) { // 关闭文件写入流
+        _file_writer.close();
+    }
+
+    // 析构时已没有读者，立即释放所有等待回收的节点
+    _reclaimer.reclaim_all();
+
+    // 析构所有节点，节点内存随 _arena 整块释放
+    clear(_header->forward[0].load(std::memory_order_relaxed));
+    delete _header; // 释放头节点的空间
+}
+
+/**
+ * 清空跳表
+ * @return void
+ * @description 用于运行时重置整个键空间：
+ *                  1. 独占加锁，把头节点的所有 forward 指针置空，之后的查找看到的是空表；
+ *                  2. 等待一个宽限期，保证仍停留在旧节点上的无锁读者全部离开；
+ *                  3. 回收所有待回收节点，析构旧节点（键值可平凡析构时直接跳过），整块释放内存池。
+ *              整个过程不递归、不逐个 free，适合清空上千万个节点的大表
+ */
+template <typename K, typename V>
+void SkipList<K, V>::clear() {
+    _mtx.lock(); // 独占加锁
+
+    Node<K, V>* first = _header->forward[0].load(std::memory_order_relaxed);
+    for (int i = 0; i <= _max_level; i++) {
+        _header->forward[i].store(nullptr, std::memory_order_release);
+    }
+    _skip_list_level = 0;
+    _element_count = 0;
+    _delete_version++; // 旧节点全部失效，游标下次移动时重新定位
+
+    // 等待旧节点上的读者离开。待回收节点只会在写锁内产生，此时统一回收是安全的
+    _reclaimer.synchronize();
+    _reclaimer.reclaim_all();
+
+    clear(first);
+    _arena.release_all();
+    _mappings.clear(); // 已没有节点引用映射区
+
+    _mtx.unlock(); // 解锁
+}
+
+/**
+ * 析构从 node 开始的整条第 0 层链表
+ * @param node 链表中的第一个节点，可以为 nullptr
+ * @return void
+ * @description 只调用节点的析构函数，不归还内存，调用者随后应整块释放内存池
+ */
+template <typename K, typename V>
+void SkipList<K, V>::clear(Node<K, V>* node) {
+    // 键和值都可以平凡析构时，节点析构没有任何作用，直接跳过遍历
+    if (std::is_trivially_destructible<K>::value && std::is_trivially_destructible<V>::value) {
+        return;
+    }
+    while (node != nullptr) {
+        Node<K, V>* next = node->forward[0].load(std::memory_order_relaxed);
+        node->~Node();
+        node = next;
+    }
+}
+
+/**
+ * 生成随机层数
+ * @return int 范围 [0, _max_level]，第 i 层出现的概率为 p^i
+ * @description 使用线程本地的随机数，不经过 rand() 的全局锁；
+ *              层数同时不超过 ceil(log_{1/p} n)（n 为插入后的元素个数），更高的层期望不到一个节点
+ */
+template <typename K, typename V>
+int SkipList<K, V>::get_random_level() {
+    int cap = _level_generator.level_cap(_element_count.load(std::memory_order_relaxed) + 1);
+    return _level_generator.next(cap < _max_level ? cap : _max_level);
+}
+
+/**
+ * 创建节点
+ * @param k 节点的键
+ * @param v 节点的值
+ * @param level 节点的层数
+ * @return Node<K, V>* 返回创建的节点
+ */
+template <typename K, typename V>
+Node<K, V>* SkipList<K, V>::create_node(const K key, const V value, const int level) { 
+    // 从内存池中分配一块内存，节点对象之后紧跟 forward 数组
+    void* block = _arena.allocate(level);
+    Node<K, V>* n = new (block) Node<K, V>(key, value, level, _arena.links_of(block)); // 创建节点
+    return n;
+}
+
+/**
+ * 销毁节点
+ * @param node 节点
+ * @description 调用析构函数后把内存块挂回对应层数的空闲链表，调用者需持有写锁
+ */
+template <typename K, typename V>
+void SkipList<K, V>::destroy_node(Node<K, V>* node) {
+    int level = node->node_level;
+    node->~Node();
+    _arena.deallocate(node, level);
+}
+
+// Insert given key and value in skip list 
+// return 1 means element exists  
+// return 0 means insert successfully
+/* 
+                           +------------+
+                           |  insert 50 |
+                           +------------+
+level 4     +-->1+                                                      100
+                 |
+                 |                      insert +----+
+level 3         1+-------->10+---------------> | 50 |          70       100
+                                               |    |
+                                               |    |
+level 2         1          10         30       | 50 |          70       100
+                                               |    |
+                                               |    |
+level 1         1    4     10         30       | 50 |          70       100
+                                               |    |
+                                               |    |
+level 0         1    4   9 10         30   40  | 50 |  60      70       100
+                                               +----+
+
+*/
+
+/**
+ * 插入元素
+ * @param key 要插入的元素的键
+ * @param value 要插入的元素的值
+ * @return 如果元素已存在，返回 1；否则，进行更新 value 操作并返回 0。
+ * @description 插入元素的过程是：
+ *                  1. 确定节点层级；
+ *                  2. 从头节点开始，查找每一层的节点，找到插入位置；
+ *                  3. 更新每一层的节点的指针。
+*/
+template <typename K, typename V>
+int SkipList<K, V>::insert_element(const K key, const V value) {
+
+    _mtx.lock(); // 独占加锁
+    Node<K, V>* current = this->_header; // 从头节点开始
+
+    Node<K, V>* update[_max_level + 1]; // 用于记录每一层中待更新指针的节点
+    memset(update, 0, sizeof(Node<K, V>*) * (_max_level + 1)); // 初始化 update 数组
+
+    uint64_t prefix = KeyPrefix<K>::of(key); // 字符串键的前 8 个字节，先与节点中的前缀比较
+
+    // 从最大层级开始，逐层查找节点
+    for (int i = _skip_list_level; i >= 0; i--) { 
+        Node<K, V>* next = current->forward[i].load(std::memory_order_relaxed); // 写线程持有独占锁，无需同步
+        while (next != nullptr && next->key_less(key, prefix)) {
+            current = next;
+            next = current->forward[i].load(std::memory_order_relaxed);
+        }
+        // 记录每一层中待更新指针的节点
+        update[i] = current; 
+    }
+
+    // 移动到最底层的下一个节点，准备插入操作
+    current = current->forward[0];
+    // 检查待插入节点的键是否已经存在
+    if (current != nullptr && current->key_equals(key, prefix)) { 
+        /*
+         * 这里可以考虑插入覆盖操作
+         * current->set_value(value);
+         */
+        //std::cout << "Element with key " << key << " already exists." << std::endl;
+        _mtx.unlock(); 
+        return 1; // 元素已存在
+    } else { // 键不存在或者当前节点为空
+    // current == nullptr || current->get_key() != key
+        int random_level = get_random_level(); // 生成随机层级
+        // 如果随机层级大于当前跳表的层级，则更新 update 数组
+        if (random_level > _skip_list_level) { 
+            // 对所有新的更高层级，将头节点设置为它们的前驱节点
+            for (int i = _skip_list_level + 1; i < random_level + 1; i++) { 
+                update[i] = _header;
+            }
+            _skip_list_level = random_level; // 更新跳表的层级
+        } 
+
+        // 创建新节点
+        Node<K, V>* inserted_node = create_node(key, value, random_level);
+        // 更新每一层的节点的指针，自底向上发布：读者在第 i 层看到新节点时，它的第 0~i 层指针都已就绪
+        for (int i = 0; i <= random_level; i++) { 
+            // 新节点指向当前节点的下一个节点
+            inserted_node->forward[i].store(update[i]->forward[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            // 当前节点指向新节点
+            update[i]->forward[i].store(inserted_node, std::memory_order_release);
+        }
+        //std::cout << "Element with key " << key << " inserted successfully." << std::endl;
+        _element_count++; // 更新元素计数
+    }
+    _mtx.unlock();
+    return 0; // 插入成功
+}
+
+// Display skip list
+/**
+ * 打印跳表
+ * @param void
+ * @return void
+ * @description 遍历每一层的节点，输出节点的键和值 
+ */
+template <typename K, typename V>
+void SkipList<K, V>::display_list() { 
+    std::shared_lock<std::shared_mutex> lock(_mtx); // 共享加锁
+    std::cout << "\n*****Skip List*****" << "\n";
+    // 遍历每一层
+    for (int i = _skip_list_level - 1; i >= 0; i--) { 
+        Node<K, V>* node = this->_header->forward[i];
+        std::cout << "Level " << i << ": _header ";
+        // 遍历每一层的节点
+        while (node != nullptr) { 
+            std::cout << node->getKey() << ":" << node->getValue() << " ";
+            node = node->forward[i];
+        }
+        std::cout << std::endl;
+    }
+}
+
+
+// Display skip list prettily
+/**
+ * 整齐打印跳表
+ * @param void
+ * @return void
+ * @description 遍历每一层的节点，输出节点的键和值 
+ */
+template <typename K, typename V>
+void SkipList<K, V>::display_list_prettily() { 
+    
+    std::shared_lock<std::shared_mutex> lock(_mtx); // 共享加锁
+    std::cout << "\n*****Skip List*****" << "\n";
+    // 遍历每一层
+    for (int i = _skip_list_level - 1; i >= 0; i--) { 
+        Node<K, V>* node = this->_header->forward[i];
+        std::cout << "Level " << i << ": _header ";
+        Node<K, V>* prev_node = this->_header;
+
+        // 遍历每一层的节点
+        while (node != nullptr) { 
+
+            int key_diff = 0;                          // 计算相邻节点之间的 key 差值
+            int total_length_between_nodes = 0;        // 计算中间节点之间的总长度
+            Node<K, V>* temp_node = prev_node;         // 临时节点
+
+            while (temp_node != node) { 
+
+                std::stringstream temp_ss_key, temp_ss_value;
+                temp_ss_key << temp_node->getKey();
+                temp_ss_value << temp_node->getValue();
+
+                key_diff++;
+                if (key_diff > 1) {
+                    total_length_between_nodes += temp_ss_key.str().length() + temp_ss_value.str().length();
+                } else {
+                    total_length_between_nodes = 0;
+                }
+                                       
+                temp_node = temp_node->forward[0];
+            }
+
+            int arrow_length = 0;
+            // 计算箭头长度：假设可以用 key 值之间的差值来决定距离
+            if (key_diff == 1) {
+                arrow_length = 2;
+            } else {
+                arrow_length = 2 * key_diff + 4 * (key_diff - 1) + total_length_between_nodes;
+            }
+                
+            std::string arrows(arrow_length, '-');     // 生成箭头字符串
+
+            std::cout << arrows << "> " << node->getKey() << ":" << node->getValue() << " ";
+            
+            prev_node = node;                           // 更新前一个节点
+            node = node->forward[i];
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Search for element in skip list 
+/*
+                           +------------+
+                           |  select 60 |
+                           +------------+
+level 4     +-->1+                                                      100
+                 |
+                 |
+level 3         1+-------->10+------------------>50+           70       100
+                                                   |
+                                                   |
+level 2         1          10         30         50|           70       100
+                                                   |
+                                                   |
+level 1         1    4     10         30         50|           70       100
+                                                   |
+                                                   |
+level 0         1    4   9 10         30   40    50+-->60      70       100
+*/
+
+/**
+ * 查找元素
+ * @param key 要查找的元素的键
+ * @return bool 如果找到返回true，否则返回false
+ * @description 查找不加锁：进入纪元临界区后沿 acquire 读取的指针前进。
+ *              并发删除的节点只会被摘除而不会立即释放，其 forward 指针仍然有效，
+ *              直到所有读者离开临界区后才由纪元回收器释放。
+*/
+template <typename K, typename V>
+bool SkipList<K, V>::search_element(const K& key) {
+
+    //std::cout << "search_element-----------------" << std::endl;
+    EpochReclaimer::Guard guard = _reclaimer.pin(); // 进入纪元临界区
+    return find_node(key) != nullptr;
+}
+
+/**
+ * 查找元素，返回引用节点中的值的句柄
+ * @param key 要查找的元素的键
+ * @return Ref 找到时句柄引用节点中的值，并持有纪元临界区；没找到时为空句柄
+ * @description 与 search_element 相同地无锁查找，找到后把纪元临界区交给句柄：
+ *              句柄存续期间节点即使被并发删除也不会释放，值可以直接引用，不复制。
+ *              节点的值插入后不再修改，读到的值不会被改写
+*/
+template <typename K, typename V>
+typename SkipList<K, V>::Ref SkipList<K, V>::find(const K& key) {
+    EpochReclaimer::Guard guard = _reclaimer.pin(); // 进入纪元临界区
+    Node<K, V>* node = find_node(key);
+    if (node == nullptr) {
+        return Ref();
+    }
+    return Ref(&node->getValue(), std::move(guard));
+}
+
+/**
+ * 查找等于 key 的节点
+ * @param key 要查找的元素的键
+ * @return Node<K, V>* 找到的节点，没找到返回 nullptr
+ * @note 调用者需处于纪元临界区；getKey 返回引用，逐个节点比较时不复制键
+ */
+template <typename K, typename V>
+Node<K, V>* SkipList<K, V>::find_node(const K& key) {
+    // 定义一个指针 current，初始化为跳表的头节点 _header
+    Node<K, V>* current = _header;
+    uint64_t prefix = KeyPrefix<K>::of(key); // 字符串键的前缀只计算一次，前缀不同的节点不访问完整的键
+
+    for (int i = _skip_list_level.load(std::memory_order_acquire); i >= 0; i--) { // 从跳表的最高层开始查找
+        // 遍历当前层级，直到下一个节点的键值大于要查找的键值
+        Node<K, V>* next = current->forward[i].load(std::memory_order_acquire);
+        while (next != nullptr && next->key_less(key, prefix)) {
+            // 移动到下一个节点
+            current = next;
+            next = current->forward[i].load(std::memory_order_acquire);
+        }
+        // 当前节点的下一个节点的键值大于待查找的键值时，进行下层操作
+    }
+    // 检查当前层（最底层）的下一个节点的键值是否为要查找的键值
+    current = current->forward[0].load(std::memory_order_acquire);
+    if (current != nullptr && current->key_equals(key, prefix)) { 
+        //std::cout << "Found key: " << key << ", value: " << current->getValue() << std::endl;
+        return current; // 找到了
+    }
+
+    //std::cout << " Not found key: " << key << std::endl;
+    return nullptr; // 没找到
+}
+
+/**
+ * 最后一个小于 key 的节点
+ * @param key 键
+ * @return Node<K, V>* 最后一个小于 key 的节点，没有时返回头节点；它在第 0 层的后继就是第一个不小于 key 的节点
+ * @note 调用者需处于纪元临界区
+ */
+template <typename K, typename V>
+Node<K, V>* SkipList<K, V>::find_less_than(const K& key) {
+    Node<K, V>* current = _header;
+    uint64_t prefix = KeyPrefix<K>::of(key);
+    for (int i = _skip_list_level.load(std::memory_order_acquire); i >= 0; i--) {
+        Node<K, V>* next = current->forward[i].load(std::memory_order_acquire);
+        while (next != nullptr && next->key_less(key, prefix)) {
+            current = next;
+            next = current->forward[i].load(std::memory_order_acquire);
+        }
+    }
+    return current;
+}
+
+/**
+ * 最后一个节点
+ * @return Node<K, V>* 最后一个节点，空表时返回头节点
+ * @note 调用者需处于纪元临界区；逐层走到末尾，期望 O(log n)
+ */
+template <typename K, typename V>
+Node<K, V>* SkipList<K, V>::find_last() {
+    Node<K, V>* current = _header;
+    for (int i = _skip_list_level.load(std::memory_order_acquire); i >= 0; i--) {
+        Node<K, V>* next = current->forward[i].load(std::memory_order_acquire);
+        while (next != nullptr) {
+            current = next;
+            next = current->forward[i].load(std::memory_order_acquire);
+        }
+    }
+    return current;
+}
+
+/**
+ * 范围读取
+ * @param start 起始键（包含）
+ * @param end 结束键（不包含）
+ * @param limit 最多读取的元素个数
+ * @return std::vector<std::pair<K, V>> 按键升序排列的键值对
+ * @description 与查找一样不加锁：定位到第一个不小于 start 的节点后沿第 0 层前进，一次定位读取整个范围。
+ *              扫描不是快照，期间并发插入、删除的键可能出现也可能不出现，但结果总是有序且不重复
+ */
+template <typename K, typename V>
+std::vector<std::pair<K, V>> SkipList<K, V>::scan(const K& start, const K& end, size_t limit) {
+    std::vector<std::pair<K, V>> result;
+    EpochReclaimer::Guard guard = _reclaimer.pin(); // 进入纪元临界区
+
+    Node<K, V>* node = find_less_than(start)->forward[0].load(std::memory_order_acquire);
+    while (node != nullptr && result.size() < limit && node->getKey() < end) {
+        result.emplace_back(node->getKey(), node->getValue());
+        snapshot_detach(result.back().first); // 键值离开跳表，不再引用映射区
+        snapshot_detach(result.back().second);
+        node = node->forward[0].load(std::memory_order_acquire);
+    }
+    return result;
+}
+
+/* ************************************************************************
+> 跳表的有序游标，由 SkipList::cursor() 创建
+> 用法与 LevelDB 的迭代器相同：先 seek / seek_for_prev / seek_to_first / seek_to_last 定位，
+  valid() 为真时读取 key() / value()，再 next() / prev() 移动
+> 游标保存当前元素的键值副本，不持有任何锁或纪元临界区，长时间存活也不会阻塞写线程和内存回收
+> 并发修改时保持有效：
+    > 定位时记下跳表的删除版本号。移动时版本号没变，说明当前节点仍在表中，直接沿 forward[0] 前进；
+      版本号变了（期间有删除），按保存的键重新定位，期望 O(log n)
+    > 插入不会使节点移动或失效，游标之后的新键在 next() 时能看到
+> 单向链表没有后继到前驱的指针，prev() 每次从头节点查找最后一个小于当前键的节点，期望 O(log n)
+ ************************************************************************/
+
+template <typename K, typename V>
+class SkipList<K, V>::Cursor {
+public:
+    explicit Cursor(SkipList<K, V>* list);
+
+    bool valid() const; // 是否指向一个元素
+    const K& key() const; // 当前元素的键，valid() 为真时才能调用
+    const V& value() const; // 当前元素的值，valid() 为真时才能调用
+
+    void seek(const K& key); // 定位到第一个不小于 key 的元素
+    void seek_for_prev(const K& key); // 定位到最后一个不大于 key 的元素
+    void seek_to_first(); // 定位到第一个元素
+    void seek_to_last(); // 定位到最后一个元素
+    void next(); // 移动到下一个元素
+    void prev(); // 移动到上一个元素
+
+private:
+    void settle(Node<K, V>* node, uint64_t version); // 停在 node 上，nullptr 或头节点表示无效
+
+    SkipList<K, V>* _list; // 所属的跳表
+    Node<K, V>* _node; // 当前节点，只在删除版本号没变时访问
+    uint64_t _version; // 定位时跳表的删除版本号
+    K _key; // 当前元素的键
+    V _value; // 当前元素的值
+    bool _valid; // 是否指向一个元素
+};
+
+template <typename K, typename V>
+SkipList<K, V>::Cursor::Cursor(SkipList<K, V>* list) : _list(list), _node(nullptr), _version(0), _key(), _value(), _valid(false) {}
+
+template <typename K, typename V>
+bool SkipList<K, V>::Cursor::valid() const {
+    return _valid;
+}
+
+template <typename K, typename V>
+const K& SkipList<K, V>::Cursor::key() const {
+    return _key;
+}
+
+template <typename K, typename V>
+const V& SkipList<K, V>::Cursor::value() const {
+    return _value;
+}
+
+/**
+ * 停在 node 上，复制它的键值
+ * @param node 节点，nullptr 或头节点表示游标无效
+ * @param version 找到 node 之前读取的删除版本号
+ * @note 调用者需处于纪元临界区
+ */
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::settle(Node<K, V>* node, uint64_t version) {
+    _valid = (node != nullptr && node != _list->_header);
+    _node = _valid ? node : nullptr;
+    _version = version;
+    if (_valid) {
+        _key = node->getKey();
+        _value = node->getValue();
+        snapshot_detach(_key); // 游标可能比映射活得久
+        snapshot_detach(_value);
+    }
+}
+
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::seek(const K& key) {
+    EpochReclaimer::Guard guard = _list->_reclaimer.pin();
+    uint64_t version = _list->_delete_version.load(); // 先读版本号再查找，期间的删除都会使版本号变化
+    settle(_list->find_less_than(key)->forward[0].load(std::memory_order_acquire), version);
+}
+
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::seek_for_prev(const K& key) {
+    EpochReclaimer::Guard guard = _list->_reclaimer.pin();
+    uint64_t version = _list->_delete_version.load();
+    Node<K, V>* prev = _list->find_less_than(key);
+    Node<K, V>* next = prev->forward[0].load(std::memory_order_acquire);
+    settle(next != nullptr && next->getKey() == key ? next : prev, version);
+}
+
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::seek_to_first() {
+    EpochReclaimer::Guard guard = _list->_reclaimer.pin();
+    uint64_t version = _list->_delete_version.load();
+    settle(_list->_header->forward[0].load(std::memory_order_acquire), version);
+}
+
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::seek_to_last() {
+    EpochReclaimer::Guard guard = _list->_reclaimer.pin();
+    uint64_t version = _list->_delete_version.load();
+    settle(_list->find_last(), version);
+}
+
+/**
+ * 移动到下一个元素
+ * @note 删除版本号没变时当前节点一定还在表中（也就没有被回收），直接取它的后继；
+ *       否则当前节点可能已被删除，按保存的键重新定位到第一个大于它的元素
+ */
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::next() {
+    if (!_valid) {
+        return;
+    }
+    EpochReclaimer::Guard guard = _list->_reclaimer.pin();
+    uint64_t version = _list->_delete_version.load();
+    Node<K, V>* node;
+    if (version == _version) {
+        node = _node->forward[0].load(std::memory_order_acquire);
+    } else {
+        node = _list->find_less_than(_key)->forward[0].load(std::memory_order_acquire);
+        if (node != nullptr && node->getKey() == _key) {
+            node = node->forward[0].load(std::memory_order_acquire);
+        }
+    }
+    settle(node, version);
+}
+
+template <typename K, typename V>
+void SkipList<K, V>::Cursor::prev() {
+    if (!_valid) {
+        return;
+    }
+    EpochReclaimer::Guard guard = _list->_reclaimer.pin();
+    uint64_t version = _list->_delete_version.load();
+    settle(_list->find_less_than(_key), version);
+}
+
+/**
+ * 创建游标
+ * @return Cursor 定位之前无效的游标，不能比跳表存活得更久
+ */
+template <typename K, typename V>
+typename SkipList<K, V>::Cursor SkipList<K, V>::cursor() {
+    return Cursor(this);
+}
+
+/**
+ * 删除跳表中的节点
+ * @param key 要删除的节点的键
+ * @return void 
+ * @description 删除元素的过程是：
+ *                  1. 定位待删除节点：通过搜索确定需要删除的节点位置；
+ *                  2. 更新指针关系：调整相关节点的指针，以从跳表中移除目标节点；
+ *                  3. 内存回收：释放被删除节点所占用的资源。
+ */
+template <typename K, typename V>
+void SkipList<K, V>::delete_element(const K& key) { 
+    _mtx.lock(); // 独占加锁
+    Node<K, V>* current = _header; // 从头节点开始
+
+    Node<K, V>* update[_max_level + 1]; // 用于记录每一层中待更新指针的节点
+    memset(update, 0, sizeof(Node<K, V>*) * (_max_level + 1)); // 初始化 update 数组
+
+    uint64_t prefix = KeyPrefix<K>::of(key);
+
+    // 从最大层级开始向下搜索待删除结点
+    for (int i = _skip_list_level; i >= 0; i--) { 
+        Node<K, V>* next = current->forward[i].load(std::memory_order_relaxed); // 写线程持有独占锁，无需同步
+        while (next != nullptr && next->key_less(key, prefix)) { 
+            current = next;
+            next = current->forward[i].load(std::memory_order_relaxed);
+        }
+        update[i] = current; // 记录每一层中待更新指针的节点
+    }
+
+    current = current->forward[0]; // 移动到底层的下一个节点
+    // 检查待删除节点的键是否存在
+    if (current != nullptr && current->key_equals(key, prefix)) { 
+        // 更新每一层的指针
+        for (int i = 0; i <= _skip_list_level; i++) { 
+            // 如果当前层的节点的下一个节点是待删除节点
+            if (update[i]->forward[i] == current) { 
+                // 将当前层的节点的下一个节点指向待删除节点的下一个节点
+                update[i]->forward[i].store(current->forward[i].load(std::memory_order_relaxed), std::memory_order_release);
+            } else { 
+                break; // 如果当前层的节点的下一个节点不是待删除节点，说明待删除节点不存在，直接退出
+            }
+        }
+
+        // 如果删除节点后，跳表的最高层没有节点了，降低跳表的层级
+        while (_skip_list_level > 0 && _header->forward[_skip_list_level] == nullptr) { 
+            _skip_list_level--;
+        }
+
+        //std::cout << "Element with key " << key << " deleted successfully." << std::endl;
+        _delete_version++; // 在交给回收器之前更新，游标看到旧版本号时该节点一定还没有被释放
+        // 可能仍有无锁的读者停留在该节点上，交给纪元回收器延迟释放
+        _reclaimer.retire(current, &SkipList<K, V>::free_node, this);
+        _element_count--; // 更新元素计数
+    }
+    _mtx.unlock(); // 解锁
+    return;
+}
+
+// 纪元回收器的回调：此时已没有读者持有该节点。回调总是在写锁内（或析构时）被调用，可以安全访问内存池
+template <typename K, typename V>
+void SkipList<K, V>::free_node(void* ctx, void* node) {
+    static_cast<SkipList<K, V>*>(ctx)->destroy_node(static_cast<Node<K, V>*>(node));
+}
+
+// Dump data in memory to file
+// 以二进制快照格式写入 STORE_FILE，格式见 snapshot.h
+template <typename K, typename V>
+void SkipList<K, V>::dump_file() { 
+    
+    std::cout << "Dumping data to file..." << std::endl;
+    _file_mtx.lock(); // 加锁
+    _mtx.lock_shared(); // 遍历期间禁止插入、删除，但不影响查找
+
+    SnapshotWriter writer;
+    if (writer.open(STORE_FILE, 0)) { // 打开文件，STORE_FILE是路径
+        Node<K, V>* current = this->_header->forward[0].load(std::memory_order_relaxed); // 从头节点开始遍历
+        while (current != nullptr) { 
+            writer.append(current->getKey(), current->getValue(), current->node_level); // 将节点的键值对写入文件
+            current = current->forward[0].load(std::memory_order_relaxed); // 移动到下一个节点
+        }
+    }
+
+    _mtx.unlock_shared(); // 解锁
+    writer.close(); // 写出剩余数据块并回填文件头
+    _file_mtx.unlock(); // 解锁
+    
+    return;
+}
+
+// 验证字符串的合法性
+template <typename K, typename V>
+bool SkipList<K, V>::is_valid_string(const std::string& str) { 
+    // 如果字符串str非空，并且字符串中包含分隔符delimiter，那么返回true
+    // find()函数返回字符串中第一个匹配的位置，如果没有找到匹配的位置，则返回std::string::npos
+    if (!str.empty()&& str.find(delimiter) != std::string::npos) { 
+        return true;
+    }
+
+    return false;
+}
+
+// 将字符串分割为键和值
+template <typename K, typename V>
+void SkipList<K, V>::get_key_value_from_string(const std::string& str, std::string* key, std::string* value) { 
+    
+    if (!is_valid_string(str)) { 
+        return;
+    }
+
+    *key = str.substr(0, str.find(delimiter)); // 获取键
+    *value = str.substr(str.find(delimiter) + 1); // 获取值
+
+    return;
+}
+
+// Load data from file to memory
+// 根据文件头的魔数自动识别格式：二进制快照，或旧版逐行的 key:value 文本
+template <typename K, typename V>
+void SkipList<K, V>::load_file() {
+    _file_mtx.lock(); // 加锁
+    std::cout << "Loading data from file..." << std::endl;
+
+    if (is_snapshot_file(STORE_FILE)) {
+        load_snapshot_file(STORE_FILE);
+    } else if constexpr (std::is_same<K, std::string>::value && std::is_same<V, std::string>::value) {
+        load_text_file(STORE_FILE); // 旧版文本格式只支持字符串键值
+    } else {
+        std::cerr << (std::ifstream(STORE_FILE).is_open() ? "Unsupported file format: " : "Failed to open file: ") << STORE_FILE << std::endl;
+    }
+
+    _file_mtx.unlock(); // 解锁
+
+    return;
+}
+
+// 读取二进制快照，逐块校验，遇到损坏的数据块时停止加载
+template <typename K, typename V>
+void SkipList<K, V>::load_snapshot_file(const std::string& path) {
+    SnapshotReader reader;
+    if (!reader.open(path)) {
+        return;
+    }
+
+    uint64_t loaded = load_records([&](auto consume) {
+        return snapshot_parallel_read<K, V>(reader, consume);
+    });
+
+    if (reader.corrupted()) {
+        std::cerr << "Snapshot partially loaded: " << loaded << "/" << reader.header().record_count << " records" << std::endl;
+    }
+}
+
+/**
+ * 通过 mmap 加载二进制快照
+ * @param path 快照文件路径
+ * @return void
+ * @description K、V 为 SnapshotString 时键值直接引用映射区，不做任何复制；
+ *              映射一直保留到跳表析构或 clear()，期间文件被新的快照替换也不受影响（快照总是 rename 生成）；
+ *              scan、游标、multi_get 返回的键值复制为拥有状态，在映射解除之后依然有效
+ */
+template <typename K, typename V>
+void SkipList<K, V>::load_mapped_file(const std::string& path) {
+    _file_mtx.lock(); // 加锁
+    std::cout << "Mapping data from file..." << std::endl;
+
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if (file->open(path)) {
+        bool corrupted = false;
+        uint64_t loaded = load_records([&](auto consume) {
+            return snapshot_for_each_mapped<K, V>(*file, consume, corrupted);
+        });
+        if (corrupted) {
+            std::cerr << "Snapshot partially loaded: " << loaded << " records" << std::endl;
+        }
+
+        _mtx.lock();
+        _mappings.push_back(file); // 节点可能引用映射区，映射的生命周期与跳表一致
+        _mtx.unlock();
+    }
+
+    _file_mtx.unlock(); // 解锁
+}
+
+/**
+ * 把一个有序的记录流加载进跳表
+ * @param for_each 形如 for_each(consume) 的函数，按顺序对每条记录调用 consume，返回记录数
+ * @return uint64_t 记录数
+ * @description 跳表为空时走批量构建：快照按 forward[0] 顺序写出，键天然有序，不需要逐个查找插入位置；
+ *              遇到乱序的键或跳表非空时，退回逐个 insert_element
+ */
+template <typename K, typename V>
+template <typename ForEach>
+uint64_t SkipList<K, V>::load_records(ForEach for_each) {
+    _mtx.lock(); // 批量构建期间独占加锁
+    bool bulk = (_header->forward[0].load(std::memory_order_relaxed) == nullptr);
+    if (!bulk) {
+        _mtx.unlock();
+    }
+
+    Node<K, V>* tails[_max_level + 1]; // 每一层当前的最后一个节点
+    for (int i = 0; i <= _max_level; i++) {
+        tails[i] = _header;
+    }
+    uint64_t seq = 0;
+
+    uint64_t loaded = for_each([&](SnapshotRecord<K, V>& record) {
+        if (bulk && bulk_append(tails, seq, record.key, record.value)) {
+            return;
+        }
+        if (bulk) { // 遇到乱序的键，剩下的记录退回逐个插入
+            bulk = false;
+            _mtx.unlock();
+        }
+        insert_element(record.key, record.value); // 将键值对插入跳表
+    });
+
+    if (bulk) {
+        _mtx.unlock();
+    }
+    return loaded;
+}
+
+/**
+ * 批量构建：在末尾追加一个节点
+ * @param tails 每一层当前的最后一个节点，初始均为头节点
+ * @param seq 已追加的节点数
+ * @return bool 键不大于上一个键时返回 false，此时不做任何修改
+ * @description p = 1/2 时第 seq 个节点的层数取 seq 二进制末尾 0 的个数，即每 2^i 个节点出现一个第 i 层节点，
+ *              与随机层数期望一致，但分布完全均匀（其他 p 见 LevelGenerator::sequence_level）；调用者需持有写锁
+ */
+template <typename K, typename V>
+bool SkipList<K, V>::bulk_append(Node<K, V>** tails, uint64_t& seq, const K& key, const V& value) {
+    if (tails[0] != _header && !(tails[0]->getKey() < key)) {
+        return false;
+    }
+
+    int level = _level_generator.sequence_level(++seq);
+    if (level > _max_level) {
+        level = _max_level;
+    }
+
+    Node<K, V>* node = create_node(key, value, level);
+    for (int i = 0; i <= level; i++) {
+        node->forward[i].store(nullptr, std::memory_order_relaxed);
+        tails[i]->forward[i].store(node, std::memory_order_release); // 自底向上发布，与 insert_element 一致
+        tails[i] = node;
+    }
+    if (level > _skip_list_level) {
+        _skip_list_level = level;
+    }
+    _element_count++;
+    return true;
+}
+
+/**
+ * 从有序数组批量构建跳表
+ * @param elements 按键升序排列的键值对
+ * @return int 成功插入的元素个数
+ * @description 跳表为空时线性构建，O(n)；跳表非空或遇到乱序、重复的键时，对剩余元素退回 insert_element
+ */
+template <typename K, typename V>
+int SkipList<K, V>::bulk_load(const std::vector<std::pair<K, V>>& elements) {
+    int before = size();
+    size_t i = 0;
+
+    _mtx.lock(); // 独占加锁
+    if (_header->forward[0].load(std::memory_order_relaxed) == nullptr) {
+        Node<K, V>* tails[_max_level + 1];
+        for (int l = 0; l <= _max_level; l++) {
+            tails[l] = _header;
+        }
+        uint64_t seq = 0;
+        while (i < elements.size() && bulk_append(tails, seq, elements[i].first, elements[i].second)) {
+            i++;
+        }
+    }
+    _mtx.unlock();
+
+    for (; i < elements.size(); i++) {
+        insert_element(elements[i].first, elements[i].second);
+    }
+    return size() - before;
+}
+
+/**
+ * 查找 key 在每一层的前驱
+ * @param key 键，不小于上一次调用的键
+ * @param update 输入为上一个键在每层的前驱（首次调用时全部为头节点），输出为 key 在每层的前驱
+ * @description 按键升序处理一批键时，上一个键的前驱也小于当前键，可以从它继续查找（finger search）：
+ *              1. 从第 0 层向上，找到第一层前驱的后继不小于 key 的层 level，key 一定落在这一层的前驱和它的后继之间；
+ *              2. 从 level 层的前驱向下查找，更高层的前驱保持不变。
+ *              相邻两个键之间隔着 d 个节点时只需访问 O(log d) 层，而不是从头节点的最高层开始。
+ *              调用者需持有写锁或处于纪元临界区
+ */
+template <typename K, typename V>
+void SkipList<K, V>::find_predecessors(const K& key, Node<K, V>** update) {
+    int top = _skip_list_level.load(std::memory_order_acquire);
+    uint64_t prefix = KeyPrefix<K>::of(key);
+    int level = 0;
+    while (level < top) {
+        Node<K, V>* next = update[level]->forward[level].load(std::memory_order_acquire);
+        if (next == nullptr || !next->key_less(key, prefix)) {
+            break;
+        }
+        level++;
+    }
+
+    Node<K, V>* current = update[level];
+    for (int i = level; i >= 0; i--) {
+        // 上一个键在本层的前驱比从上层下来的节点更靠后时，从它继续（两者的键都小于 key）
+        if (update[i] != _header && (current == _header || current->getKey() < update[i]->getKey())) {
+            current = update[i];
+        }
+        Node<K, V>* next = current->forward[i].load(std::memory_order_acquire);
+        while (next != nullptr && next->key_less(key, prefix)) {
+            current = next;
+            next = current->forward[i].load(std::memory_order_acquire);
+        }
+        update[i] = current;
+    }
+}
+
+/**
+ * 批量查找
+ * @param keys 要查找的键，顺序任意，可以重复
+ * @return std::vector<std::optional<V>> 与 keys 一一对应，找到时为值的副本
+ * @description 先按键排序，再在一个纪元临界区内依次查找，每个键从上一个键的前驱继续（find_predecessors）。
+ *              与查找一样不加锁；并发删除的节点在临界区内不会被释放，从它继续查找仍然安全
+ */
+template <typename K, typename V>
+std::vector<std::optional<V>> SkipList<K, V>::multi_get(const std::vector<K>& keys) {
+    std::vector<std::optional<V>> result(keys.size());
+
+    std::vector<size_t> order(keys.size()); // 按键排序后的下标
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+    Node<K, V>* update[_max_level + 1]; // 上一个键在每层的前驱
+    for (int i = 0; i <= _max_level; i++) {
+        update[i] = _header;
+    }
+
+    EpochReclaimer::Guard guard = _reclaimer.pin(); // 进入纪元临界区
+    for (size_t index : order) {
+        const K& key = keys[index];
+        find_predecessors(key, update);
+        Node<K, V>* node = update[0]->forward[0].load(std::memory_order_acquire);
+        if (node != nullptr && node->key_equals(key, KeyPrefix<K>::of(key))) {
+            result[index] = node->getValue();
+            snapshot_detach(*result[index]);
+        }
+    }
+    return result;
+}
+
+/**
+ * 批量判断是否存在
+ * @param keys 要查找的键，顺序任意，可以重复
+ * @return std::vector<bool> 与 keys 一一对应
+ * @description 单个查找每前进一步都要等上一个节点从内存读进来，跳表远大于末级缓存时几乎全部时间花在等待上。
+ *              这里同时进行 SEARCH_BATCH_WIDTH 个互不相关的查找（手写的状态机，类似 AMAC）：
+ *                  1. 每个查找记录当前节点、所在层和下一个要比较的节点 next，next 在上一步已经预取；
+ *                  2. 轮流推进每个查找一步：比较 next 的键，前进或下降一层后读出新的 next（在已到达的节点中，
+ *                     不会缺失），对它发出 __builtin_prefetch，然后切换到下一个查找；
+ *                  3. 轮到这个查找时 next 大多已经在缓存中，多个查找的访存延迟互相重叠；
+ *                  4. 一个查找到达第 0 层后记录结果，空出的位置接着开始下一个键。
+ *              与 search_element 一样不加锁，整批在一个纪元临界区内完成。
+ *              与 multi_get 不同，不需要排序，适合在整个键空间中随机分布的键
+ */
+template <typename K, typename V>
+std::vector<bool> SkipList<K, V>::multi_search(const std::vector<K>& keys) {
+    struct Lookup {
+        Node<K, V>* current; // 已到达的节点
+        Node<K, V>* next; // 下一个要比较的节点，已预取
+        int level; // 所在层
+        size_t index; // 键的下标
+        uint64_t prefix; // 键的前缀
+    };
+
+    std::vector<bool> result(keys.size(), false);
+    Lookup lookups[SEARCH_BATCH_WIDTH];
+    size_t issued = 0; // 已开始的查找个数
+    int active = 0; // 进行中的查找个数
+
+    EpochReclaimer::Guard guard = _reclaimer.pin(); // 进入纪元临界区
+    int top = _skip_list_level.load(std::memory_order_acquire);
+    Node<K, V>* first = _header->forward[top].load(std::memory_order_acquire); // 头节点在缓存中，每个查找的起点相同
+    for (; active < SEARCH_BATCH_WIDTH && issued < keys.size(); active++, issued++) {
+        lookups[active] = {_header, first, top, issued, KeyPrefix<K>::of(keys[issued])};
+    }
+    if (first != nullptr) {
+        __builtin_prefetch(first);
+    }
+
+    while (active > 0) {
+        for (int slot = 0; slot < active;) {
+            Lookup& lookup = lookups[slot];
+            const K& key = keys[lookup.index];
+            if (lookup.next != nullptr && lookup.next->key_less(key, lookup.prefix)) {
+                lookup.current = lookup.next; // 在当前层前进
+            } else if (lookup.level > 0) {
+                lookup.level--; // 下降一层
+            } else { // 第 0 层的 next 是第一个不小于 key 的节点
+                result[lookup.index] = lookup.next != nullptr && lookup.next->key_equals(key, lookup.prefix);
+                if (issued < keys.size()) {
+                    lookup = {_header, first, top, issued, KeyPrefix<K>::of(keys[issued])};
+                    issued++;
+                } else {
+                    lookup = lookups[--active]; // 用最后一个查找填补空位
+                }
+                continue;
+            }
+            lookup.next = lookup.current->forward[lookup.level].load(std::memory_order_acquire);
+            if (lookup.next != nullptr) {
+                __builtin_prefetch(lookup.next); // 节点对象和紧随其后的 forward 数组
+            }
+            slot++;
+        }
+    }
+    return result;
+}
+
+/**
+ * 批量插入
+ * @param elements 要插入的键值对，顺序任意；已存在的键不覆盖，批内重复的键只插入第一个
+ * @return int 成功插入的元素个数
+ * @description 先按键排序，再加一次写锁依次插入。每个键从上一个键的前驱继续查找（find_predecessors），
+ *              update 仍然指向新节点的前驱，下一个键从那里继续，批内重复的键会找到刚插入的节点
+ */
+template <typename K, typename V>
+int SkipList<K, V>::multi_put(const std::vector<std::pair<K, V>>& elements) {
+    std::vector<size_t> order(elements.size()); // 按键排序后的下标，键相同时保持原有顺序
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&elements](size_t a, size_t b) {
+        return elements[a].first < elements[b].first;
+    });
+
+    int inserted = 0;
+    _mtx.lock(); // 独占加锁，整批只加一次
+
+    Node<K, V>* update[_max_level + 1]; // 上一个键在每层的前驱
+    for (int i = 0; i <= _max_level; i++) {
+        update[i] = _header;
+    }
+
+    for (size_t index : order) {
+        const K& key = elements[index].first;
+        find_predecessors(key, update);
+        Node<K, V>* current = update[0]->forward[0].load(std::memory_order_relaxed);
+        if (current != nullptr && current->key_equals(key, KeyPrefix<K>::of(key))) {
+            continue; // 元素已存在
+        }
+
+        int random_level = get_random_level();
+        if (random_level > _skip_list_level) { // 更高的层中前驱都是头节点，update 中已经是头节点
+            _skip_list_level = random_level;
+        }
+
+        Node<K, V>* inserted_node = create_node(key, elements[index].second, random_level);
+        for (int i = 0; i <= random_level; i++) {
+            inserted_node->forward[i].store(update[i]->forward[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            update[i]->forward[i].store(inserted_node, std::memory_order_release);
+        }
+        _element_count++;
+        inserted++;
+    }
+
+    _mtx.unlock();
+    return inserted;
+}
+
+// 读取旧版文本格式
+template <typename K, typename V>
+void SkipList<K, V>::load_text_file(const std::string& path) {
+    _file_reader.open(path); // 打开文件
+
+    std::string line; // 用于存储文件中的每一行数据
+    K* key = new K(); // 用于存储键
+    V* value = new V(); // 用于存储值
+
+    while (getline(_file_reader, line)) { // 逐行读取文件
+        get_key_value_from_string(line, key, value); // 将每一行数据分割为键和值
+        if (key->empty() || value->empty()) { // 如果键或值为空，跳过
+            continue;
+        }
+
+        insert_element(*key, *value); // 将键值对插入跳表
+        std::cout << "key: " << *key << ", " << "value: " << *value << std::endl;
+    }
+
+    delete key; // 释放内存
+    delete value; // 释放内存
+    
+    _file_reader.close(); // 关闭文件
+}
+
+// 返回跳表的元素个数
+template <typename K, typename V>
+int SkipList<K, V>::size() {
+    return _element_count.load(std::memory_order_relaxed);
+}
+
+// 返回节点占用的内存（按内存池的整块计算），用于比较不同晋升概率的空间开销
+template <typename K, typename V>
+size_t SkipList<K, V>::memory_usage() {
+    _mtx.lock_shared(); // 内存池只在写锁内修改
+    size_t bytes = _arena.bytes_reserved();
+    _mtx.unlock_shared();
+    return bytes;
+}
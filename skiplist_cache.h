@@ -1,670 +1,1815 @@
-#include "skiplist.h"
-#include "LRU.h"
-#include <chrono>
-#include <thread>
-#include <mutex>
-#include <atomic>
-
-#define DEFAULT_TTL 3600 // 默认过期时间
-#define PERMANENT_TTL -1 // 永久过期时间
-#define DEFAULT_STORE_FILE "store/dumpFile_cache" // 数据持久化文件
-
-std::atomic<bool> keep_running{true}; // 周期性数据持久化策略
-std::atomic<bool> running_cleanup(false); // 用于控制清理线程是否运行
-
-std::mutex FILE_IO_MUTEX; // 文件IO互斥锁
-
-// 带过期时间的跳表节点
-template <typename K, typename V>
-class NodeWithTTL{
-public:
-    using TimePoint = std::chrono::steady_clock::time_point;
-
-    NodeWithTTL() {} // 默认构造函数
-    NodeWithTTL(K k, V v, int, TimePoint t); // 构造函数
-    ~NodeWithTTL(); // 析构函数
-
-    K getKey() const; // 获取键
-    V getValue() const; // 获取值
-
-    void setValue(V); // 设置值
-    void setExpireTime(TimePoint t); // 设置过期时间
-    TimePoint getExpireTime() const; // 获取过期时间
-    int getRemainingTime() const; // 获取剩余时间
-    NodeWithTTL<K, V>** forward; 
-    int node_level; // 节点层级
-
-private:
-    K key; // 键
-    V value; // 值
-    TimePoint expiration_time; // 过期时间
-};
-
-/*
- * 构造函数
- * @param key 键
- * @param value 值
- * @param level 节点层级
- * @param expiration_time 过期时间
- * @return
- */
-template <typename K, typename V>
-NodeWithTTL<K, V>::NodeWithTTL(K key, V value, int level, TimePoint expiration_time) { 
-    this->key = key;
-    this->value = value;
-    this->node_level = level;
-    this->expiration_time = expiration_time;
-    this->forward = new NodeWithTTL<K, V>*[level + 1];
-    memset(forward, 0, sizeof(NodeWithTTL<K, V>*) * (level + 1));
-};
-
-/*
- * 析构函数
- * @return
- */
-template <typename K, typename V>
-NodeWithTTL<K, V>::~NodeWithTTL() {
-    delete[] forward;
-};
-
-/*
- * 获取过期时间
- * @return 过期时间
- */
-template <typename K, typename V>
-typename NodeWithTTL<K, V>::TimePoint NodeWithTTL<K, V>::getExpireTime() const {
-    return expiration_time;
-};
-
-/*
- * 设置过期时间
- * @param t 过期时间
- * @return
- */
-template <typename K, typename V>
-void NodeWithTTL<K, V>::setExpireTime(TimePoint expiration_time) {
-    this->expiration_time = expiration_time;
-};
-
-/*
- * 获取剩余时间
- * @return 剩余时间
- */
-template <typename K, typename V>
-int NodeWithTTL<K, V>::getRemainingTime() const {
-    return std::chrono::duration_cast<std::chrono::seconds>(expiration_time - std::chrono::steady_clock::now()).count();
-}
-
-/*
- * 获取键
- * @return 键
- */
-template <typename K, typename V>
-K NodeWithTTL<K, V>::getKey() const {
-    return key;
-};
-
-/*
- * 获取值
- * @return 值
- */
-template <typename K, typename V>
-V NodeWithTTL<K, V>::getValue() const {
-    return value;
-};
-
-/*
- * 设置值
- * @param value 值
- * @return
- */
-template <typename K, typename V>
-void NodeWithTTL<K, V>::setValue(V value) {
-    this->value = value;
-};
-
-template <typename K, typename V>
-class SkipListWithCache{ 
-public: 
-    // 构造函数
-    SkipListWithCache(int, size_t);
-    
-    ~SkipListWithCache(); // 析构函数
-    
-    int get_random_level(); // 获取随机层级
-    int insert_element(const K& key, const V& value, int ttl_seconds); // 插入数据
-    NodeWithTTL<K, V>* create_node(const K& key, const V& value, int level, int ttl_seconds);
-    bool search_element(const K& key); // 查找数据
-    void delete_element(const K& key); // 删除数据
-    bool is_expired(const typename NodeWithTTL<K, V>::TimePoint& expiration_time) const; // 是否过期
-    void remove_cache_expired(); // 定期删除缓存数据
-    void remove_skiplist_expired(); // 定期删除跳表数据
-    void dump_file(); // 数据持久化
-    void load_file(); // 数据加载
-    void display_skiplist(); // 打印跳表
-    void display_cache(); // 打印缓存
-    void periodic_save(int t); // 周期性数据持久化策略
-    void stop_periodic_save(); // 停止周期性数据持久化策略
-    void periodic_cleanup(int t); // 周期性删除过期数据
-    void stop_periodic_cleanup(); // 停止周期性删除过期数据
-    void clear(NodeWithTTL<K, V>* node); // 递归删除跳表节点
-    int size(); // 获取元素个数
-
-private:
-    void get_key_value_from_string(const std::string& line, std::string* key, std::string* value, std::string* expiration_time); // 从字符串中获取键值对
-    bool is_valid_string(const std::string& str); // 是否为有效字符串
-
-    int _max_level; // 最大层级
-    int _skip_list_level; // 跳表层级
-    NodeWithTTL<K, V>* _header; // 头节点
-
-    // file operation
-    std::ofstream _file_writer; // 文件写入
-    std::ifstream _file_reader; // 文件读取
-
-    // skiplist current element count
-    int _element_count; // 元素个数
-
-    LRUCache<K, V> cache; // 缓存
-};
-
-/*
- * 构造函数
- * @param max_level 最大层级
- * @return
- */
-template <typename K, typename V>
-SkipListWithCache<K, V>::SkipListWithCache(int max_level, size_t cache_capacity) 
-    : _max_level(max_level), _skip_list_level(0), _element_count(0), cache(cache_capacity) {
-    this->_skip_list_level = 0;
-    this->_element_count = 0;
-    this->cache = LRUCache<K, V>(cache_capacity); // 创建缓存
-    
-    // 创建头节点
-    K k{};
-    V v{};
-    this->_header = create_node(k, v, max_level, PERMANENT_TTL); // 创建头节点
-};
-
-/*
- * 析构函数
- * @return
- */
-template <typename K, typename V>
-SkipListWithCache<K, V>::~SkipListWithCache() {
-    
-    if (_file_reader.is_open()) {
-        _file_reader.close();
-    }
-    if (_file_writer.is_open()) {
-        _file_writer.close();
-    }
-
-    stop_periodic_cleanup(); // 停止周期性删除过期数据 
-    stop_periodic_save(); // 停止周期性数据持久化策略
-
-    // 递归删除跳表节点
-    if(_header->forward[0] != nullptr) {
-        clear(_header->forward[0]);
-    }
-
-    delete[] _header->forward;
-    
-    delete(_header);
-    delete(cache);
-};
-
-/*
- * 获取随机层级
- * @return 随机层级
- */
-template <typename K, typename V>
-int SkipListWithCache<K, V>::get_random_level() {
-    int k = 1;
-    while (rand() % 2) {
-        k++;
-    }
-    k = (k < _max_level) ? k : _max_level;
-    return k;
-};
-
-/*
- * 递归删除跳表节点
- * @param node 节点
- * @return
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::clear(NodeWithTTL<K, V>* current) {
-    if (current->forward[0] != nullptr) {
-        clear(current->forward[0]);
-    }
-    delete current;
-};
-
-/*
- * 创建节点
- * @param key 键
- * @param value 值
- * @param level 层级
- * @param ttl_seconds 过期时间
- * @return 节点
- */
-template <typename K, typename V>
-NodeWithTTL<K, V>* SkipListWithCache<K, V>::create_node(const K& key, const V& value, int level, int ttl_seconds) { 
-    typename NodeWithTTL<K, V>::TimePoint expiration_time;
-    // 如果过期时间为永久
-    if (ttl_seconds ==  PERMANENT_TTL) {
-        // 过期时间为最大时间
-        expiration_time = std::chrono::steady_clock::time_point::max();
-    } else {
-        // 过期时间为当前时间加上过期时间
-        expiration_time = std::chrono::steady_clock::now() + std::chrono::seconds(ttl_seconds);
-    }
-    NodeWithTTL<K, V>* n = new NodeWithTTL<K, V>(key, value, level, expiration_time);
-    return n;
-}
-
-/*
- * 插入元素，同时插入缓存
- * @param key 键
- * @param value 值
- * @param ttl_seconds 过期时间
- * @return void
- * @remark 插入数据到跳表和缓存，并设置过期时间
- */
-template <typename K, typename V>
-int SkipListWithCache<K, V>::insert_element(const K& key, const V& value, int ttl_seconds) {
-    
-    mtx.lock(); // 加锁
-
-    NodeWithTTL<K, V>* current = this->_header; // 当前节点
-    NodeWithTTL<K, V>* update[_max_level + 1]; // 更新节点
-    memset(update, 0, sizeof(NodeWithTTL<K, V>*) * (_max_level + 1)); // 初始化更新节点
-
-    // start from highest level of skip list
-    for (int i = _skip_list_level; i >= 0; i--) { 
-        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
-            current = current->forward[i];
-        }
-        update[i] = current;
-    }
-    current = current->forward[0];
-
-    if (current != nullptr && current->getKey() == key) {
-        //std::cout << "key: " << key << ", exists" << std::endl;
-        mtx.unlock(); // 解锁
-        return 1; // 已存在
-    }
-
-    if (current == nullptr || current->getKey() != key) { 
-        int random_level = get_random_level(); // 随机层级
-
-        if (random_level > _skip_list_level) { // 如果随机层级大于当前层级
-            for (int i = _skip_list_level + 1; i < random_level + 1; i++) {
-                update[i] = _header; // 更新节点
-            }
-            _skip_list_level = random_level;
-        }
-
-        NodeWithTTL<K, V>* inserted_node = create_node(key, value, random_level, ttl_seconds); // 创建节点
-
-        for (int i = 0; i <= random_level; i++) {
-            inserted_node->forward[i] = update[i]->forward[i];
-            update[i]->forward[i] = inserted_node;
-        }
-
-        //std::cout << "Successfully inserted key: " << key << ", value: " << value << ", level: " << random_level << ", ttl: " << ttl_seconds << std::endl;
-        _element_count++; // 元素个数加1
-    }
-
-    mtx.unlock(); // 解锁
-    cache.put(key, value, ttl_seconds); // 插入数据到缓存
-
-    return 0; // 插入成功
-};
-
-
-/*
- * 查找元素，先从缓存中查找，如果缓存中没有，再从跳表中获取
- * @param key 键
- * @param value 值
- * @return bool
- * @remark 从缓存中获取数据，如果缓存中没有，再从跳表中获取，在跳表中查询时，惰性删除
- */
-template <typename K, typename V>
-bool SkipListWithCache<K, V>::search_element(const K& key) {
-
-    std::cout << "search_element-----------------" << std::endl;
-    NodeWithTTL<K, V>* current = this->_header; // 当前节点
-
-    V value;
-
-    // 从缓存中获取数据
-    if (cache.get(key, value)) { 
-        std::cout << "Found key: " << key << ", value: " << value << " from cache" << std::endl;
-        return true; // 缓存中存在
-    }
-
-    // 从跳表中获取数据
-    for (int i = _skip_list_level; i >= 0; i--) { 
-        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
-            current = current->forward[i];
-        }
-    }
-    current = current->forward[0];
-    if (current != nullptr && current->getKey() == key) { 
-        // 如果节点过期，删除节点
-        if (is_expired(current->getExpireTime())) {
-            std::cout << "Found key: " << key << ", value: " << current->getValue() << " from skip list, but expired" << std::endl;
-            delete_element(key);
-            return false;
-        }
-        std::cout << "Found key: " << key << ", value: " << current->getValue() << " from skip list" << std::endl;
-        return true;
-    }
-    
-    std::cout << "Not found key: " << key << std::endl;
-    return false; // 未找到
-};
-
-/*
- * 删除过期缓存数据
- * @return void
- * @remark 删除过期缓存数据
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::remove_cache_expired() {
-    cache.remove_expired();
-};
-
-/*
- * 判断节点是否过期
- * @param expiration_time 过期时间
- * @return bool
- * @remark 判断节点是否过期
- */
-template <typename K, typename V>
-bool SkipListWithCache<K, V>::is_expired(const typename NodeWithTTL<K, V>::TimePoint& expiration_time) const {
-    return expiration_time < std::chrono::steady_clock::now();
-};
-
-/*
- * 删除过期跳表数据
- * @return void
- * @remark 删除过期跳表数据
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::remove_skiplist_expired() {
-    NodeWithTTL<K, V>* current = this->_header;
-
-    while (current->forward[0] != nullptr) { 
-        if (is_expired(current->forward[0]->getExpireTime())) {
-            NodeWithTTL<K, V>* expired_node = current->forward[0];
-            // 删除节点
-            delete_element(expired_node->getKey());
-        } else {
-            current = current->forward[0]; // 下一个节点
-        }
-    }
-};
-
-
-/*
- * 删除元素
- * @param key 键
- * @return void
- * @remark 删除元素
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::delete_element(const K& key) { 
-    std::cout << "delete_element-----------------" << std::endl;
-    mtx.lock(); // 加锁
-
-    NodeWithTTL<K, V>* current = this->_header; // 当前节点
-    NodeWithTTL<K, V>* update[_max_level + 1]; // 更新节点
-    memset(update, 0, sizeof(NodeWithTTL<K, V>*) * (_max_level + 1));
-
-    for (int i = _skip_list_level; i >= 0; i--) { 
-        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
-            current = current->forward[i];
-        }
-        update[i] = current;
-    }
-    current = current->forward[0];
-
-    if (current != nullptr && current->getKey() == key) { 
-        for (int i = 0; i <= _skip_list_level; i++) { 
-            if (update[i]->forward[i] != current) {
-                break;
-            }
-            update[i]->forward[i] = current->forward[i];
-        }
-
-        while (_skip_list_level > 0 && _header->forward[_skip_list_level] == nullptr) {
-            _skip_list_level--;
-        }
-
-        std::cout << "Successfully deleted key: " << key << std::endl;
-        _element_count--; // 元素个数减1
-    }
-
-    mtx.unlock(); // 解锁
-    cache.remove(key);// 删除缓存中的数据
-};
-
-/*
- * 数据持久化
- * @return void
- * @remark 数据持久化
- * 惰性删除策略2：周期性存盘的过程中，将对跳表中的过期数据进行删除
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::dump_file() {
-    // 获取当前时间并格式化 "yyyyMMddHHmmss" 格式
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now); // 转换为time_t
-    std::tm* now_tm = std::localtime(&now_c); // 转换为tm
-
-    char time_str[20]; // 用于保存格式化后的时间字符串
-    std::strftime(time_str, sizeof(time_str), "%Y%m%d%H%M%S", now_tm); // 格式化时间字符串
-
-    // 创建包含时间戳的文件名
-    std::string filename = "store/dumpFile_cache_" + std::string(time_str);
-    
-    std::cout << "dump_file-----------------" << std::endl;
-    FILE_IO_MUTEX.lock(); // 加锁
-    _file_writer.open(filename); // 打开文件
-
-    // 如果文件打开失败
-    if (!_file_writer.is_open()) { 
-        std::cerr << "Failed to open file: " << filename << std::endl;
-        FILE_IO_MUTEX.unlock(); // 解锁
-        return;
-    }
-
-    NodeWithTTL<K, V>* node = this->_header->forward[0]; // 当前节点
-
-    while (node != nullptr) { 
-        if (!is_expired(node->getExpireTime())) {
-            _file_writer << node->getKey() << ":" << node->getValue() << ":" << node->getRemainingTime() << "\n";
-            std::cout << node->getKey() << ":" << node->getValue() << ":" << node->getRemainingTime() << ";\n";
-        }
-        node = node->forward[0];
-    }
-
-    _file_writer.flush(); // 刷新文件
-    _file_writer.close(); // 关闭文件
-
-    FILE_IO_MUTEX.unlock(); // 解锁
-    return;
-}
-
-/*
- * 从文件中加载数据
- * @return void
- * @remark 从文件中加载数据
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::load_file() { 
-
-    FILE_IO_MUTEX.lock(); // 加锁
-    std::cout << "Loading data from file..." << std::endl;
-    _file_reader.open(DEFAULT_STORE_FILE); // 打开文件
-
-    if (!_file_reader.is_open()) { 
-        std::cerr << "Failed to open file: " << DEFAULT_STORE_FILE << std::endl;
-        FILE_IO_MUTEX.unlock(); // 解锁
-        return;
-    }
-
-    std::string line; // 行数据
-    K* key = new K(); // 键
-    V* value = new V(); // 值
-    std::string* expiration_time = new std::string(); // 剩余时间 
-
-    while (getline(_file_reader, line)) { 
-        get_key_value_from_string(line, key, value, expiration_time); // 从字符串中获取键值对
-        if (key->empty() || value->empty() || expiration_time->empty()) {
-            continue;
-        }
-
-        insert_element(*key, *value, stoi(*expiration_time)); // 插入元素
-        std::cout << "key: " << *key << ", " << "value: " << *value << ", " << "expiration_time: " << *expiration_time << std::endl;
-    } 
-
-    delete key; // 删除键
-    delete value; // 删除值
-    delete expiration_time; // 删除剩余时间
-
-    _file_reader.close(); // 关闭文件
-    FILE_IO_MUTEX.unlock(); // 解锁
-
-    return;
-}
-
-/*
- * 验证字符串的合法性
- * @param str 字符串
- * @return bool
- * @remark 验证字符串的合法性
- */
-template <typename K, typename V>
-bool SkipListWithCache<K, V>::is_valid_string(const std::string& str) { 
-    // 如果字符串str非空，并且字符串中包含分隔符delimiter，那么返回true
-    // find()函数返回字符串中第一个匹配的位置，如果没有找到匹配的位置，则返回std::string::npos
-    if (!str.empty()&& str.find(delimiter) != std::string::npos) { 
-        return true;
-    }
-
-    return false;
-}
-
-/*
- * 从字符串中获取键值对
- * @param line 字符串
- * @param key 键
- * @param value 值
- * @param expiration_time 剩余时间
- * @return void
- * @remark 从字符串中获取键值对
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::get_key_value_from_string(const std::string& str, std::string* key, std::string* value, std::string* expiration_time) { 
-    
-    if (!is_valid_string(str)) { 
-        return;
-    }
-    
-    size_t pos1 = str.find(delimiter); // 查找第一个分隔符的位置
-    size_t pos2 = str.find(delimiter, pos1 + 1); // 查找第二个分隔符的位置
-
-
-    *key = str.substr(0, pos1); // 获取键
-    *value = str.substr(pos1 + 1, pos2 - pos1 - 1); // 获取值
-    *expiration_time = str.substr(pos2 + 1); // 获取剩余时间
-
-    return;
-}
-
-/*
- * 打印跳表
- * @return void
- * @remark 打印跳表
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::display_skiplist() {
-    
-    std::cout << "\n*****Skip List*****"<<"\n"; 
-    for (int i = 0; i <= _skip_list_level; i++) {
-        NodeWithTTL<K, V> *node = this->_header->forward[i]; 
-        std::cout << "Level " << i << ": ";
-        while (node != NULL) {
-            std::cout << node->getKey() << ":" << node->getValue() << ";";
-            node = node->forward[i];
-        }
-        std::cout << std::endl;
-    }
-}
-
-/*
- * 打印缓存
- * @return void
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::display_cache() {
-    cache.display();
-}
-
-/*
- * 周期性数据持久化策略
- * @param kv_store kv存储
- * @return void
- * @remark 周期性数据持久化策略
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::periodic_save(int interval_seconds) {
-    // 启动后台线程
-    std::thread([this, interval_seconds]() {
-        while (keep_running) { 
-            std::this_thread::sleep_for(std::chrono::seconds(interval_seconds)); // 每隔interval_seconds秒执行一次
-            dump_file(); // 数据持久化
-        }
-    }).detach();
-};
-
-/*
- * 停止周期性数据持久化策略
- * @return void
- * @remark 停止周期性数据持久化策略
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::stop_periodic_save() {
-    keep_running = false; // 停止后台线程
-};
-
-/*
- * 周期性删除过期数据
- * @param kv_store kv存储
- * @return void
- * @remark 周期性删除过期数据
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::periodic_cleanup(int interval_seconds) {
-    running_cleanup = true; // 运行清理
-    std::thread([this, interval_seconds]() {
-        while (running_cleanup) { 
-            remove_skiplist_expired(); // 删除过期数据
-            std::this_thread::sleep_for(std::chrono::seconds(interval_seconds)); // 每隔interval_seconds秒执行一次
-        }
-    }).detach();
-};
-
-/*
- * 停止周期性删除过期数据
- * @return void
- * @remark 停止周期性删除过期数据
- */
-template <typename K, typename V>
-void SkipListWithCache<K, V>::stop_periodic_cleanup() {
-    running_cleanup = false; // 停止清理
-};
+#include "skiplist.h"
+#include "LRU.h"
+#include "node_arena.h"
+#include "level_generator.h"
+#include "wal.h"
+#include "bloom_filter.h"
+#include "timing_wheel.h"
+#include "expiry_sampler.h"
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+#include <optional>
+#include <cerrno>
+#include <ctime>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define DEFAULT_TTL 3600 // 默认过期时间
+#define PERMANENT_TTL -1 // 永久过期时间
+#define DEFAULT_STORE_FILE "store/dumpFile_cache" // 数据持久化文件
+#define DEFAULT_WAL_FILE "store/wal_cache" // 预写日志段文件前缀
+#define WAL_SNAPSHOT_SUFFIX "_snapshot" // 开启预写日志后，快照文件名前缀为 <日志段文件前缀>_snapshot
+#define WAL_COMMIT_FAILED -1 // 修改已生效，但预写日志写出或刷盘失败，重启后可能丢失
+#define NEGATIVE_CACHE_TTL 60 // 负缓存条目的过期时间（秒），插入时会立即失效，这里只是兜底
+
+// 带过期时间的跳表节点
+template <typename K, typename V>
+class NodeWithTTL{
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    NodeWithTTL() {} // 默认构造函数
+    NodeWithTTL(K k, V v, int, TimePoint t); // 构造函数，单独申请 forward 数组
+    NodeWithTTL(const K& k, const V& v, int level, TimePoint t, NodeWithTTL<K, V>** links); // 构造函数，forward 数组使用外部内存
+    ~NodeWithTTL(); // 析构函数
+
+    const K& getKey() const; // 获取键，返回引用，查找时原地比较
+    const V& getValue() const; // 获取值
+
+    void setValue(V); // 设置值
+    void setExpireTime(TimePoint t); // 设置过期时间
+    TimePoint getExpireTime() const; // 获取过期时间
+    int getRemainingTime() const; // 获取剩余时间
+    NodeWithTTL<K, V>** forward; 
+    int node_level; // 节点层级
+
+private:
+    bool owns_forward; // forward 数组是否由节点自己申请
+    K key; // 键
+    V value; // 值
+    TimePoint expiration_time; // 过期时间
+};
+
+/*
+ * 构造函数
+ * @param key 键
+ * @param value 值
+ * @param level 节点层级
+ * @param expiration_time 过期时间
+ * @return
+ */
+template <typename K, typename V>
+NodeWithTTL<K, V>::NodeWithTTL(K key, V value, int level, TimePoint expiration_time) { 
+    this->key = key;
+    this->value = value;
+    this->node_level = level;
+    this->expiration_time = expiration_time;
+    this->owns_forward = true;
+    this->forward = new NodeWithTTL<K, V>*[level + 1];
+    memset(forward, 0, sizeof(NodeWithTTL<K, V>*) * (level + 1));
+};
+
+/*
+ * 构造函数，forward 数组使用外部提供的内存
+ * @param links 至少能容纳 level + 1 个指针的内存，一般是内存池中紧跟在节点之后的空间
+ * @return
+ */
+template <typename K, typename V>
+NodeWithTTL<K, V>::NodeWithTTL(const K& key, const V& value, int level, TimePoint expiration_time, NodeWithTTL<K, V>** links)
+    : forward(links), node_level(level), owns_forward(false), key(key), value(value), expiration_time(expiration_time) {
+    memset(forward, 0, sizeof(NodeWithTTL<K, V>*) * (level + 1));
+};
+
+/*
+ * 析构函数
+ * @return
+ */
+template <typename K, typename V>
+NodeWithTTL<K, V>::~NodeWithTTL() {
+    if (owns_forward) {
+        delete[] forward;
+    }
+};
+
+/*
+ * 获取过期时间
+ * @return 过期时间
+ */
+template <typename K, typename V>
+typename NodeWithTTL<K, V>::TimePoint NodeWithTTL<K, V>::getExpireTime() const {
+    return expiration_time;
+};
+
+/*
+ * 设置过期时间
+ * @param t 过期时间
+ * @return
+ */
+template <typename K, typename V>
+void NodeWithTTL<K, V>::setExpireTime(TimePoint expiration_time) {
+    this->expiration_time = expiration_time;
+};
+
+/*
+ * 获取剩余时间
+ * @return 剩余时间
+ */
+template <typename K, typename V>
+int NodeWithTTL<K, V>::getRemainingTime() const {
+    return std::chrono::duration_cast<std::chrono::seconds>(expiration_time - std::chrono::steady_clock::now()).count();
+}
+
+/*
+ * 获取键
+ * @return 键
+ */
+template <typename K, typename V>
+const K& NodeWithTTL<K, V>::getKey() const {
+    return key;
+};
+
+/*
+ * 获取值
+ * @return 值
+ */
+template <typename K, typename V>
+const V& NodeWithTTL<K, V>::getValue() const {
+    return value;
+};
+
+/*
+ * 设置值
+ * @param value 值
+ * @return
+ */
+template <typename K, typename V>
+void NodeWithTTL<K, V>::setValue(V value) {
+    this->value = value;
+};
+
+// 查找统计，命中率 = (cache_hits + negative_hits) / lookups
+struct CacheStats {
+    uint64_t lookups; // 查找次数
+    uint64_t cache_hits; // 缓存命中
+    uint64_t negative_hits; // 负缓存命中（确认不存在，不需要查跳表）
+    uint64_t list_hits; // 缓存未命中，在跳表中找到
+    uint64_t misses; // 跳表中也不存在（或已过期）
+
+    double hit_ratio() const {
+        return lookups == 0 ? 0.0 : (double)(cache_hits + negative_hits) / lookups;
+    }
+};
+
+// 定期删除过期数据的方式
+enum class ExpiryMode {
+    WHEEL, // 时间轮：精确删除所有到期的键，代价与到期的键数成正比
+    SAMPLING // 随机抽样：Redis 式的主动过期，每次清理有时间预算，允许少量过期键留到下一次
+};
+
+template <typename K, typename V, typename CachePolicy = LRUPolicy>
+class SkipListWithCache{ 
+public: 
+    using Ref = ValueRef<V, std::shared_lock<std::shared_mutex>>; // find 的返回值
+    class Cursor; // 有序游标，跳过过期的节点
+
+    // 构造函数，最大层级可以传 AUTO_MAX_LEVEL，由元素个数决定
+    SkipListWithCache(int, size_t, LevelProbability p = LevelProbability::HALF);
+    
+    ~SkipListWithCache(); // 析构函数
+    
+    int get_random_level(); // 获取随机层级
+    int insert_element(const K& key, const V& value, int ttl_seconds); // 插入数据
+    NodeWithTTL<K, V>* create_node(const K& key, const V& value, int level, int ttl_seconds);
+    bool search_element(const K& key); // 查找数据
+    Ref find(const K& key); // 查找数据，返回引用跳表节点中的值的句柄，不经过缓存
+    std::vector<std::pair<K, V>> scan(const K& start, const K& end, size_t limit = SIZE_MAX); // 范围读取 [start, end)，跳过过期的节点
+    Cursor cursor(); // 创建游标，定位之前无效
+    std::vector<std::optional<V>> multi_get(const std::vector<K>& keys); // 批量查找，结果与 keys 一一对应
+    int multi_put(const std::vector<std::pair<K, V>>& elements, int ttl_seconds); // 批量插入，只加一次写锁
+    int delete_element(const K& key); // 删除数据
+    bool is_expired(const typename NodeWithTTL<K, V>::TimePoint& expiration_time) const; // 是否过期
+    void remove_cache_expired(); // 定期删除缓存数据
+    void remove_skiplist_expired(); // 定期删除跳表数据，按 ExpiryMode 选择时间轮或随机抽样
+    void set_expiry_mode(ExpiryMode mode, int budget_us = EXPIRY_CYCLE_BUDGET_US); // 选择定期删除的方式
+    size_t active_expire_cycle(int budget_us); // 随机抽样删除过期数据，最多运行 budget_us 微秒
+    void dump_file(); // 数据持久化（同步，遍历期间阻塞写线程）
+    bool bgsave(); // 后台持久化（fork 子进程写快照，不阻塞写线程）
+    void wait_bgsave(); // 等待后台持久化结束
+    void load_file(); // 数据加载
+    bool open_wal(const std::string& base = DEFAULT_WAL_FILE, WalSyncPolicy policy = WalSyncPolicy::ALWAYS,
+                  int interval_ms = WAL_FLUSH_INTERVAL); // 从最新快照和预写日志恢复，之后的修改写入预写日志
+    void close_wal(); // 关闭预写日志
+    void display_skiplist(); // 打印跳表
+    void display_cache(); // 打印缓存
+    void periodic_save(int t); // 周期性数据持久化策略
+    void stop_periodic_save(); // 停止周期性数据持久化策略
+    void periodic_cleanup(int t); // 周期性删除过期数据
+    void stop_periodic_cleanup(); // 停止周期性删除过期数据
+    void set_read_through(bool enabled); // 跳表命中时是否把数据放入缓存，默认开启
+    void enable_negative_cache(size_t capacity); // 缓存最近反复未命中的键，需在并发访问之前调用
+    void disable_negative_cache(); // 关闭负缓存，需在并发访问之前调用
+    CacheStats cache_stats() const; // 查找统计
+    void reset_cache_stats(); // 清零查找统计
+    void clear(); // 清空跳表和缓存，整块释放内存池
+    void clear(NodeWithTTL<K, V>* node); // 迭代析构从该节点开始的所有节点
+    int size(); // 获取元素个数
+
+private:
+    void get_key_value_from_string(const std::string& line, std::string* key, std::string* value, std::string* expiration_time); // 从字符串中获取键值对
+    bool is_valid_string(const std::string& str); // 是否为有效字符串
+    void destroy_node(NodeWithTTL<K, V>* node); // 析构节点并把内存归还内存池
+    NodeWithTTL<K, V>* find_node(const K& key); // 查找等于 key 的节点，调用者需持有跳表锁
+    NodeWithTTL<K, V>* find_less_than(const K& key); // 最后一个小于 key 的节点，没有时返回头节点，调用者需持有跳表锁
+    NodeWithTTL<K, V>* find_last(); // 最后一个节点，空表时返回头节点，调用者需持有跳表锁
+    void find_predecessors(const K& key, NodeWithTTL<K, V>** update); // 从 update 继续查找 key 在每层的前驱，调用者需持有跳表锁
+    size_t delete_expired(std::vector<K>& keys); // 一次加锁批量删除已过期的键
+    void load_file(const std::string& path); // 从指定文件加载数据
+    std::string latest_snapshot(const std::string& base); // 前缀为 base 的最新快照文件，没有时返回空串
+    std::string snapshot_filename(); // 生成带时间戳的快照文件名
+    bool write_snapshot(const std::string& filename, uint64_t& records); // 遍历跳表写出快照
+    int remaining_ttl(const typename NodeWithTTL<K, V>::TimePoint& expire_time) const; // 剩余的过期时间（秒）
+
+    int _max_level; // 最大层级
+    LevelGenerator _level_generator; // 随机层级生成器
+    int _skip_list_level; // 跳表层级
+    NodeWithTTL<K, V>* _header; // 头节点
+
+    // file operation
+    std::ofstream _file_writer; // 文件写入
+    std::ifstream _file_reader; // 文件读取
+
+    // skiplist current element count
+    int _element_count; // 元素个数
+    uint64_t _delete_version; // 删除版本号，在写锁内每删除一个节点（或清空）加 1，游标据此判断当前节点是否仍在表中
+
+    ShardedLRUCache<K, V, CachePolicy> cache; // 缓存，按键分片，每个分片有自己的锁，淘汰策略由 CachePolicy 指定
+    bool _read_through; // 跳表命中时是否放入缓存
+
+    // 负缓存：只有在 _miss_filter 中已经出现过的键再次未命中时才放入 _negative_cache，
+    // 只出现一次的不存在的键（如随机探测）只占过滤器中的几位，不会挤占负缓存
+    std::unique_ptr<ShardedLRUCache<K, bool>> _negative_cache; // 确认不存在的键
+    std::unique_ptr<RecentBloomFilter<K>> _miss_filter; // 最近未命中过的键
+
+    // 查找统计
+    std::atomic<uint64_t> _stat_lookups;
+    std::atomic<uint64_t> _stat_cache_hits;
+    std::atomic<uint64_t> _stat_negative_hits;
+    std::atomic<uint64_t> _stat_list_hits;
+    std::atomic<uint64_t> _stat_misses;
+
+    // 节点内存池：节点与 forward 数组一次分配、连续存放，只在写锁内访问
+    NodeArena<NodeWithTTL<K, V>, NodeWithTTL<K, V>*> _arena;
+
+    // 同步原语均为实例成员，不同实例之间互不影响
+    std::shared_mutex _mtx; // 跳表读写锁：查找、打印、持久化共享加锁，插入、删除独占加锁
+    std::mutex _file_mtx; // 文件IO互斥锁
+
+    std::string _snapshot_base; // 快照文件名前缀，open_wal 之后由日志段文件前缀决定，恢复时只加载与日志配套的快照
+    WriteAheadLog _wal; // 预写日志，open_wal 之后才启用
+
+    // 后台线程
+    std::atomic<bool> _keep_running; // 周期性数据持久化策略是否运行
+    std::atomic<bool> _running_cleanup; // 周期性删除过期数据是否运行
+    std::thread _save_thread; // 周期性数据持久化线程
+    std::thread _cleanup_thread; // 周期性删除过期数据线程
+    std::mutex _bg_mtx; // 用于唤醒后台线程
+    std::condition_variable _bg_cv; // 停止时立即唤醒正在等待的后台线程
+    std::atomic<bool> _bgsave_running; // 是否有后台持久化的子进程在运行
+    std::thread _bgsave_thread; // 等待后台持久化子进程结束的线程
+
+    // 过期索引：带过期时间的键插入时登记到时间轮（WHEEL）或抽样集合（SAMPLING），只维护当前方式使用的一个
+    ExpiryMode _expiry_mode; // 定期删除的方式，在跳表锁内读写
+    int _expiry_budget_us; // SAMPLING 方式每次清理的时间预算
+    TimingWheel<K> _expiry_wheel;
+    std::mutex _wheel_mtx; // 时间轮锁，插入时在跳表写锁内获取
+    ExpirySampleSet<K> _expiry_samples; // 带过期时间的键，受跳表锁保护
+};
+
+/*
+ * 构造函数
+ * @param max_level 最大层级，AUTO_MAX_LEVEL 表示由元素个数决定（上限 LEVEL_GENERATOR_MAX_LEVEL）
+ * @param cache_capacity 缓存容量
+ * @param p 节点晋升到上一层的概率
+ * @return
+ */
+template <typename K, typename V, typename CachePolicy>
+SkipListWithCache<K, V, CachePolicy>::SkipListWithCache(int max_level, size_t cache_capacity, LevelProbability p) 
+    : _max_level(max_level > AUTO_MAX_LEVEL ? max_level : LEVEL_GENERATOR_MAX_LEVEL), _level_generator(p), _skip_list_level(0), _element_count(0), _delete_version(0), cache(cache_capacity), _read_through(true),
+      _stat_lookups(0), _stat_cache_hits(0), _stat_negative_hits(0), _stat_list_hits(0), _stat_misses(0),
+      _snapshot_base(DEFAULT_STORE_FILE), _keep_running(false), _running_cleanup(false), _bgsave_running(false),
+      _expiry_mode(ExpiryMode::WHEEL), _expiry_budget_us(EXPIRY_CYCLE_BUDGET_US) {
+    this->_skip_list_level = 0;
+    this->_element_count = 0;
+    
+    // 创建头节点，头节点不放在内存池中，clear() 整块释放内存池时它保持不变
+    K k{};
+    V v{};
+    this->_header = new NodeWithTTL<K, V>(k, v, _max_level, std::chrono::steady_clock::time_point::max()); // 创建头节点
+};
+
+/*
+ * 析构函数
+ * @return
+ */
+template <typename K, typename V, typename CachePolicy>
+SkipListWithCache<K, V, CachePolicy>::~SkipListWithCache() {
+    
+    if (_file_reader.is_open()) {
+        _file_reader.close();
+    }
+    if (_file_writer.is_open()) {
+        _file_writer.close();
+    }
+
+    stop_periodic_cleanup(); // 停止周期性删除过期数据 
+    stop_periodic_save(); // 停止周期性数据持久化策略
+    wait_bgsave(); // 等待后台持久化子进程结束
+
+    // 析构所有节点，节点内存随 _arena 整块释放
+    clear(_header->forward[0]);
+    delete _header;
+};
+
+/*
+ * 获取随机层级
+ * @return 随机层级，范围 [0, _max_level]，第 i 层出现的概率为 p^i
+ * @remark 使用线程本地的随机数，不经过 rand() 的全局锁；层级同时不超过 ceil(log_{1/p} n)（n 为插入后的元素个数）。
+ *         调用者需持有写锁
+ */
+template <typename K, typename V, typename CachePolicy>
+int SkipListWithCache<K, V, CachePolicy>::get_random_level() {
+    int cap = _level_generator.level_cap(_element_count + 1);
+    return _level_generator.next(cap < _max_level ? cap : _max_level);
+};
+
+/*
+ * 清空跳表和缓存
+ * @return
+ * @remark 用于运行时重置整个键空间。独占加锁后把头节点的 forward 指针全部置空，
+ *         析构旧节点（键值可平凡析构时直接跳过），再整块释放内存池，不逐个释放节点。
+ *         打开了预写日志时在写锁内追加一条清空记录，重启重放到这里时同样清空，之前的键不会恢复
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::clear() {
+    _mtx.lock(); // 独占加锁，查找持有共享锁，不会停留在旧节点上
+
+    NodeWithTTL<K, V>* first = _header->forward[0];
+    memset(_header->forward, 0, sizeof(NodeWithTTL<K, V>*) * (_max_level + 1));
+    _skip_list_level = 0;
+    _element_count = 0;
+    _delete_version++; // 旧节点全部失效，游标下次移动时重新定位
+    _expiry_samples.clear();
+    {
+        std::lock_guard<std::mutex> wheel_lock(_wheel_mtx); // 与插入相同，在跳表写锁内获取
+        _expiry_wheel.clear(); // 解锁后再清空会丢掉并发插入刚登记的过期时间
+    }
+
+    clear(first);
+    _arena.release_all();
+
+    uint64_t wal_seq = _wal.is_open() ? _wal.append_clear() : 0;
+
+    _mtx.unlock(); // 解锁
+
+    if (wal_seq != 0 && !_wal.commit(wal_seq)) {
+        std::cerr << "Failed to log clear, the old keys may come back after restart" << std::endl;
+    }
+
+    cache.clear();
+    if (_negative_cache) {
+        _negative_cache->clear();
+        _miss_filter->clear();
+    }
+};
+
+/*
+ * 迭代析构跳表节点
+ * @param node 链表中的第一个节点，可以为 nullptr
+ * @return
+ * @remark 沿第 0 层迭代，栈空间 O(1)。只调用析构函数，不归还内存，调用者随后应整块释放内存池
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::clear(NodeWithTTL<K, V>* current) {
+    // 键和值都可以平凡析构时，节点析构没有任何作用，直接跳过遍历
+    if (std::is_trivially_destructible<K>::value && std::is_trivially_destructible<V>::value) {
+        return;
+    }
+    while (current != nullptr) {
+        NodeWithTTL<K, V>* next = current->forward[0];
+        current->~NodeWithTTL();
+        current = next;
+    }
+};
+
+/*
+ * 获取元素个数
+ * @return 元素个数
+ */
+template <typename K, typename V, typename CachePolicy>
+int SkipListWithCache<K, V, CachePolicy>::size() {
+    std::shared_lock<std::shared_mutex> lock(_mtx);
+    return _element_count;
+};
+
+/*
+ * 创建节点
+ * @param key 键
+ * @param value 值
+ * @param level 层级
+ * @param ttl_seconds 过期时间
+ * @return 节点
+ */
+template <typename K, typename V, typename CachePolicy>
+NodeWithTTL<K, V>* SkipListWithCache<K, V, CachePolicy>::create_node(const K& key, const V& value, int level, int ttl_seconds) { 
+    typename NodeWithTTL<K, V>::TimePoint expiration_time;
+    // 如果过期时间为永久
+    if (ttl_seconds ==  PERMANENT_TTL) {
+        // 过期时间为最大时间
+        expiration_time = std::chrono::steady_clock::time_point::max();
+    } else {
+        // 过期时间为当前时间加上过期时间
+        expiration_time = std::chrono::steady_clock::now() + std::chrono::seconds(ttl_seconds);
+    }
+    // 从内存池中分配一块内存，节点对象之后紧跟 forward 数组
+    void* block = _arena.allocate(level);
+    NodeWithTTL<K, V>* n = new (block) NodeWithTTL<K, V>(key, value, level, expiration_time, _arena.links_of(block));
+    return n;
+}
+
+/*
+ * 销毁节点
+ * @param node 节点
+ * @return
+ * @remark 调用析构函数后把内存块挂回对应层数的空闲链表，调用者需持有写锁
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::destroy_node(NodeWithTTL<K, V>* node) {
+    int level = node->node_level;
+    node->~NodeWithTTL();
+    _arena.deallocate(node, level);
+}
+
+/*
+ * 插入元素，同时插入缓存
+ * @param key 键
+ * @param value 值
+ * @param ttl_seconds 过期时间
+ * @return int 0 插入成功，1 已存在，WAL_COMMIT_FAILED 已插入但预写日志写出或刷盘失败
+ * @remark 插入数据到跳表和缓存，并设置过期时间
+ */
+template <typename K, typename V, typename CachePolicy>
+int SkipListWithCache<K, V, CachePolicy>::insert_element(const K& key, const V& value, int ttl_seconds) {
+    
+    _mtx.lock(); // 独占加锁
+
+    NodeWithTTL<K, V>* current = this->_header; // 当前节点
+    NodeWithTTL<K, V>* update[_max_level + 1]; // 更新节点
+    memset(update, 0, sizeof(NodeWithTTL<K, V>*) * (_max_level + 1)); // 初始化更新节点
+
+    // start from highest level of skip list
+    for (int i = _skip_list_level; i >= 0; i--) { 
+        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
+            current = current->forward[i];
+        }
+        update[i] = current;
+    }
+    current = current->forward[0];
+
+    if (current != nullptr && current->getKey() == key) {
+        //std::cout << "key: " << key << ", exists" << std::endl;
+        _mtx.unlock(); // 解锁
+        return 1; // 已存在
+    }
+
+    if (current == nullptr || current->getKey() != key) { 
+        int random_level = get_random_level(); // 随机层级
+
+        if (random_level > _skip_list_level) { // 如果随机层级大于当前层级
+            for (int i = _skip_list_level + 1; i < random_level + 1; i++) {
+                update[i] = _header; // 更新节点
+            }
+            _skip_list_level = random_level;
+        }
+
+        NodeWithTTL<K, V>* inserted_node = create_node(key, value, random_level, ttl_seconds); // 创建节点
+
+        for (int i = 0; i <= random_level; i++) {
+            inserted_node->forward[i] = update[i]->forward[i];
+            update[i]->forward[i] = inserted_node;
+        }
+
+        //std::cout << "Successfully inserted key: " << key << ", value: " << value << ", level: " << random_level << ", ttl: " << ttl_seconds << std::endl;
+        _element_count++; // 元素个数加1
+
+        if (ttl_seconds != PERMANENT_TTL) { // 登记到过期索引，到期后由 remove_skiplist_expired 删除
+            if (_expiry_mode == ExpiryMode::WHEEL) {
+                std::lock_guard<std::mutex> wheel_lock(_wheel_mtx);
+                _expiry_wheel.schedule(key, inserted_node->getExpireTime());
+            } else {
+                _expiry_samples.add(key, inserted_node->getExpireTime());
+            }
+        }
+
+        // 在写锁内使负缓存失效：之后拿到共享锁的查找一定能在跳表中看到这个键
+        if (_negative_cache) {
+            _negative_cache->remove(key);
+        }
+    }
+
+    // 在写锁内追加日志，日志顺序与修改顺序一致；释放写锁后再等待落盘，让并发的写线程共享一次刷盘
+    uint64_t wal_seq = _wal.is_open() ? _wal.append_insert(key, value, WriteAheadLog::expire_at_ms(ttl_seconds)) : 0;
+
+    // 在写锁内插入缓存：解锁后并发的 delete_element 清理缓存一定发生在这之后，不会留下已删除的键
+    cache.put(key, value, ttl_seconds);
+
+    _mtx.unlock(); // 解锁
+
+    bool logged = wal_seq == 0 || _wal.commit(wal_seq);
+
+    return logged ? 0 : WAL_COMMIT_FAILED; // 插入成功
+};
+
+
+/*
+ * 查找元素，先从缓存中查找，如果缓存中没有，再从跳表中获取
+ * @param key 键
+ * @param value 值
+ * @return bool
+ * @remark 从缓存中获取数据，如果缓存中没有，再从跳表中获取，在跳表中查询时，惰性删除；
+ *         跳表命中时把数据放入缓存（read-through），开启负缓存时先查负缓存，跳表中反复不存在的键放入负缓存。
+ *         read-through 在共享锁内放入缓存，insert_element / multi_put 在写锁内放入缓存并清理负缓存，
+ *         删除在释放写锁后才清理缓存，因此清理总在同一个键之前的放入之后，不会长期留下已删除的键；
+ *         但从删除释放写锁到清理缓存之间，缓存中仍可能短暂读到刚删除的键
+ */
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::search_element(const K& key) {
+
+    std::cout << "search_element-----------------" << std::endl;
+    V value;
+    _stat_lookups.fetch_add(1, std::memory_order_relaxed);
+
+    // 从缓存中获取数据
+    bool cache_hit = cache.get(key, value);
+    if (cache_hit) { 
+        std::cout << "Found key: " << key << ", value: " << value << " from cache" << std::endl;
+        _stat_cache_hits.fetch_add(1, std::memory_order_relaxed);
+        return true; // 缓存中存在
+    }
+
+    // 负缓存中存在，说明最近确认过跳表中没有这个键
+    bool absent;
+    if (_negative_cache && _negative_cache->get(key, absent)) {
+        std::cout << "Not found key: " << key << " (negative cache)" << std::endl;
+        _stat_negative_hits.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 从跳表中获取数据，共享加锁，多个查找可以并发执行
+    _mtx.lock_shared();
+    NodeWithTTL<K, V>* current = find_node(key);
+    if (current != nullptr) { 
+        // 如果节点过期，删除节点
+        if (is_expired(current->getExpireTime())) {
+            std::cout << "Found key: " << key << ", value: " << current->getValue() << " from skip list, but expired" << std::endl;
+            _mtx.unlock_shared(); // 删除需要独占锁，先释放共享锁
+            std::vector<K> expired{key};
+            delete_expired(expired); // 加写锁后重新检查，期间被重新插入的键不会被删除
+            _stat_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::cout << "Found key: " << key << ", value: " << current->getValue() << " from skip list" << std::endl;
+        if (_read_through) { // 放入缓存，缓存条目不晚于节点过期
+            int ttl_seconds = remaining_ttl(current->getExpireTime());
+            if (ttl_seconds != 0) {
+                cache.put(key, current->getValue(), ttl_seconds);
+            }
+        }
+        _mtx.unlock_shared();
+        _stat_list_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (_negative_cache && _miss_filter->add(key)) { // 最近已经未命中过一次，放入负缓存
+        _negative_cache->put(key, true, NEGATIVE_CACHE_TTL);
+    }
+    _mtx.unlock_shared();
+    
+    std::cout << "Not found key: " << key << std::endl;
+    _stat_misses.fetch_add(1, std::memory_order_relaxed);
+    return false; // 未找到
+};
+
+/*
+ * 查找数据，返回引用跳表节点中的值的句柄
+ * @param key 键
+ * @return Ref 找到且未过期时句柄引用节点中的值，并持有跳表的共享锁；否则为空句柄
+ * @remark 缓存中的条目随时可能被淘汰，不能在分片锁之外引用，所以直接查跳表，不经过缓存，也不计入查找统计。
+ *         句柄存续期间写线程会被阻塞，读取完值应尽快析构句柄；持有句柄的线程不能再修改跳表。
+ *         过期的节点与 search_element 一样惰性删除
+ */
+template <typename K, typename V, typename CachePolicy>
+typename SkipListWithCache<K, V, CachePolicy>::Ref SkipListWithCache<K, V, CachePolicy>::find(const K& key) {
+    std::shared_lock<std::shared_mutex> lock(_mtx); // 共享加锁，随句柄一起释放
+    NodeWithTTL<K, V>* current = find_node(key);
+    if (current == nullptr) {
+        return Ref();
+    }
+    if (is_expired(current->getExpireTime())) {
+        lock.unlock(); // 删除需要独占锁，先释放共享锁
+        std::vector<K> expired{key};
+        delete_expired(expired); // 加写锁后重新检查，期间被重新插入的键不会被删除
+        return Ref();
+    }
+    return Ref(&current->getValue(), std::move(lock));
+}
+
+/*
+ * 查找等于 key 的节点
+ * @param key 键
+ * @return 找到的节点（可能已过期），没找到返回 nullptr
+ * @remark 调用者需持有跳表锁（共享或独占）；getKey 返回引用，逐个节点比较时不复制键
+ */
+template <typename K, typename V, typename CachePolicy>
+NodeWithTTL<K, V>* SkipListWithCache<K, V, CachePolicy>::find_node(const K& key) {
+    NodeWithTTL<K, V>* current = find_less_than(key)->forward[0];
+    if (current != nullptr && current->getKey() == key) {
+        return current;
+    }
+    return nullptr;
+}
+
+/*
+ * 最后一个小于 key 的节点
+ * @param key 键
+ * @return 最后一个小于 key 的节点，没有时返回头节点；它在第 0 层的后继就是第一个不小于 key 的节点
+ * @remark 调用者需持有跳表锁（共享或独占）
+ */
+template <typename K, typename V, typename CachePolicy>
+NodeWithTTL<K, V>* SkipListWithCache<K, V, CachePolicy>::find_less_than(const K& key) {
+    NodeWithTTL<K, V>* current = this->_header; // 当前节点
+    for (int i = _skip_list_level; i >= 0; i--) { 
+        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
+            current = current->forward[i];
+        }
+    }
+    return current;
+}
+
+/*
+ * 最后一个节点
+ * @return 最后一个节点，空表时返回头节点
+ * @remark 调用者需持有跳表锁（共享或独占）
+ */
+template <typename K, typename V, typename CachePolicy>
+NodeWithTTL<K, V>* SkipListWithCache<K, V, CachePolicy>::find_last() {
+    NodeWithTTL<K, V>* current = this->_header;
+    for (int i = _skip_list_level; i >= 0; i--) {
+        while (current->forward[i] != nullptr) {
+            current = current->forward[i];
+        }
+    }
+    return current;
+}
+
+/*
+ * 范围读取
+ * @param start 起始键（包含）
+ * @param end 结束键（不包含）
+ * @param limit 最多读取的元素个数，过期的节点不计入
+ * @return 按键升序排列的键值对
+ * @remark 共享加锁，定位到第一个不小于 start 的节点后沿第 0 层前进，一次定位读取整个范围；
+ *         过期的节点直接跳过，留给定期删除或查找时的惰性删除。与 find 一样不经过缓存
+ */
+template <typename K, typename V, typename CachePolicy>
+std::vector<std::pair<K, V>> SkipListWithCache<K, V, CachePolicy>::scan(const K& start, const K& end, size_t limit) {
+    std::vector<std::pair<K, V>> result;
+    typename NodeWithTTL<K, V>::TimePoint now = std::chrono::steady_clock::now(); // 整个范围按同一时刻判断是否过期
+
+    std::shared_lock<std::shared_mutex> lock(_mtx); // 共享加锁
+    NodeWithTTL<K, V>* node = find_less_than(start)->forward[0];
+    while (node != nullptr && result.size() < limit && node->getKey() < end) {
+        if (!(node->getExpireTime() < now)) {
+            result.emplace_back(node->getKey(), node->getValue());
+        }
+        node = node->forward[0];
+    }
+    return result;
+}
+
+/* ************************************************************************
+> SkipListWithCache 的有序游标，由 cursor() 创建，用法与 SkipList::Cursor 相同
+> 游标保存当前元素的键值副本，每次定位、移动时短暂持有共享锁，不会长时间阻塞写线程
+> 定位时记下删除版本号（在写锁内修改，共享锁内读取）。移动时版本号没变，当前节点一定没有被删除，
+  直接沿 forward[0] 前进；否则按保存的键重新定位。插入不会使节点失效
+> 过期的节点被跳过：向后移动时继续沿 forward[0] 前进，向前移动时继续查找更小的键
+ ************************************************************************/
+
+template <typename K, typename V, typename CachePolicy>
+class SkipListWithCache<K, V, CachePolicy>::Cursor {
+public:
+    explicit Cursor(SkipListWithCache<K, V, CachePolicy>* list);
+
+    bool valid() const; // 是否指向一个元素
+    const K& key() const; // 当前元素的键，valid() 为真时才能调用
+    const V& value() const; // 当前元素的值，valid() 为真时才能调用
+
+    void seek(const K& key); // 定位到第一个不小于 key 的元素
+    void seek_for_prev(const K& key); // 定位到最后一个不大于 key 的元素
+    void seek_to_first(); // 定位到第一个元素
+    void seek_to_last(); // 定位到最后一个元素
+    void next(); // 移动到下一个元素
+    void prev(); // 移动到上一个元素
+
+private:
+    void settle_forward(NodeWithTTL<K, V>* node); // 从 node 开始向后跳过过期的节点，停在第一个未过期的节点上
+    void settle_backward(NodeWithTTL<K, V>* node); // 从 node 开始向前跳过过期的节点，停在第一个未过期的节点上
+
+    SkipListWithCache<K, V, CachePolicy>* _list; // 所属的跳表
+    NodeWithTTL<K, V>* _node; // 当前节点，只在删除版本号没变时访问
+    uint64_t _version; // 定位时跳表的删除版本号
+    K _key; // 当前元素的键
+    V _value; // 当前元素的值
+    bool _valid; // 是否指向一个元素
+};
+
+template <typename K, typename V, typename CachePolicy>
+SkipListWithCache<K, V, CachePolicy>::Cursor::Cursor(SkipListWithCache<K, V, CachePolicy>* list)
+    : _list(list), _node(nullptr), _version(0), _key(), _value(), _valid(false) {}
+
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::Cursor::valid() const {
+    return _valid;
+}
+
+template <typename K, typename V, typename CachePolicy>
+const K& SkipListWithCache<K, V, CachePolicy>::Cursor::key() const {
+    return _key;
+}
+
+template <typename K, typename V, typename CachePolicy>
+const V& SkipListWithCache<K, V, CachePolicy>::Cursor::value() const {
+    return _value;
+}
+
+/*
+ * 向后跳过过期的节点，停在第一个未过期的节点上并复制键值
+ * @param node 起始节点，nullptr 表示已经到达末尾
+ * @remark 调用者需持有跳表的共享锁
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::settle_forward(NodeWithTTL<K, V>* node) {
+    typename NodeWithTTL<K, V>::TimePoint now = std::chrono::steady_clock::now();
+    while (node != nullptr && node->getExpireTime() < now) {
+        node = node->forward[0];
+    }
+    _valid = (node != nullptr);
+    _node = node;
+    _version = _list->_delete_version;
+    if (_valid) {
+        _key = node->getKey();
+        _value = node->getValue();
+    }
+}
+
+/*
+ * 向前跳过过期的节点，停在第一个未过期的节点上并复制键值
+ * @param node 起始节点，头节点表示已经到达开头
+ * @remark 调用者需持有跳表的共享锁；每跳过一个过期节点都要重新从头查找，期望 O(log n)
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::settle_backward(NodeWithTTL<K, V>* node) {
+    typename NodeWithTTL<K, V>::TimePoint now = std::chrono::steady_clock::now();
+    while (node != _list->_header && node->getExpireTime() < now) {
+        node = _list->find_less_than(node->getKey());
+    }
+    _valid = (node != _list->_header);
+    _node = _valid ? node : nullptr;
+    _version = _list->_delete_version;
+    if (_valid) {
+        _key = node->getKey();
+        _value = node->getValue();
+    }
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::seek(const K& key) {
+    std::shared_lock<std::shared_mutex> lock(_list->_mtx);
+    settle_forward(_list->find_less_than(key)->forward[0]);
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::seek_for_prev(const K& key) {
+    std::shared_lock<std::shared_mutex> lock(_list->_mtx);
+    NodeWithTTL<K, V>* prev = _list->find_less_than(key);
+    NodeWithTTL<K, V>* next = prev->forward[0];
+    settle_backward(next != nullptr && next->getKey() == key ? next : prev);
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::seek_to_first() {
+    std::shared_lock<std::shared_mutex> lock(_list->_mtx);
+    settle_forward(_list->_header->forward[0]);
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::seek_to_last() {
+    std::shared_lock<std::shared_mutex> lock(_list->_mtx);
+    settle_backward(_list->find_last());
+}
+
+/*
+ * 移动到下一个元素
+ * @remark 删除版本号没变时当前节点一定还在表中，直接取它的后继；否则按保存的键重新定位到第一个大于它的元素
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::next() {
+    if (!_valid) {
+        return;
+    }
+    std::shared_lock<std::shared_mutex> lock(_list->_mtx);
+    NodeWithTTL<K, V>* node;
+    if (_list->_delete_version == _version) {
+        node = _node->forward[0];
+    } else {
+        node = _list->find_less_than(_key)->forward[0];
+        if (node != nullptr && node->getKey() == _key) {
+            node = node->forward[0];
+        }
+    }
+    settle_forward(node);
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::Cursor::prev() {
+    if (!_valid) {
+        return;
+    }
+    std::shared_lock<std::shared_mutex> lock(_list->_mtx);
+    settle_backward(_list->find_less_than(_key));
+}
+
+/*
+ * 创建游标
+ * @return 定位之前无效的游标，不能比跳表存活得更久
+ */
+template <typename K, typename V, typename CachePolicy>
+typename SkipListWithCache<K, V, CachePolicy>::Cursor SkipListWithCache<K, V, CachePolicy>::cursor() {
+    return Cursor(this);
+}
+
+/*
+ * 剩余的过期时间
+ * @param expire_time 过期时间
+ * @return int 剩余秒数（向下取整，缓存条目不会比节点晚过期），永不过期时返回 PERMANENT_TTL
+ */
+template <typename K, typename V, typename CachePolicy>
+int SkipListWithCache<K, V, CachePolicy>::remaining_ttl(const typename NodeWithTTL<K, V>::TimePoint& expire_time) const {
+    if (expire_time == NodeWithTTL<K, V>::TimePoint::max()) {
+        return PERMANENT_TTL;
+    }
+    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(expire_time - std::chrono::steady_clock::now());
+    return remaining.count() > 0 ? (int)remaining.count() : 0;
+}
+
+/*
+ * 删除过期缓存数据
+ * @return void
+ * @remark 删除过期缓存数据
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::remove_cache_expired() {
+    cache.remove_expired();
+};
+
+/*
+ * 判断节点是否过期
+ * @param expiration_time 过期时间
+ * @return bool
+ * @remark 判断节点是否过期
+ */
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::is_expired(const typename NodeWithTTL<K, V>::TimePoint& expiration_time) const {
+    return expiration_time < std::chrono::steady_clock::now();
+};
+
+/*
+ * 删除过期跳表数据
+ * @return void
+ * @remark WHEEL：时间轮前进到当前时间，取出到期的键，再一次加锁批量删除；
+ *         代价与到期的键数成正比，不再遍历整个第 0 层。
+ *         SAMPLING：调用 active_expire_cycle，耗时不超过 set_expiry_mode 设置的预算
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::remove_skiplist_expired() {
+    _mtx.lock_shared();
+    bool sampling = _expiry_mode == ExpiryMode::SAMPLING;
+    int budget_us = _expiry_budget_us;
+    _mtx.unlock_shared();
+    if (sampling) {
+        active_expire_cycle(budget_us);
+        return;
+    }
+
+    std::vector<K> expired_keys; // 到期的键
+
+    _wheel_mtx.lock();
+    _expiry_wheel.advance(std::chrono::steady_clock::now(), expired_keys);
+    _wheel_mtx.unlock();
+
+    if (!expired_keys.empty()) {
+        delete_expired(expired_keys);
+    }
+};
+
+/*
+ * 选择定期删除的方式
+ * @param mode WHEEL 或 SAMPLING
+ * @param budget_us SAMPLING 方式每次清理的时间预算（微秒）
+ * @remark 切换方式时遍历一次第 0 层，用现有的带过期时间的节点重建新方式的索引，并清空旧方式的索引
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::set_expiry_mode(ExpiryMode mode, int budget_us) {
+    _mtx.lock(); // 独占加锁
+
+    _expiry_budget_us = budget_us;
+    if (mode != _expiry_mode) {
+        _expiry_mode = mode;
+        std::lock_guard<std::mutex> wheel_lock(_wheel_mtx);
+        _expiry_wheel.clear();
+        _expiry_samples.clear();
+        for (NodeWithTTL<K, V>* node = _header->forward[0]; node != nullptr; node = node->forward[0]) {
+            if (node->getExpireTime() == NodeWithTTL<K, V>::TimePoint::max()) {
+                continue;
+            }
+            if (mode == ExpiryMode::WHEEL) {
+                _expiry_wheel.schedule(node->getKey(), node->getExpireTime());
+            } else {
+                _expiry_samples.add(node->getKey(), node->getExpireTime());
+            }
+        }
+    }
+
+    _mtx.unlock(); // 解锁
+}
+
+/*
+ * 随机抽样删除过期数据
+ * @param budget_us 时间预算（微秒）
+ * @return size_t 删除的节点数
+ * @remark 每轮在共享锁内抽取 EXPIRY_SAMPLE_COUNT 个带过期时间的键，过期的键交给 delete_expired 一次加锁删除；
+ *         过期比例超过 EXPIRY_ACCEPTABLE_STALE% 且未超出预算时继续下一轮。
+ *         每轮的加锁时间与数据量无关，写锁最多删除 EXPIRY_SAMPLE_COUNT 个键，不会长时间阻塞读写
+ */
+template <typename K, typename V, typename CachePolicy>
+size_t SkipListWithCache<K, V, CachePolicy>::active_expire_cycle(int budget_us) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::microseconds(budget_us);
+    uint64_t seed = (uint64_t)start.time_since_epoch().count() | 1; // xorshift 的状态不能为 0
+    size_t deleted = 0;
+    std::vector<K> expired_keys; // 本轮抽到的过期键
+
+    while (true) {
+        expired_keys.clear();
+        size_t sampled = 0;
+
+        _mtx.lock_shared();
+        size_t n = _expiry_samples.size();
+        auto now = std::chrono::steady_clock::now();
+        for (; sampled < EXPIRY_SAMPLE_COUNT && sampled < n; sampled++) {
+            const typename ExpirySampleSet<K>::Entry& entry = _expiry_samples.sample(seed);
+            if (entry.expire_time < now) {
+                expired_keys.push_back(entry.key);
+            }
+        }
+        _mtx.unlock_shared();
+
+        if (!expired_keys.empty()) {
+            deleted += delete_expired(expired_keys);
+        }
+        if (sampled == 0 || expired_keys.size() * 100 <= sampled * EXPIRY_ACCEPTABLE_STALE ||
+            std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return deleted;
+}
+
+/*
+ * 批量删除已过期的键
+ * @param keys 候选的键，会被排序去重
+ * @return size_t 删除的节点数
+ * @remark 键排序后只加一次写锁，每个键从上一个键的 update[] 开始查找（finger search），
+ *         相邻的键不必每次都从头节点的最高层开始。
+ *         时间轮中的条目不会随删除或重新插入而取消，这里再检查一次节点是否真的过期：
+ *         已经被删除的键找不到节点，重新插入的键过期时间已经更新，都会被跳过
+ */
+template <typename K, typename V, typename CachePolicy>
+size_t SkipListWithCache<K, V, CachePolicy>::delete_expired(std::vector<K>& keys) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<K> deleted; // 实际删除的键，解锁后清理缓存
+    uint64_t wal_seq = 0; // 最后一条预写日志的序号
+
+    _mtx.lock(); // 独占加锁
+
+    NodeWithTTL<K, V>* update[_max_level + 1]; // 上一个键在每层的前驱
+    for (int i = 0; i <= _max_level; i++) {
+        update[i] = _header;
+    }
+
+    for (const K& key : keys) {
+        find_predecessors(key, update);
+        NodeWithTTL<K, V>* current = update[0]->forward[0];
+
+        if (current == nullptr || current->getKey() != key || !is_expired(current->getExpireTime())) {
+            continue; // 已被删除，或者重新插入后尚未过期
+        }
+
+        for (int i = 0; i <= _skip_list_level; i++) {
+            if (update[i]->forward[i] != current) {
+                break;
+            }
+            update[i]->forward[i] = current->forward[i];
+        }
+        while (_skip_list_level > 0 && _header->forward[_skip_list_level] == nullptr) {
+            _skip_list_level--;
+        }
+
+        destroy_node(current);
+        _element_count--;
+        _delete_version++;
+        deleted.push_back(key);
+        if (_expiry_mode == ExpiryMode::SAMPLING) {
+            _expiry_samples.remove(key);
+        }
+
+        if (_wal.is_open()) {
+            wal_seq = _wal.append_delete(key);
+        }
+    }
+
+    _mtx.unlock(); // 解锁
+
+    if (!deleted.empty()) { // 解锁后汇总输出一次，不在写锁内逐个打印
+        std::cout << "Successfully deleted " << deleted.size() << " expired keys" << std::endl;
+    }
+
+    if (wal_seq != 0 && !_wal.commit(wal_seq)) { // 等最后一条落盘，之前的记录随之落盘
+        std::cerr << "Failed to log expired keys, they may come back after restart" << std::endl;
+    }
+
+    for (const K& key : deleted) {
+        cache.remove(key);
+    }
+    return deleted.size();
+};
+
+
+/*
+ * 查找 key 在每一层的前驱
+ * @param key 键，不小于上一次调用的键
+ * @param update 输入为上一个键在每层的前驱（首次调用时全部为头节点），输出为 key 在每层的前驱
+ * @remark 按键升序处理一批键时，上一个键的前驱也小于当前键，可以从它继续查找（finger search）：
+ *         1. 从第 0 层向上，找到第一层前驱的后继不小于 key 的层 level，key 一定落在这一层的前驱和它的后继之间；
+ *         2. 从 level 层的前驱向下查找，更高层的前驱保持不变。
+ *         相邻两个键之间隔着 d 个节点时只需访问 O(log d) 层，而不是从头节点的最高层开始。
+ *         调用者需持有跳表锁，且两次调用之间没有释放过锁（否则前驱可能已被删除）
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::find_predecessors(const K& key, NodeWithTTL<K, V>** update) {
+    int level = 0;
+    while (level < _skip_list_level && update[level]->forward[level] != nullptr &&
+           update[level]->forward[level]->getKey() < key) {
+        level++;
+    }
+
+    NodeWithTTL<K, V>* current = update[level];
+    for (int i = level; i >= 0; i--) {
+        // 上一个键在本层的前驱比从上层下来的节点更靠后时，从它继续（两者的键都小于 key）
+        if (update[i] != _header && (current == _header || current->getKey() < update[i]->getKey())) {
+            current = update[i];
+        }
+        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
+            current = current->forward[i];
+        }
+        update[i] = current;
+    }
+}
+
+/*
+ * 批量查找
+ * @param keys 要查找的键，顺序任意，可以重复
+ * @return 与 keys 一一对应，找到且未过期时为值的副本
+ * @remark 与 search_element 的逻辑相同，但整批只加一次共享锁：
+ *         1. 先逐个查缓存和负缓存，命中的键不再访问跳表；
+ *         2. 剩下的键按键排序，共享加锁后依次查找，每个键从上一个键的前驱继续（find_predecessors）；
+ *            命中时放入缓存（read-through），反复未命中的键放入负缓存；
+ *         3. 解锁后用 delete_expired 一次加锁删除遇到的过期节点。
+ *         不打印每个键的查找结果，计入查找统计
+ */
+template <typename K, typename V, typename CachePolicy>
+std::vector<std::optional<V>> SkipListWithCache<K, V, CachePolicy>::multi_get(const std::vector<K>& keys) {
+    std::vector<std::optional<V>> result(keys.size());
+    std::vector<size_t> pending; // 缓存和负缓存都没有命中的键的下标
+    V value;
+    bool absent;
+
+    _stat_lookups.fetch_add(keys.size(), std::memory_order_relaxed);
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (cache.get(keys[i], value)) {
+            result[i] = value;
+            _stat_cache_hits.fetch_add(1, std::memory_order_relaxed);
+        } else if (_negative_cache && _negative_cache->get(keys[i], absent)) {
+            _stat_negative_hits.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            pending.push_back(i);
+        }
+    }
+    if (pending.empty()) {
+        return result;
+    }
+    std::sort(pending.begin(), pending.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+    std::vector<K> expired; // 遇到的过期节点，解锁后删除
+    typename NodeWithTTL<K, V>::TimePoint now = std::chrono::steady_clock::now();
+
+    _mtx.lock_shared(); // 共享加锁，整批只加一次
+
+    NodeWithTTL<K, V>* update[_max_level + 1]; // 上一个键在每层的前驱
+    for (int i = 0; i <= _max_level; i++) {
+        update[i] = _header;
+    }
+
+    for (size_t index : pending) {
+        const K& key = keys[index];
+        find_predecessors(key, update);
+        NodeWithTTL<K, V>* current = update[0]->forward[0];
+        if (current != nullptr && current->getKey() == key) {
+            if (current->getExpireTime() < now) {
+                expired.push_back(key);
+                _stat_misses.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            result[index] = current->getValue();
+            if (_read_through) { // 放入缓存，缓存条目不晚于节点过期
+                int ttl_seconds = remaining_ttl(current->getExpireTime());
+                if (ttl_seconds != 0) {
+                    cache.put(key, current->getValue(), ttl_seconds);
+                }
+            }
+            _stat_list_hits.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (_negative_cache && _miss_filter->add(key)) { // 最近已经未命中过一次，放入负缓存
+            _negative_cache->put(key, true, NEGATIVE_CACHE_TTL);
+        }
+        _stat_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    _mtx.unlock_shared();
+
+    if (!expired.empty()) { // 惰性删除，一次加锁删除所有遇到的过期节点
+        delete_expired(expired);
+    }
+    return result;
+}
+
+/*
+ * 批量插入
+ * @param elements 要插入的键值对，顺序任意；已存在的键不覆盖，批内重复的键只插入第一个
+ * @param ttl_seconds 整批共用的过期时间
+ * @return 成功插入的元素个数，预写日志写出或刷盘失败时返回 WAL_COMMIT_FAILED（元素已插入）
+ * @remark 与 insert_element 的逻辑相同，但整批只加一次写锁：
+ *         按键排序后依次插入，每个键从上一个键的前驱继续查找（批内重复的键会找到刚插入的节点）；
+ *         预写日志在写锁内逐条追加，解锁后只等待最后一条落盘；插入的数据在写锁内放入缓存
+ */
+template <typename K, typename V, typename CachePolicy>
+int SkipListWithCache<K, V, CachePolicy>::multi_put(const std::vector<std::pair<K, V>>& elements, int ttl_seconds) {
+    std::vector<size_t> order(elements.size()); // 按键排序后的下标，键相同时保持原有顺序
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&elements](size_t a, size_t b) {
+        return elements[a].first < elements[b].first;
+    });
+
+    size_t inserted = 0; // 插入成功的元素个数
+    uint64_t wal_seq = 0; // 最后一条预写日志的序号
+
+    _mtx.lock(); // 独占加锁，整批只加一次
+
+    NodeWithTTL<K, V>* update[_max_level + 1]; // 上一个键在每层的前驱
+    for (int i = 0; i <= _max_level; i++) {
+        update[i] = _header;
+    }
+
+    std::unique_lock<std::mutex> wheel_lock(_wheel_mtx, std::defer_lock); // 时间轮锁，第一次用到时获取
+    for (size_t index : order) {
+        const K& key = elements[index].first;
+        find_predecessors(key, update);
+        NodeWithTTL<K, V>* current = update[0]->forward[0];
+        if (current != nullptr && current->getKey() == key) {
+            continue; // 已存在
+        }
+
+        int random_level = get_random_level();
+        if (random_level > _skip_list_level) { // 更高的层中前驱都是头节点，update 中已经是头节点
+            _skip_list_level = random_level;
+        }
+
+        NodeWithTTL<K, V>* inserted_node = create_node(key, elements[index].second, random_level, ttl_seconds);
+        for (int i = 0; i <= random_level; i++) {
+            inserted_node->forward[i] = update[i]->forward[i];
+            update[i]->forward[i] = inserted_node;
+        }
+        _element_count++;
+        inserted++;
+        cache.put(key, elements[index].second, ttl_seconds); // 与 insert_element 一样在写锁内插入缓存
+
+        if (ttl_seconds != PERMANENT_TTL) { // 登记到过期索引
+            if (_expiry_mode == ExpiryMode::WHEEL) {
+                if (!wheel_lock.owns_lock()) {
+                    wheel_lock.lock();
+                }
+                _expiry_wheel.schedule(key, inserted_node->getExpireTime());
+            } else {
+                _expiry_samples.add(key, inserted_node->getExpireTime());
+            }
+        }
+        if (_negative_cache) { // 在写锁内使负缓存失效
+            _negative_cache->remove(key);
+        }
+        if (_wal.is_open()) {
+            wal_seq = _wal.append_insert(key, elements[index].second, WriteAheadLog::expire_at_ms(ttl_seconds));
+        }
+    }
+    if (wheel_lock.owns_lock()) {
+        wheel_lock.unlock();
+    }
+
+    _mtx.unlock(); // 解锁
+
+    bool logged = wal_seq == 0 || _wal.commit(wal_seq); // 等最后一条落盘，之前的记录随之落盘
+
+    return logged ? (int)inserted : WAL_COMMIT_FAILED;
+}
+
+/*
+ * 删除元素
+ * @param key 键
+ * @return int 0 删除成功或键不存在，WAL_COMMIT_FAILED 已删除但预写日志写出或刷盘失败
+ * @remark 删除元素
+ */
+template <typename K, typename V, typename CachePolicy>
+int SkipListWithCache<K, V, CachePolicy>::delete_element(const K& key) { 
+    std::cout << "delete_element-----------------" << std::endl;
+    uint64_t wal_seq = 0; // 预写日志序号
+    _mtx.lock(); // 独占加锁
+
+    NodeWithTTL<K, V>* current = this->_header; // 当前节点
+    NodeWithTTL<K, V>* update[_max_level + 1]; // 更新节点
+    memset(update, 0, sizeof(NodeWithTTL<K, V>*) * (_max_level + 1));
+
+    for (int i = _skip_list_level; i >= 0; i--) { 
+        while (current->forward[i] != nullptr && current->forward[i]->getKey() < key) {
+            current = current->forward[i];
+        }
+        update[i] = current;
+    }
+    current = current->forward[0];
+
+    if (current != nullptr && current->getKey() == key) { 
+        for (int i = 0; i <= _skip_list_level; i++) { 
+            if (update[i]->forward[i] != current) {
+                break;
+            }
+            update[i]->forward[i] = current->forward[i];
+        }
+
+        while (_skip_list_level > 0 && _header->forward[_skip_list_level] == nullptr) {
+            _skip_list_level--;
+        }
+
+        std::cout << "Successfully deleted key: " << key << std::endl;
+        destroy_node(current); // 查找者持有共享锁，此时不会有其他线程访问该节点
+        _element_count--; // 元素个数减1
+        _delete_version++; // 游标保存的节点可能就是它
+        if (_expiry_mode == ExpiryMode::SAMPLING) {
+            _expiry_samples.remove(key);
+        }
+
+        wal_seq = _wal.is_open() ? _wal.append_delete(key) : 0;
+    }
+
+    _mtx.unlock(); // 解锁
+
+    bool logged = wal_seq == 0 || _wal.commit(wal_seq);
+
+    cache.remove(key);// 删除缓存中的数据
+
+    return logged ? 0 : WAL_COMMIT_FAILED;
+};
+
+/*
+ * 数据持久化
+ * @return void
+ * @remark 在调用线程中同步写出快照，遍历期间持有共享锁，写线程会被阻塞到快照写完；
+ *         不希望阻塞写线程时使用 bgsave()
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::dump_file() {
+    std::string filename = snapshot_filename(); // 包含时间戳的文件名
+
+    std::cout << "dump_file-----------------" << std::endl;
+    _file_mtx.lock(); // 加锁
+
+    _mtx.lock_shared(); // 遍历期间禁止插入、删除
+    uint64_t wal_segment = _wal.is_open() ? _wal.rotate() : 0; // 之后的修改写入新段，快照覆盖了旧段中的全部修改
+    uint64_t records = 0;
+    bool ok = write_snapshot(filename, records);
+    _mtx.unlock_shared(); // 解锁
+
+    if (ok && wal_segment != 0) {
+        _wal.remove_segments_before(wal_segment); // 快照和目录项都已落盘，旧的日志段不再需要
+    }
+    if (ok) {
+        std::cout << "dumped " << records << " records to " << filename << std::endl;
+    }
+
+    _file_mtx.unlock(); // 解锁
+    return;
+}
+
+/*
+ * 后台持久化
+ * @return bool 是否成功启动（已有后台持久化在进行时返回 false）
+ * @remark 只在 fork() 的瞬间持有共享锁，子进程得到跳表在这一时刻的写时复制副本，
+ *         在子进程中遍历并写出快照，父进程中的写线程不受影响。
+ *         子进程只有调用 fork 的这一个线程，不能访问其他线程可能持有的锁（缓存锁、标准输出等），
+ *         因此子进程中只遍历跳表并写文件，结束后用 _exit 退出
+ */
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::bgsave() {
+    bool expected = false;
+    if (!_bgsave_running.compare_exchange_strong(expected, true)) {
+        std::cerr << "Background save already in progress" << std::endl;
+        return false;
+    }
+    if (_bgsave_thread.joinable()) { // 上一次的等待线程已经结束
+        _bgsave_thread.join();
+    }
+
+    std::string filename = snapshot_filename();
+
+    _file_mtx.lock(); // 加锁
+    _mtx.lock_shared(); // 阻止修改，使 fork 得到一致的副本
+    uint64_t wal_segment = _wal.is_open() ? _wal.rotate() : 0;
+    pid_t pid = fork();
+    if (pid == 0) { // 子进程
+        uint64_t records = 0;
+        _exit(write_snapshot(filename, records) ? 0 : 1);
+    }
+    _mtx.unlock_shared(); // 解锁
+    _file_mtx.unlock(); // 解锁
+
+    if (pid < 0) {
+        std::cerr << "Failed to fork: " << strerror(errno) << std::endl;
+        _bgsave_running = false;
+        return false;
+    }
+
+    // 等待子进程结束，子进程只有在快照和目录项都已落盘后才以 0 退出，此时才删除快照已经覆盖的日志段
+    _bgsave_thread = std::thread([this, pid, wal_segment, filename]() {
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            if (wal_segment != 0) {
+                _wal.remove_segments_before(wal_segment);
+            }
+            std::cout << "background save finished: " << filename << std::endl;
+        } else {
+            std::cerr << "Background save failed: " << filename << std::endl;
+        }
+        _bgsave_running = false;
+    });
+    return true;
+}
+
+/*
+ * 等待后台持久化结束
+ * @return void
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::wait_bgsave() {
+    if (_bgsave_thread.joinable()) {
+        _bgsave_thread.join();
+    }
+}
+
+/*
+ * 生成快照文件名
+ * @return std::string 形如 store/dumpFile_cache_yyyyMMddHHmmss，open_wal 之后形如 store/wal_cache_snapshot_yyyyMMddHHmmss
+ */
+template <typename K, typename V, typename CachePolicy>
+std::string SkipListWithCache<K, V, CachePolicy>::snapshot_filename() {
+    // 获取当前时间并格式化 "yyyyMMddHHmmss" 格式
+    auto now = std::chrono::system_clock::now();
+    std::time_t now_c = std::chrono::system_clock::to_time_t(now); // 转换为time_t
+    std::tm now_tm;
+    localtime_r(&now_c, &now_tm); // 转换为tm，后台线程也会调用，使用可重入版本
+
+    char time_str[20]; // 用于保存格式化后的时间字符串
+    std::strftime(time_str, sizeof(time_str), "%Y%m%d%H%M%S", &now_tm); // 格式化时间字符串
+
+    return _snapshot_base + "_" + std::string(time_str);
+}
+
+/*
+ * 遍历跳表写出快照
+ * @param filename 快照文件名
+ * @param records 输出，写出的记录数
+ * @return bool 是否成功
+ * @remark 调用者需保证遍历期间跳表不被修改（持有共享锁，或在 fork 出的子进程中）；
+ *         不输出到标准输出，过期的节点不写出
+ */
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::write_snapshot(const std::string& filename, uint64_t& records) {
+    SnapshotWriter writer; // 二进制快照，每条记录带剩余过期秒数，格式见 snapshot.h
+    if (!writer.open(filename, SNAPSHOT_FLAG_TTL)) {
+        return false;
+    }
+
+    NodeWithTTL<K, V>* node = this->_header->forward[0]; // 当前节点
+    while (node != nullptr) { 
+        if (!is_expired(node->getExpireTime())) {
+            int ttl = node->getExpireTime() == std::chrono::steady_clock::time_point::max() ? PERMANENT_TTL : node->getRemainingTime();
+            writer.append(node->getKey(), node->getValue(), node->node_level, ttl);
+        }
+        node = node->forward[0];
+    }
+
+    records = writer.record_count();
+    return writer.close(); // 写出剩余数据块并回填文件头
+}
+
+/*
+ * 从文件中加载数据
+ * @return void
+ * @remark 加载 DEFAULT_STORE_FILE
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::load_file() { 
+    load_file(DEFAULT_STORE_FILE);
+}
+
+/*
+ * 从指定文件中加载数据
+ * @param path 文件路径
+ * @return void
+ * @remark 根据文件头的魔数自动识别二进制快照或旧版的 key:value:ttl 文本格式
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::load_file(const std::string& path) { 
+
+    _file_mtx.lock(); // 加锁
+    std::cout << "Loading data from file..." << std::endl;
+
+    if (is_snapshot_file(path)) {
+        SnapshotReader reader;
+        if (reader.open(path)) {
+            // 不带 SNAPSHOT_FLAG_TTL 的快照（如 SkipList::dump_file 写出的）没有过期时间，ttl 为 0，按永不过期插入
+            bool with_ttl = (reader.header().flags & SNAPSHOT_FLAG_TTL) != 0;
+            // 多线程解析数据块，按文件顺序逐条插入
+            uint64_t loaded = snapshot_parallel_read<K, V>(reader, [this, with_ttl](SnapshotRecord<K, V>& record) {
+                insert_element(record.key, record.value, with_ttl ? record.ttl : PERMANENT_TTL); // 插入元素
+            });
+            if (reader.corrupted()) {
+                std::cerr << "Snapshot partially loaded: " << loaded << "/" << reader.header().record_count << " records" << std::endl;
+            }
+        }
+        _file_mtx.unlock(); // 解锁
+        return;
+    }
+
+    if constexpr (std::is_same<K, std::string>::value && std::is_same<V, std::string>::value) { // 旧版文本格式只支持字符串键值
+        _file_reader.open(path); // 打开文件
+
+        if (!_file_reader.is_open()) { 
+            std::cerr << "Failed to open file: " << path << std::endl;
+            _file_mtx.unlock(); // 解锁
+            return;
+        }
+
+        std::string line; // 行数据
+        K* key = new K(); // 键
+        V* value = new V(); // 值
+        std::string* expiration_time = new std::string(); // 剩余时间 
+
+        while (getline(_file_reader, line)) { 
+            get_key_value_from_string(line, key, value, expiration_time); // 从字符串中获取键值对
+            if (key->empty() || value->empty() || expiration_time->empty()) {
+                continue;
+            }
+
+            insert_element(*key, *value, stoi(*expiration_time)); // 插入元素
+            std::cout << "key: " << *key << ", " << "value: " << *value << ", " << "expiration_time: " << *expiration_time << std::endl;
+        } 
+
+        delete key; // 删除键
+        delete value; // 删除值
+        delete expiration_time; // 删除剩余时间
+
+        _file_reader.close(); // 关闭文件
+    } else {
+        std::cerr << (std::ifstream(path).is_open() ? "Unsupported file format: " : "Failed to open file: ") << path << std::endl;
+    }
+    _file_mtx.unlock(); // 解锁
+
+    return;
+}
+
+/*
+ * 查找最新的快照文件
+ * @param base 快照文件名前缀
+ * @return std::string 文件名中时间戳最大的 <base>_<时间>，没有时返回空串
+ */
+template <typename K, typename V, typename CachePolicy>
+std::string SkipListWithCache<K, V, CachePolicy>::latest_snapshot(const std::string& base) {
+    std::string latest;
+    std::filesystem::path base_path(base);
+    std::filesystem::path dir = base_path.has_parent_path() ? base_path.parent_path() : std::filesystem::path(".");
+    std::string prefix = base_path.filename().string() + "_";
+    std::string newest_name;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        std::string name = entry.path().filename().string();
+        // 时间戳为 yyyyMMddHHmmss，按字典序比较即可；只接受 14 位数字的后缀，跳过写了一半的 .tmp 文件
+        if (name.size() != prefix.size() + 14 || name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        if (std::all_of(name.begin() + prefix.size(), name.end(), ::isdigit) && name > newest_name) {
+            newest_name = name;
+            latest = entry.path().string();
+        }
+    }
+    return latest;
+}
+
+/*
+ * 打开预写日志
+ * @param base 日志段文件路径前缀
+ * @param policy 刷盘策略
+ * @param interval_ms EVERY_N_MS 策略的刷盘间隔
+ * @return bool 是否成功
+ * @remark 恢复流程：加载最新的快照，再按顺序重放所有日志段，最后打开新的日志段记录之后的修改。
+ *         快照文件名前缀为 base + WAL_SNAPSHOT_SUFFIX，之后 dump_file、bgsave 都写在这个前缀下，
+ *         只有它们执行时才会删除旧的日志段；没有快照时从空表开始重放，不加载其他前缀的快照。
+ *         日志段中可能包含快照已经覆盖的修改，但 insert_element 在键已存在时不做任何修改，
+ *         按原顺序重放全部插入、删除、清空后，每个键的最终状态与最后一次操作一致，因此重放是安全的
+ */
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::open_wal(const std::string& base, WalSyncPolicy policy, int interval_ms) {
+    close_wal();
+    _snapshot_base = base + WAL_SNAPSHOT_SUFFIX;
+    std::string snapshot = latest_snapshot(_snapshot_base);
+    if (!snapshot.empty()) {
+        load_file(snapshot);
+    }
+
+    uint64_t replayed = WriteAheadLog::replay<K, V>(base, [this](uint8_t op, const K& key, const V& value, int64_t expire_at_ms) {
+        int ttl = WriteAheadLog::ttl_seconds(expire_at_ms);
+        if (op == WAL_OP_CLEAR) {
+            clear();
+        } else if (op == WAL_OP_DELETE || ttl == 0) { // 已经过期的插入等同于删除
+            delete_element(key);
+        } else {
+            insert_element(key, value, ttl);
+        }
+    });
+    std::cout << "replayed " << replayed << " wal records" << std::endl;
+
+    return _wal.open(base, policy, interval_ms);
+}
+
+/*
+ * 关闭预写日志
+ * @return void
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::close_wal() {
+    _wal.close();
+}
+
+/*
+ * 验证字符串的合法性
+ * @param str 字符串
+ * @return bool
+ * @remark 验证字符串的合法性
+ */
+template <typename K, typename V, typename CachePolicy>
+bool SkipListWithCache<K, V, CachePolicy>::is_valid_string(const std::string& str) { 
+    // 如果字符串str非空，并且字符串中包含分隔符delimiter，那么返回true
+    // find()函数返回字符串中第一个匹配的位置，如果没有找到匹配的位置，则返回std::string::npos
+    if (!str.empty()&& str.find(delimiter) != std::string::npos) { 
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * 从字符串中获取键值对
+ * @param line 字符串
+ * @param key 键
+ * @param value 值
+ * @param expiration_time 剩余时间
+ * @return void
+ * @remark 从字符串中获取键值对
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::get_key_value_from_string(const std::string& str, std::string* key, std::string* value, std::string* expiration_time) { 
+    
+    if (!is_valid_string(str)) { 
+        return;
+    }
+    
+    size_t pos1 = str.find(delimiter); // 查找第一个分隔符的位置
+    size_t pos2 = str.find(delimiter, pos1 + 1); // 查找第二个分隔符的位置
+
+
+    *key = str.substr(0, pos1); // 获取键
+    *value = str.substr(pos1 + 1, pos2 - pos1 - 1); // 获取值
+    *expiration_time = str.substr(pos2 + 1); // 获取剩余时间
+
+    return;
+}
+
+/*
+ * 打印跳表
+ * @return void
+ * @remark 打印跳表
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::display_skiplist() {
+    
+    std::shared_lock<std::shared_mutex> lock(_mtx); // 共享加锁
+    std::cout << "\n*****Skip List*****"<<"\n"; 
+    for (int i = 0; i <= _skip_list_level; i++) {
+        NodeWithTTL<K, V> *node = this->_header->forward[i]; 
+        std::cout << "Level " << i << ": ";
+        while (node != NULL) {
+            std::cout << node->getKey() << ":" << node->getValue() << ";";
+            node = node->forward[i];
+        }
+        std::cout << std::endl;
+    }
+}
+
+/*
+ * 打印缓存
+ * @return void
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::display_cache() {
+    cache.display();
+}
+
+/*
+ * 设置是否 read-through
+ * @param enabled 跳表命中时是否把数据放入缓存
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::set_read_through(bool enabled) {
+    _read_through = enabled;
+}
+
+/*
+ * 开启负缓存
+ * @param capacity 负缓存的容量，最近未命中过滤器记录同样数量的键
+ * @remark 负缓存和过滤器的指针不加锁访问，需要在并发查找开始之前调用
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::enable_negative_cache(size_t capacity) {
+    _negative_cache.reset(new ShardedLRUCache<K, bool>(capacity));
+    _miss_filter.reset(new RecentBloomFilter<K>(capacity));
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::disable_negative_cache() {
+    _negative_cache.reset();
+    _miss_filter.reset();
+}
+
+/*
+ * 查找统计
+ * @return CacheStats 各计数器的快照
+ */
+template <typename K, typename V, typename CachePolicy>
+CacheStats SkipListWithCache<K, V, CachePolicy>::cache_stats() const {
+    CacheStats stats;
+    stats.lookups = _stat_lookups.load(std::memory_order_relaxed);
+    stats.cache_hits = _stat_cache_hits.load(std::memory_order_relaxed);
+    stats.negative_hits = _stat_negative_hits.load(std::memory_order_relaxed);
+    stats.list_hits = _stat_list_hits.load(std::memory_order_relaxed);
+    stats.misses = _stat_misses.load(std::memory_order_relaxed);
+    return stats;
+}
+
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::reset_cache_stats() {
+    _stat_lookups.store(0, std::memory_order_relaxed);
+    _stat_cache_hits.store(0, std::memory_order_relaxed);
+    _stat_negative_hits.store(0, std::memory_order_relaxed);
+    _stat_list_hits.store(0, std::memory_order_relaxed);
+    _stat_misses.store(0, std::memory_order_relaxed);
+}
+
+/*
+ * 周期性数据持久化策略
+ * @param kv_store kv存储
+ * @return void
+ * @remark 周期性数据持久化策略
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::periodic_save(int interval_seconds) {
+    stop_periodic_save(); // 如果已经在运行，先停止旧的线程
+    _keep_running = true;
+
+    // 启动后台线程
+    _save_thread = std::thread([this, interval_seconds]() {
+        while (_keep_running) { 
+            // 每隔interval_seconds秒执行一次，停止时立即被唤醒
+            std::unique_lock<std::mutex> lock(_bg_mtx);
+            if (_bg_cv.wait_for(lock, std::chrono::seconds(interval_seconds), [this]() { return !_keep_running; })) {
+                break;
+            }
+            lock.unlock();
+            bgsave(); // 后台持久化，不阻塞写线程
+        }
+    });
+};
+
+/*
+ * 停止周期性数据持久化策略
+ * @return void
+ * @remark 停止周期性数据持久化策略
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::stop_periodic_save() {
+    {
+        std::lock_guard<std::mutex> lock(_bg_mtx);
+        _keep_running = false; // 停止后台线程
+    }
+    _bg_cv.notify_all();
+    if (_save_thread.joinable()) {
+        _save_thread.join();
+    }
+};
+
+/*
+ * 周期性删除过期数据
+ * @param kv_store kv存储
+ * @return void
+ * @remark 周期性删除过期数据
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::periodic_cleanup(int interval_seconds) {
+    stop_periodic_cleanup(); // 如果已经在运行，先停止旧的线程
+    _running_cleanup = true; // 运行清理
+
+    _cleanup_thread = std::thread([this, interval_seconds]() {
+        while (_running_cleanup) { 
+            remove_skiplist_expired(); // 删除过期数据
+            // 每隔interval_seconds秒执行一次，停止时立即被唤醒
+            std::unique_lock<std::mutex> lock(_bg_mtx);
+            _bg_cv.wait_for(lock, std::chrono::seconds(interval_seconds), [this]() { return !_running_cleanup; });
+        }
+    });
+};
+
+/*
+ * 停止周期性删除过期数据
+ * @return void
+ * @remark 停止周期性删除过期数据
+ */
+template <typename K, typename V, typename CachePolicy>
+void SkipListWithCache<K, V, CachePolicy>::stop_periodic_cleanup() {
+    {
+        std::lock_guard<std::mutex> lock(_bg_mtx);
+        _running_cleanup = false; // 停止清理
+    }
+    _bg_cv.notify_all();
+    if (_cleanup_thread.joinable()) {
+        _cleanup_thread.join();
+    }
+};
@@ -0,0 +1,400 @@
+#ifndef SKIPLIST_LOCKFREE_H
+#define SKIPLIST_LOCKFREE_H
+
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <functional>
+#include "epoch.h"
+#include "level_generator.h"
+
+/* ************************************************************************
+> 无锁跳表的节点类
+> 成员属性：
+    > forward：原子指针数组，指针最低位作为删除标记（节点的 forward[i] 被标记，表示它在第 i 层被逻辑删除）
+    > node_level：节点的层数
+    > refs：插入线程和删除线程各持有一份引用，最后释放引用的线程负责把节点交给纪元回收器
+> 说明：
+    > 节点在堆上分配，对齐至少为 2，因此指针最低位一定为 0，可以用来存放标记
+ ************************************************************************/
+
+template <typename K, typename V>
+class LockFreeNode {
+
+public:
+    LockFreeNode(const K& k, const V& v, int level);
+
+    ~LockFreeNode();
+
+    const K& getKey() const;
+
+    const V& getValue() const;
+
+    std::atomic<uintptr_t>* forward; // 带标记位的后继指针数组
+
+    int node_level; // 节点的层数
+
+    std::atomic<int> refs; // 插入线程 + 删除线程
+
+private:
+    K key;
+    V value;
+};
+
+template <typename K, typename V>
+LockFreeNode<K, V>::LockFreeNode(const K& k, const V& v, int level) : node_level(level), refs(2), key(k), value(v) {
+    this->forward = new std::atomic<uintptr_t>[level + 1];
+    for (int i = 0; i <= level; i++) {
+        forward[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+template <typename K, typename V>
+LockFreeNode<K, V>::~LockFreeNode() {
+    delete[] forward;
+}
+
+template <typename K, typename V>
+const K& LockFreeNode<K, V>::getKey() const {
+    return key;
+}
+
+template <typename K, typename V>
+const V& LockFreeNode<K, V>::getValue() const {
+    return value;
+}
+
+/************************************************************************
+> 无锁跳表类的实现（参考 Fraser / Herlihy-Shavit 的 CAS 链接 + 标记删除）
+> 成员属性：
+    > _max_level：跳表中允许的最大层数
+    > _skip_list_level：出现过的最大层数，只增不减，用作查找的起始层
+    > _header：头节点
+    > _element_count：元素个数
+    > _reclaimer：纪元回收器，保证读线程持有的节点不会被提前释放
+> public方法：
+    > insert_element / search_element / delete_element：与 SkipList 相同的接口，全部无锁
+    > display_list：打印跳表
+    > size：返回元素个数
+> private方法：
+    > find：定位每一层的前驱和后继，顺便摘除路过的已标记节点
+    > release_node：释放一份节点引用，最后一个释放者负责回收节点
+> 插入过程：
+    > 1. 在第 0 层 CAS 链接成功即视为插入成功（线性化点）
+    > 2. 自底向上逐层 CAS 链接；若节点在此期间被删除，停止链接
+> 删除过程：
+    > 1. 自顶向下标记每一层的 forward 指针
+    > 2. 第 0 层标记成功的线程获得删除权（线性化点）
+    > 3. 再次 find 把节点从各层摘除，之后交给纪元回收器
+ ************************************************************************/
+
+template <typename K, typename V>
+class LockFreeSkipList {
+
+public:
+    LockFreeSkipList(int);
+    ~LockFreeSkipList();
+    int get_random_level(); // 生成随机层数，使用线程本地的随机数发生器，避免 rand() 的全局锁
+    int insert_element(const K&, const V&); // 插入元素，返回 1 表示已存在，0 表示插入成功
+    bool search_element(const K&); // 查找元素
+    void delete_element(const K&); // 删除元素
+    void display_list(); // 显示跳表
+    int size(); // 返回元素个数
+
+private:
+    using Node = LockFreeNode<K, V>;
+
+    static Node* get_ptr(uintptr_t v) { return reinterpret_cast<Node*>(v & ~uintptr_t(1)); }
+    static bool is_marked(uintptr_t v) { return (v & 1) != 0; }
+    static uintptr_t make_ref(Node* p, bool mark = false) { return reinterpret_cast<uintptr_t>(p) | (mark ? 1 : 0); }
+
+    bool find(const K& key, Node** preds, Node** succs); // 查找前驱与后继
+    void release_node(Node* node); // 释放一份节点引用
+    static void free_node(void* ctx, void* ptr); // 纪元回收器回调
+
+    int _max_level; // 跳表的最大层数
+
+    LevelGenerator _level_generator; // 随机层数生成器，p = 1/2
+
+    std::atomic<int> _skip_list_level; // 出现过的最大层数
+
+    Node* _header; // 头节点
+
+    std::atomic<int> _element_count; // 元素个数
+
+    EpochReclaimer _reclaimer; // 纪元回收器
+};
+
+/**
+ * 构造函数
+ * @param max_level 跳表的最大层数
+ */
+template <typename K, typename V>
+LockFreeSkipList<K, V>::LockFreeSkipList(int max_level) : _max_level(max_level), _skip_list_level(0), _element_count(0) {
+    K k{};
+    V v{};
+    this->_header = new Node(k, v, max_level);
+}
+
+/**
+ * 析构函数
+ * @description 析构时不再有其他线程访问，先回收所有已摘除的节点，再逐个释放链表中剩余的节点
+ */
+template <typename K, typename V>
+LockFreeSkipList<K, V>::~LockFreeSkipList() {
+    _reclaimer.reclaim_all();
+
+    Node* current = get_ptr(_header->forward[0].load(std::memory_order_relaxed));
+    while (current != nullptr) {
+        Node* next = get_ptr(current->forward[0].load(std::memory_order_relaxed));
+        delete current;
+        current = next;
+    }
+    delete _header;
+}
+
+/**
+ * 生成随机层数
+ * @return int 范围 [0, _max_level]，第 i 层出现的概率为 1/2^i，同时不超过 ceil(log2 n)（n 为插入后的元素个数）
+ * @description 使用 LevelGenerator 的线程本地随机数，多个线程并发插入时互不干扰
+ */
+template <typename K, typename V>
+int LockFreeSkipList<K, V>::get_random_level() {
+    int cap = _level_generator.level_cap(_element_count.load(std::memory_order_relaxed) + 1);
+    return _level_generator.next(cap < _max_level ? cap : _max_level);
+}
+
+/**
+ * 查找 key 在每一层的前驱和后继
+ * @param key 要查找的键
+ * @param preds 输出，每一层中最后一个键小于 key 的节点
+ * @param succs 输出，每一层中第一个键不小于 key 的节点
+ * @return bool 第 0 层的后继是否就是 key
+ * @description 遍历时遇到已标记的节点就用 CAS 把它摘除，CAS 失败说明前驱也发生了变化，从头重试
+ */
+template <typename K, typename V>
+bool LockFreeSkipList<K, V>::find(const K& key, Node** preds, Node** succs) {
+retry:
+    Node* pred = _header;
+    for (int i = _max_level; i >= 0; i--) {
+        Node* current = get_ptr(pred->forward[i].load(std::memory_order_acquire));
+        while (current != nullptr) {
+            uintptr_t succ = current->forward[i].load(std::memory_order_acquire);
+            // 摘除被标记的节点
+            while (is_marked(succ)) {
+                uintptr_t expected = make_ref(current);
+                if (!pred->forward[i].compare_exchange_strong(expected, make_ref(get_ptr(succ)),
+                                                              std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    goto retry;
+                }
+                current = get_ptr(succ);
+                if (current == nullptr) {
+                    break;
+                }
+                succ = current->forward[i].load(std::memory_order_acquire);
+            }
+            if (current == nullptr || !(current->getKey() < key)) {
+                break;
+            }
+            pred = current;
+            current = get_ptr(succ);
+        }
+        preds[i] = pred;
+        succs[i] = current;
+    }
+    return succs[0] != nullptr && succs[0]->getKey() == key;
+}
+
+/**
+ * 插入元素
+ * @param key 要插入的元素的键
+ * @param value 要插入的元素的值
+ * @return 如果元素已存在，返回 1；插入成功返回 0
+ */
+template <typename K, typename V>
+int LockFreeSkipList<K, V>::insert_element(const K& key, const V& value) {
+    EpochReclaimer::Guard guard = _reclaimer.pin();
+
+    Node* preds[_max_level + 1];
+    Node* succs[_max_level + 1];
+    int top_level = get_random_level();
+    Node* inserted_node = nullptr;
+
+    // 1. 在第 0 层链接
+    while (true) {
+        if (find(key, preds, succs)) {
+            if (inserted_node != nullptr) {
+                delete inserted_node; // 从未被其他线程看见，可以直接释放
+            }
+            return 1;
+        }
+        if (inserted_node == nullptr) {
+            inserted_node = new Node(key, value, top_level);
+        }
+        for (int i = 0; i <= top_level; i++) {
+            inserted_node->forward[i].store(make_ref(succs[i]), std::memory_order_relaxed);
+        }
+        uintptr_t expected = make_ref(succs[0]);
+        if (preds[0]->forward[0].compare_exchange_strong(expected, make_ref(inserted_node),
+                                                         std::memory_order_release, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    _element_count.fetch_add(1, std::memory_order_relaxed);
+
+    int current_level = _skip_list_level.load(std::memory_order_relaxed);
+    while (current_level < top_level &&
+           !_skip_list_level.compare_exchange_weak(current_level, top_level, std::memory_order_relaxed)) {
+    }
+
+    // 2. 自底向上链接其余各层
+    for (int i = 1; i <= top_level; i++) {
+        while (true) {
+            uintptr_t next = inserted_node->forward[i].load(std::memory_order_acquire);
+            if (is_marked(next)) { // 节点已被删除，停止链接
+                goto done;
+            }
+            if (get_ptr(next) != succs[i] &&
+                !inserted_node->forward[i].compare_exchange_strong(next, make_ref(succs[i]),
+                                                                   std::memory_order_release, std::memory_order_relaxed)) {
+                continue;
+            }
+            uintptr_t expected = make_ref(succs[i]);
+            if (preds[i]->forward[i].compare_exchange_strong(expected, make_ref(inserted_node),
+                                                             std::memory_order_release, std::memory_order_relaxed)) {
+                break;
+            }
+            // 前驱发生变化，重新定位；如果节点已经不在第 0 层，说明被删除了
+            find(key, preds, succs);
+            if (succs[0] != inserted_node) {
+                goto done;
+            }
+        }
+    }
+
+done:
+    release_node(inserted_node);
+    return 0;
+}
+
+/**
+ * 查找元素
+ * @param key 要查找的元素的键
+ * @return bool 如果找到返回true，否则返回false
+ * @description 只读不写，跳过已标记的节点，不参与摘除，也不会被写线程阻塞
+ */
+template <typename K, typename V>
+bool LockFreeSkipList<K, V>::search_element(const K& key) {
+    EpochReclaimer::Guard guard = _reclaimer.pin();
+
+    Node* pred = _header;
+    Node* current = nullptr;
+    for (int i = _skip_list_level.load(std::memory_order_relaxed); i >= 0; i--) {
+        current = get_ptr(pred->forward[i].load(std::memory_order_acquire));
+        while (current != nullptr) {
+            uintptr_t succ = current->forward[i].load(std::memory_order_acquire);
+            if (is_marked(succ)) { // 已被删除，跳过
+                current = get_ptr(succ);
+                continue;
+            }
+            if (!(current->getKey() < key)) {
+                break;
+            }
+            pred = current;
+            current = get_ptr(succ);
+        }
+    }
+    return current != nullptr && current->getKey() == key;
+}
+
+/**
+ * 删除元素
+ * @param key 要删除的元素的键
+ * @return void
+ */
+template <typename K, typename V>
+void LockFreeSkipList<K, V>::delete_element(const K& key) {
+    EpochReclaimer::Guard guard = _reclaimer.pin();
+
+    Node* preds[_max_level + 1];
+    Node* succs[_max_level + 1];
+
+    if (!find(key, preds, succs)) {
+        return;
+    }
+    Node* victim = succs[0];
+
+    // 1. 自顶向下标记第 1 层及以上
+    for (int i = victim->node_level; i >= 1; i--) {
+        uintptr_t next = victim->forward[i].load(std::memory_order_acquire);
+        while (!is_marked(next) &&
+               !victim->forward[i].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        }
+    }
+
+    // 2. 标记第 0 层，成功者获得删除权
+    uintptr_t next = victim->forward[0].load(std::memory_order_acquire);
+    while (true) {
+        if (is_marked(next)) { // 其他线程已经删除
+            return;
+        }
+        if (victim->forward[0].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            break;
+        }
+    }
+    _element_count.fetch_sub(1, std::memory_order_relaxed);
+
+    // 3. 物理摘除并回收
+    release_node(victim);
+}
+
+/**
+ * 释放一份节点引用
+ * @param node 节点
+ * @description 插入线程和删除线程都结束对节点的操作后，节点的所有层都已被标记，
+ *              再做一次 find 即可保证它从每一层都被摘除，随后交给纪元回收器
+ */
+template <typename K, typename V>
+void LockFreeSkipList<K, V>::release_node(Node* node) {
+    if (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    Node* preds[_max_level + 1];
+    Node* succs[_max_level + 1];
+    find(node->getKey(), preds, succs);
+    _reclaimer.retire(node, &LockFreeSkipList<K, V>::free_node, this);
+}
+
+template <typename K, typename V>
+void LockFreeSkipList<K, V>::free_node(void* ctx, void* ptr) {
+    (void)ctx;
+    delete static_cast<Node*>(ptr);
+}
+
+// Display skip list
+template <typename K, typename V>
+void LockFreeSkipList<K, V>::display_list() {
+    EpochReclaimer::Guard guard = _reclaimer.pin();
+
+    std::cout << "\n*****Lock-free Skip List*****" << "\n";
+    for (int i = _skip_list_level.load(); i >= 0; i--) {
+        Node* node = get_ptr(_header->forward[i].load(std::memory_order_acquire));
+        std::cout << "Level " << i << ": _header ";
+        while (node != nullptr) {
+            uintptr_t next = node->forward[i].load(std::memory_order_acquire);
+            if (!is_marked(next)) {
+                std::cout << node->getKey() << ":" << node->getValue() << " ";
+            }
+            node = get_ptr(next);
+        }
+        std::cout << std::endl;
+    }
+}
+
+template <typename K, typename V>
+int LockFreeSkipList<K, V>::size() {
+    return _element_count.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef SKIPLIST_UNROLLED_H
+#define SKIPLIST_UNROLLED_H
+
+#include <iostream>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "node_arena.h"
+#include "level_generator.h"
+#include "block_probe.h"
+
+#define UNROLLED_BLOCK_SIZE 16 // 每个节点默认容纳的键数
+
+/* ************************************************************************
+> 展开跳表（Unrolled / B-skiplist）的节点
+> 一个节点存放一小块有序的键值对，块与 forward 数组在内存池中一次分配、连续存放：
+    [ count | node_level | forward | keys[0..B) | values[0..B) ][ forward[0..level] ]
+> 成员属性：
+    > keys：块内升序排列的键，只有前 count 个有效。keys[0] 是节点在各层链表中排序所用的键
+    > values：与 keys 一一对应的值
+    > count：块内的键数，1 <= count <= B（头节点为 0）
+    > node_level：节点的层数
+    > forward：指针数组，指向内存池中紧跟在节点之后的空间
+> 相邻节点的键区间不重叠：前一个节点的所有键都小于后一个节点的 keys[0]
+> 查找先按 keys[0] 在各层前进到最后一个 keys[0] <= key 的节点，再在块内查找（block_probe.h），
+  键连续存放，块内的比较只访问一两个缓存行，不再像 Node 那样每比较一个键跳一次指针；
+  int 键在块内用 SIMD 一次比较一组键，其它类型二分查找
+ ************************************************************************/
+
+template <typename K, typename V, int B>
+struct UnrolledNode {
+    UnrolledNode(int level, UnrolledNode<K, V, B>** links);
+
+    int count; // 块内的键数
+    int node_level; // 节点的层数
+    UnrolledNode<K, V, B>** forward; // 每一层的后继节点
+    K keys[B]; // 块内有序的键
+    V values[B]; // 与 keys 对应的值
+};
+
+/**
+ * 构造函数
+ * @param level 节点层数
+ * @param links 至少能容纳 level + 1 个指针的内存，一般是内存池中紧跟在节点之后的空间
+ */
+template <typename K, typename V, int B>
+UnrolledNode<K, V, B>::UnrolledNode(int level, UnrolledNode<K, V, B>** links) : count(0), node_level(level), forward(links) {
+    for (int i = 0; i <= level; i++) {
+        forward[i] = nullptr;
+    }
+}
+
+/************************************************************************
+> 展开跳表类的实现，接口与 SkipList 的插入、查找、删除、范围读取相同
+> 与 SkipList 的区别：
+    > 节点数约为元素个数的 1/B ~ 2/B，层数和查找路径上的指针跳转随之减少，每个元素分摊的指针也更少
+    > 插入时块满了从中间分裂，新节点取后一半的键并随机生成层数；
+      要插入的键大于块内所有键时不分裂原块的内容，新节点只放这个键，顺序插入时块是满的
+    > 删除时块变空才摘除节点，不与相邻的块合并
+    > 读写锁保护：查找、范围读取共享加锁，插入、删除独占加锁（SkipList 的查找是无锁的）
+> 成员属性：
+    > _max_level：允许的最大层数，构造时传入 AUTO_MAX_LEVEL 则取 LEVEL_GENERATOR_MAX_LEVEL
+    > _level_generator：随机层数生成器，层数上限按节点个数计算
+    > _header：头节点，不存放键
+    > _skip_list_level：当前层数
+    > _element_count：元素个数
+    > _node_count：节点个数
+    > _arena：节点内存池
+    > _mtx：读写锁
+> public方法：
+    > insert_element：插入元素，已存在时返回 1
+    > search_element：查找元素
+    > delete_element：删除元素
+    > scan：按键的顺序读取 [start, end) 内最多 limit 个元素
+    > display_list：按层打印每个节点的键块
+    > clear：清空
+    > size：元素个数
+    > memory_usage：节点占用的内存
+> private方法：
+    > find_block：最后一个 keys[0] 不大于 key 的节点，没有时返回头节点
+    > create_node / destroy_node：在内存池中创建、销毁节点
+ ************************************************************************/
+
+template <typename K, typename V, int B = UNROLLED_BLOCK_SIZE>
+class UnrolledSkipList {
+    static_assert(B >= 2, "a block must hold at least two keys");
+
+public:
+    using NodeType = UnrolledNode<K, V, B>;
+
+    UnrolledSkipList(int max_level = AUTO_MAX_LEVEL, LevelProbability p = LevelProbability::HALF);
+    ~UnrolledSkipList();
+    UnrolledSkipList(const UnrolledSkipList&) = delete;
+    UnrolledSkipList& operator=(const UnrolledSkipList&) = delete;
+
+    int insert_element(const K& key, const V& value); // 插入元素，已存在返回 1，成功返回 0
+    bool search_element(const K& key); // 查找元素
+    void delete_element(const K& key); // 删除元素
+    std::vector<std::pair<K, V>> scan(const K& start, const K& end, size_t limit = SIZE_MAX); // 范围读取 [start, end)
+    void display_list(); // 打印跳表
+    void clear(); // 清空跳表
+    int size(); // 元素个数
+    size_t memory_usage(); // 节点占用的内存，即内存池向系统申请的字节数
+
+private:
+    NodeType* find_block(const K& key); // 最后一个 keys[0] <= key 的节点，没有时返回头节点
+    NodeType* create_node(int level); // 在内存池中创建空节点
+    void destroy_node(NodeType* node); // 析构节点并把内存归还内存池
+    void destroy_all(); // 析构所有节点，不归还内存
+
+    int _max_level; // 最大层数
+    LevelGenerator _level_generator; // 随机层数生成器
+    NodeType* _header; // 头节点
+    int _skip_list_level; // 当前层数
+    int _element_count; // 元素个数
+    int _node_count; // 节点个数
+    NodeArena<NodeType, NodeType*> _arena; // 节点内存池，只在写锁内访问
+    std::shared_mutex _mtx; // 读写锁
+};
+
+/**
+ * 构造函数
+ * @param max_level 最大层数，AUTO_MAX_LEVEL 表示由节点个数决定（上限 LEVEL_GENERATOR_MAX_LEVEL）
+ * @param p 节点晋升到上一层的概率
+ */
+template <typename K, typename V, int B>
+UnrolledSkipList<K, V, B>::UnrolledSkipList(int max_level, LevelProbability p)
+    : _max_level(max_level > AUTO_MAX_LEVEL ? max_level : LEVEL_GENERATOR_MAX_LEVEL), _level_generator(p),
+      _skip_list_level(0), _element_count(0), _node_count(0) {
+    // 头节点不放在内存池中，clear() 整块释放内存池时它保持不变
+    void* block = ::operator new(NodeArena<NodeType, NodeType*>::block_size(_max_level));
+    _header = new (block) NodeType(_max_level, NodeArena<NodeType, NodeType*>::links_of(block));
+}
+
+template <typename K, typename V, int B>
+UnrolledSkipList<K, V, B>::~UnrolledSkipList() {
+    destroy_all(); // 节点内存随 _arena 整块释放
+    _header->~NodeType();
+    ::operator delete(_header);
+}
+
+template <typename K, typename V, int B>
+typename UnrolledSkipList<K, V, B>::NodeType* UnrolledSkipList<K, V, B>::create_node(int level) {
+    void* block = _arena.allocate(level);
+    _node_count++;
+    return new (block) NodeType(level, _arena.links_of(block));
+}
+
+template <typename K, typename V, int B>
+void UnrolledSkipList<K, V, B>::destroy_node(NodeType* node) {
+    int level = node->node_level;
+    node->~NodeType();
+    _arena.deallocate(node, level);
+    _node_count--;
+}
+
+/**
+ * 析构所有节点
+ * @description 只调用析构函数，不归还内存，调用者随后整块释放内存池；键和值都可平凡析构时直接跳过
+ */
+template <typename K, typename V, int B>
+void UnrolledSkipList<K, V, B>::destroy_all() {
+    if (std::is_trivially_destructible<K>::value && std::is_trivially_destructible<V>::value) {
+        return;
+    }
+    NodeType* node = _header->forward[0];
+    while (node != nullptr) {
+        NodeType* next = node->forward[0];
+        node->~NodeType();
+        node = next;
+    }
+}
+
+/**
+ * 查找 key 所在的块
+ * @param key 键
+ * @return NodeType* 最后一个 keys[0] <= key 的节点，key 如果存在只可能在这个块中；没有时返回头节点
+ * @note 调用者需持有锁；只用 operator< 比较
+ */
+template <typename K, typename V, int B>
+typename UnrolledSkipList<K, V, B>::NodeType* UnrolledSkipList<K, V, B>::find_block(const K& key) {
+    NodeType* current = _header;
+    for (int i = _skip_list_level; i >= 0; i--) {
+        NodeType* next = current->forward[i];
+        while (next != nullptr && !(key < next->keys[0])) {
+            current = next;
+            next = current->forward[i];
+        }
+    }
+    return current;
+}
+
+/**
+ * 插入元素
+ * @param key 键
+ * @param value 值
+ * @return int 已存在返回 1，插入成功返回 0
+ * @description 1. 逐层记录最后一个 keys[0] <= key 的节点，第 0 层的就是要插入的块；
+ *                 key 小于所有键时插入第一个块的开头，它的 keys[0] 变小，但仍大于头节点；
+ *              2. 块满时分裂：新节点放在原节点之后，各层的前驱就是第 1 步记录的节点；
+ *              3. 在块内移动后面的键值，放入新的键值
+ */
+template <typename K, typename V, int B>
+int UnrolledSkipList<K, V, B>::insert_element(const K& key, const V& value) {
+    _mtx.lock(); // 独占加锁
+
+    NodeType* update[_max_level + 1]; // 每一层中最后一个 keys[0] <= key 的节点
+    NodeType* current = _header;
+    for (int i = _skip_list_level; i >= 0; i--) {
+        NodeType* next = current->forward[i];
+        while (next != nullptr && !(key < next->keys[0])) {
+            current = next;
+            next = current->forward[i];
+        }
+        update[i] = current;
+    }
+
+    NodeType* node = update[0];
+    if (node == _header) {
+        node = _header->forward[0];
+        if (node == nullptr) { // 空表，新建第一个块
+            node = create_node(0);
+            node->keys[0] = key;
+            node->values[0] = value;
+            node->count = 1;
+            _header->forward[0] = node;
+            _element_count++;
+            _mtx.unlock();
+            return 0;
+        }
+        for (int i = 0; i <= node->node_level && i <= _skip_list_level; i++) { // 分裂时新节点的前驱是这个块
+            update[i] = node;
+        }
+    }
+
+    int pos = block_lower_bound(node->keys, node->count, key);
+    if (pos < node->count && node->keys[pos] == key) {
+        _mtx.unlock();
+        return 1; // 元素已存在
+    }
+
+    if (node->count == B) { // 块已满，分裂
+        int cap = _level_generator.level_cap((size_t)_node_count + 1);
+        int level = _level_generator.next(cap < _max_level ? cap : _max_level);
+        if (level > _skip_list_level) {
+            for (int i = _skip_list_level + 1; i <= level; i++) {
+                update[i] = _header;
+            }
+            _skip_list_level = level;
+        }
+
+        NodeType* sibling = create_node(level);
+        int split = pos == B ? B : B / 2; // key 大于块内所有键时原块保持满，新块只放 key
+        std::move(node->keys + split, node->keys + B, sibling->keys);
+        std::move(node->values + split, node->values + B, sibling->values);
+        sibling->count = B - split;
+        node->count = split;
+        for (int i = 0; i <= level; i++) {
+            sibling->forward[i] = update[i]->forward[i];
+            update[i]->forward[i] = sibling;
+        }
+
+        if (pos >= split) {
+            node = sibling;
+            pos -= split;
+        }
+    }
+
+    std::move_backward(node->keys + pos, node->keys + node->count, node->keys + node->count + 1);
+    std::move_backward(node->values + pos, node->values + node->count, node->values + node->count + 1);
+    node->keys[pos] = key;
+    node->values[pos] = value;
+    node->count++;
+    _element_count++;
+
+    _mtx.unlock();
+    return 0;
+}
+
+/**
+ * 查找元素
+ * @param key 要查找的键
+ * @return bool 找到返回 true
+ */
+template <typename K, typename V, int B>
+bool UnrolledSkipList<K, V, B>::search_element(const K& key) {
+    _mtx.lock_shared(); // 共享加锁
+    NodeType* node = find_block(key);
+    bool found = false;
+    if (node != _header) {
+        int pos = block_lower_bound(node->keys, node->count, key);
+        found = pos < node->count && node->keys[pos] == key;
+    }
+    _mtx.unlock_shared();
+    return found;
+}
+
+/**
+ * 删除元素
+ * @param key 要删除的键
+ * @description 逐层记录最后一个 keys[0] < key 的节点：
+ *                  key 是某个块的 keys[0] 时，这个块就是第 0 层前驱的后继，记录的节点正好是它在各层的前驱；
+ *                  否则 key 只可能在第 0 层前驱的块中。
+ *              块变空时它只剩下 key，一定属于前一种情况，可以直接用记录的前驱摘除
+ */
+template <typename K, typename V, int B>
+void UnrolledSkipList<K, V, B>::delete_element(const K& key) {
+    _mtx.lock(); // 独占加锁
+
+    NodeType* update[_max_level + 1]; // 每一层中最后一个 keys[0] < key 的节点
+    NodeType* current = _header;
+    for (int i = _skip_list_level; i >= 0; i--) {
+        NodeType* next = current->forward[i];
+        while (next != nullptr && next->keys[0] < key) {
+            current = next;
+            next = current->forward[i];
+        }
+        update[i] = current;
+    }
+
+    NodeType* node = update[0]->forward[0];
+    if (node == nullptr || !(node->keys[0] == key)) {
+        node = update[0];
+    }
+    if (node == _header) {
+        _mtx.unlock();
+        return;
+    }
+    int pos = block_lower_bound(node->keys, node->count, key);
+    if (pos == node->count || !(node->keys[pos] == key)) {
+        _mtx.unlock();
+        return; // 不存在
+    }
+
+    std::move(node->keys + pos + 1, node->keys + node->count, node->keys + pos);
+    std::move(node->values + pos + 1, node->values + node->count, node->values + pos);
+    node->count--;
+    node->keys[node->count] = K(); // 释放移出块的键值持有的资源
+    node->values[node->count] = V();
+    _element_count--;
+
+    if (node->count == 0) { // 块为空，从各层摘除
+        for (int i = 0; i <= node->node_level; i++) {
+            update[i]->forward[i] = node->forward[i];
+        }
+        destroy_node(node);
+        while (_skip_list_level > 0 && _header->forward[_skip_list_level] == nullptr) {
+            _skip_list_level--;
+        }
+    }
+    _mtx.unlock();
+}
+
+/**
+ * 范围读取
+ * @param start 起始键（包含）
+ * @param end 结束键（不包含）
+ * @param limit 最多读取的元素个数
+ * @return std::vector<std::pair<K, V>> 按键升序排列的键值对
+ * @description 定位到 start 所在的块后逐块顺序读取，每个块的键值连续存放
+ */
+template <typename K, typename V, int B>
+std::vector<std::pair<K, V>> UnrolledSkipList<K, V, B>::scan(const K& start, const K& end, size_t limit) {
+    std::vector<std::pair<K, V>> result;
+    _mtx.lock_shared(); // 共享加锁
+
+    NodeType* node = find_block(start);
+    int pos = 0;
+    if (node == _header) {
+        node = _header->forward[0];
+    } else {
+        pos = block_lower_bound(node->keys, node->count, start);
+    }
+    while (node != nullptr && result.size() < limit) {
+        for (; pos < node->count && result.size() < limit; pos++) {
+            if (!(node->keys[pos] < end)) {
+                _mtx.unlock_shared();
+                return result;
+            }
+            result.emplace_back(node->keys[pos], node->values[pos]);
+        }
+        node = node->forward[0];
+        pos = 0;
+    }
+
+    _mtx.unlock_shared();
+    return result;
+}
+
+/**
+ * 打印跳表
+ * @description 每一层按顺序打印各节点的键块，如 [1 2 3] [5 8]
+ */
+template <typename K, typename V, int B>
+void UnrolledSkipList<K, V, B>::display_list() {
+    std::shared_lock<std::shared_mutex> lock(_mtx); // 共享加锁
+    std::cout << "\n*****Unrolled Skip List*****" << "\n";
+    for (int i = _skip_list_level; i >= 0; i--) {
+        std::cout << "Level " << i << ": _header ";
+        for (NodeType* node = _header->forward[i]; node != nullptr; node = node->forward[i]) {
+            std::cout << "[";
+            for (int j = 0; j < node->count; j++) {
+                std::cout << (j == 0 ? "" : " ") << node->keys[j];
+            }
+            std::cout << "] ";
+        }
+        std::cout << std::endl;
+    }
+}
+
+/**
+ * 清空跳表
+ * @description 析构所有节点后整块释放内存池
+ */
+template <typename K, typename V, int B>
+void UnrolledSkipList<K, V, B>::clear() {
+    _mtx.lock(); // 独占加锁
+    destroy_all();
+    _arena.release_all();
+    for (int i = 0; i <= _max_level; i++) {
+        _header->forward[i] = nullptr;
+    }
+    _skip_list_level = 0;
+    _element_count = 0;
+    _node_count = 0;
+    _mtx.unlock();
+}
+
+template <typename K, typename V, int B>
+int UnrolledSkipList<K, V, B>::size() {
+    std::shared_lock<std::shared_mutex> lock(_mtx);
+    return _element_count;
+}
+
+// 返回节点占用的内存（按内存池的整块计算）
+template <typename K, typename V, int B>
+size_t UnrolledSkipList<K, V, B>::memory_usage() {
+    std::shared_lock<std::shared_mutex> lock(_mtx);
+    return _arena.bytes_reserved();
+}
+
+#endif
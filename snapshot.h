@@ -0,0 +1,647 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+#include <cerrno>
+#include <type_traits>
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define SNAPSHOT_MAGIC "SKVSNAP1"           // 文件魔数，8 字节
+#define SNAPSHOT_VERSION 1                  // 格式版本
+#define SNAPSHOT_MAX_LEVELS 64              // 文件头中层数统计的最大层数
+#define SNAPSHOT_BLOCK_SIZE (64 * 1024)     // 每个数据块的目标大小
+#define SNAPSHOT_FLAG_TTL 0x1               // 记录中带有剩余过期时间
+#define SNAPSHOT_LOAD_BATCH 64              // 并行解析时每批处理的数据块数
+#define SNAPSHOT_MIN_RECORD_SIZE 8          // 一条记录至少包含键、值两个 u32 长度字段
+
+/* ************************************************************************
+> 二进制快照格式（取代逐行文本的 key:value 格式）
+> 文件布局（所有整数均为主机字节序，小端）：
+    > 文件头 SnapshotHeader：魔数、版本、标志位、记录总数、各层节点数统计、文件头 CRC
+    > 若干数据块：[ u32 负载长度 | u32 记录数 | u32 负载 CRC32 | 负载 ]
+    > 结束块：负载长度和记录数均为 0
+> 每条记录（位于数据块负载中）：
+    > [ u32 键长度 | 键 | u32 值长度 | 值 | i32 剩余过期秒数（仅 SNAPSHOT_FLAG_TTL） ]
+> 说明：
+    > 写入时先写到 path.tmp，全部完成后回填文件头、fsync 后再 rename，最后 fsync 所在目录，崩溃时不会留下半个快照
+    > 读取时逐块校验 CRC，发现损坏立即停止，不会把错误数据加载进跳表
+    > 键和值通过 SnapshotCodec<T> 编解码：算术类型按字节拷贝，std::string 原样存储，
+      其他类型使用 operator<< / operator>>
+ ************************************************************************/
+
+/*
+ * CRC32（IEEE 802.3 多项式，查表法）
+ * @param data 数据
+ * @param len 长度
+ * @param crc 上一次的结果，用于分段计算
+ * @return CRC32
+ */
+inline uint32_t snapshot_crc32(const void* data, size_t len, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool initialized = [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)initialized;
+
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/*
+ * 打开文件或目录并 fsync
+ * @param path 路径
+ * @param flags open 的标志
+ * @return 是否成功
+ */
+inline bool snapshot_sync_path(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+        return false;
+    }
+    int rc;
+    while ((rc = ::fsync(fd)) != 0 && errno == EINTR) {
+    }
+    ::close(fd);
+    return rc == 0;
+}
+
+/*
+ * fsync path 所在的目录：新建或 rename 只修改了目录项，目录落盘之后文件名才不会在崩溃后丢失
+ * @param path 文件路径
+ * @return 是否成功
+ */
+inline bool snapshot_sync_parent(const std::string& path) {
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    return snapshot_sync_path(dir.empty() ? "." : dir, O_RDONLY | O_DIRECTORY);
+}
+
+/*
+ * 键值编解码
+ * encode：把对象追加到 out 中
+ * decode：从 [data, data + len) 中还原对象
+ */
+template <typename T, typename Enable = void>
+struct SnapshotCodec {
+    static void encode(const T& v, std::string& out) {
+        std::ostringstream ss;
+        ss << v;
+        out += ss.str();
+    }
+    static bool decode(const char* data, size_t len, T& v) {
+        std::istringstream ss(std::string(data, len));
+        ss >> v;
+        return !ss.fail();
+    }
+};
+
+template <typename T>
+struct SnapshotCodec<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static void encode(const T& v, std::string& out) {
+        out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+    static bool decode(const char* data, size_t len, T& v) {
+        if (len != sizeof(T)) {
+            return false;
+        }
+        memcpy(&v, data, sizeof(T));
+        return true;
+    }
+};
+
+template <>
+struct SnapshotCodec<std::string> {
+    static void encode(const std::string& v, std::string& out) {
+        out += v;
+    }
+    static bool decode(const char* data, size_t len, std::string& v) {
+        v.assign(data, len);
+        return true;
+    }
+};
+
+/*
+ * 直接在映射区上解码时使用的解码方式，默认与 SnapshotCodec 相同（复制出来）；
+ * SnapshotString 在 mapped_snapshot.h 中特化为引用映射区的视图。
+ * 只有映射区在结果的整个生命周期内有效时才能使用，SnapshotReader 的数据块缓冲区会被复用和释放
+ */
+template <typename T>
+struct SnapshotViewCodec {
+    static bool decode(const char* data, size_t len, T& v) {
+        return SnapshotCodec<T>::decode(data, len, v);
+    }
+};
+
+// 文件头
+struct SnapshotHeader {
+    char magic[8];                                // SNAPSHOT_MAGIC
+    uint32_t version;                             // SNAPSHOT_VERSION
+    uint32_t flags;                               // SNAPSHOT_FLAG_*
+    uint64_t record_count;                        // 记录总数
+    uint32_t max_level;                           // 写入时跳表的最高层数
+    uint32_t reserved;
+    uint64_t level_count[SNAPSHOT_MAX_LEVELS];    // 层数为 i 的节点个数
+    uint32_t header_crc;                          // 以上字段的 CRC32
+    uint32_t padding;
+};
+
+/************************************************************************
+> 快照写入器（流式）
+> public方法：
+    > open：创建 path.tmp 并预留文件头
+    > append：追加一条记录，攒满一个数据块后写出
+    > close：写出剩余数据和结束块，回填文件头，落盘后 rename 为正式文件并落盘目录项
+ ************************************************************************/
+
+class SnapshotWriter {
+public:
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    bool open(const std::string& path, uint32_t flags); // 打开快照文件
+    template <typename K, typename V>
+    void append(const K& key, const V& value, int level, int ttl_seconds = 0); // 追加一条记录
+    bool close(); // 完成写入
+    uint64_t record_count() const; // 已写入的记录数
+
+private:
+    void flush_block(); // 写出当前数据块
+    static void put_u32(std::string& out, uint32_t v);
+
+    std::string _path; // 正式文件路径
+    std::string _tmp_path; // 临时文件路径
+    std::ofstream _out; // 输出流
+    SnapshotHeader _header; // 文件头
+    std::string _block; // 当前数据块的负载
+    uint32_t _block_records; // 当前数据块中的记录数
+    std::string _scratch; // 编码键值时复用的缓冲区
+};
+
+inline SnapshotWriter::SnapshotWriter() : _block_records(0) {
+    memset(&_header, 0, sizeof(_header));
+}
+
+inline SnapshotWriter::~SnapshotWriter() {
+    if (_out.is_open()) { // 未调用 close 的快照视为作废
+        _out.close();
+        std::remove(_tmp_path.c_str());
+    }
+}
+
+/**
+ * 打开快照文件
+ * @param path 快照文件路径
+ * @param flags 标志位，如 SNAPSHOT_FLAG_TTL
+ * @return bool 是否成功
+ */
+inline bool SnapshotWriter::open(const std::string& path, uint32_t flags) {
+    _path = path;
+    _tmp_path = path + ".tmp";
+    _out.open(_tmp_path, std::ios::binary | std::ios::trunc);
+    if (!_out.is_open()) {
+        std::cerr << "Failed to open file: " << _tmp_path << std::endl;
+        return false;
+    }
+
+    memset(&_header, 0, sizeof(_header));
+    memcpy(_header.magic, SNAPSHOT_MAGIC, 8);
+    _header.version = SNAPSHOT_VERSION;
+    _header.flags = flags;
+    _out.write(reinterpret_cast<const char*>(&_header), sizeof(_header)); // 先占位，close 时回填
+
+    _block.clear();
+    _block.reserve(SNAPSHOT_BLOCK_SIZE + 1024);
+    _block_records = 0;
+    return true;
+}
+
+inline void SnapshotWriter::put_u32(std::string& out, uint32_t v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+/**
+ * 追加一条记录
+ * @param key 键
+ * @param value 值
+ * @param level 节点层数，用于文件头中的层数统计
+ * @param ttl_seconds 剩余过期秒数，仅在 SNAPSHOT_FLAG_TTL 时写入
+ */
+template <typename K, typename V>
+void SnapshotWriter::append(const K& key, const V& value, int level, int ttl_seconds) {
+    _scratch.clear();
+    SnapshotCodec<K>::encode(key, _scratch);
+    put_u32(_block, (uint32_t)_scratch.size());
+    _block += _scratch;
+
+    _scratch.clear();
+    SnapshotCodec<V>::encode(value, _scratch);
+    put_u32(_block, (uint32_t)_scratch.size());
+    _block += _scratch;
+
+    if (_header.flags & SNAPSHOT_FLAG_TTL) {
+        int32_t ttl = ttl_seconds;
+        _block.append(reinterpret_cast<const char*>(&ttl), sizeof(ttl));
+    }
+
+    _header.record_count++;
+    if (level >= 0) {
+        _header.level_count[level < SNAPSHOT_MAX_LEVELS ? level : SNAPSHOT_MAX_LEVELS - 1]++;
+        if ((uint32_t)level > _header.max_level) {
+            _header.max_level = level;
+        }
+    }
+
+    if (++_block_records, _block.size() >= SNAPSHOT_BLOCK_SIZE) {
+        flush_block();
+    }
+}
+
+inline void SnapshotWriter::flush_block() {
+    if (_block_records == 0) {
+        return;
+    }
+    uint32_t meta[3] = {(uint32_t)_block.size(), _block_records, snapshot_crc32(_block.data(), _block.size())};
+    _out.write(reinterpret_cast<const char*>(meta), sizeof(meta));
+    _out.write(_block.data(), _block.size());
+    _block.clear();
+    _block_records = 0;
+}
+
+/**
+ * 完成写入
+ * @return bool 是否成功
+ */
+inline bool SnapshotWriter::close() {
+    flush_block();
+    uint32_t end_block[3] = {0, 0, 0}; // 结束块
+    _out.write(reinterpret_cast<const char*>(end_block), sizeof(end_block));
+
+    _header.header_crc = snapshot_crc32(&_header, offsetof(SnapshotHeader, header_crc));
+    _out.seekp(0);
+    _out.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+    _out.flush();
+    bool ok = _out.good();
+    _out.close();
+
+    // 数据落盘之后才 rename，否则崩溃后正式文件名可能指向内容不完整的文件
+    if (!ok || !snapshot_sync_path(_tmp_path, O_RDONLY) || std::rename(_tmp_path.c_str(), _path.c_str()) != 0) {
+        std::cerr << "Failed to write snapshot: " << _path << std::endl;
+        std::remove(_tmp_path.c_str());
+        return false;
+    }
+
+    // 目录落盘之后新文件名才不会在崩溃后丢失；
+    // 失败时保留已经写好的快照，但返回 false，调用者不会据此删除日志段
+    if (!snapshot_sync_parent(_path)) {
+        std::cerr << "Failed to sync directory of snapshot: " << _path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+inline uint64_t SnapshotWriter::record_count() const {
+    return _header.record_count;
+}
+
+/************************************************************************
+> 快照读取器（流式）
+> public方法：
+    > open：读取并校验文件头
+    > next：读取下一条记录，数据块用完时读入并校验下一个数据块
+    > header：获取文件头（记录总数、层数统计等）
+    > corrupted：读取过程中是否发现了损坏
+ ************************************************************************/
+
+class SnapshotReader {
+public:
+    SnapshotReader();
+
+    bool open(const std::string& path); // 打开快照文件
+    template <typename K, typename V>
+    bool next(K& key, V& value, int& ttl_seconds); // 读取下一条记录
+    bool next_block(std::string& payload, uint32_t& records); // 读取下一个完整的数据块（已校验）
+    template <typename K, typename V, bool View = false>
+    static bool decode_record(const char*& p, const char* end, uint32_t flags, K& key, V& value, int& ttl_seconds); // 从负载中解码一条记录，View 为 true 时使用 SnapshotViewCodec
+    const SnapshotHeader& header() const; // 文件头
+    bool corrupted() const; // 是否发现损坏
+
+private:
+    std::ifstream _in; // 输入流
+    std::string _path; // 文件路径
+    SnapshotHeader _header; // 文件头
+    std::string _block; // 当前数据块的负载
+    size_t _pos; // 当前数据块中的读取位置
+    uint64_t _remaining; // 文件中尚未读取的字节数，用于在分配之前校验数据块长度
+    bool _corrupted; // 是否发现损坏
+};
+
+inline SnapshotReader::SnapshotReader() : _pos(0), _remaining(0), _corrupted(false) {
+    memset(&_header, 0, sizeof(_header));
+}
+
+/**
+ * 判断文件是否为二进制快照
+ * @param path 文件路径
+ * @return bool 文件以 SNAPSHOT_MAGIC 开头时返回 true
+ */
+inline bool is_snapshot_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[8] = {0};
+    in.read(magic, sizeof(magic));
+    return in.gcount() == sizeof(magic) && memcmp(magic, SNAPSHOT_MAGIC, 8) == 0;
+}
+
+/**
+ * 打开快照文件
+ * @param path 文件路径
+ * @return bool 魔数、版本、文件头 CRC 均正确时返回 true
+ */
+inline bool SnapshotReader::open(const std::string& path) {
+    _path = path;
+    _in.open(path, std::ios::binary);
+    if (!_in.is_open()) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    _in.read(reinterpret_cast<char*>(&_header), sizeof(_header));
+    if (_in.gcount() != sizeof(_header) || memcmp(_header.magic, SNAPSHOT_MAGIC, 8) != 0) {
+        std::cerr << "Not a snapshot file: " << path << std::endl;
+        return false;
+    }
+    if (_header.version != SNAPSHOT_VERSION ||
+        _header.header_crc != snapshot_crc32(&_header, offsetof(SnapshotHeader, header_crc))) {
+        std::cerr << "Snapshot header corrupted: " << path << std::endl;
+        _corrupted = true;
+        return false;
+    }
+    std::error_code ec;
+    uint64_t file_size = std::filesystem::file_size(path, ec);
+    _remaining = ec ? 0 : file_size - sizeof(_header);
+    _block.clear();
+    _pos = 0;
+    return true;
+}
+
+/**
+ * 读取下一个数据块
+ * @param payload 输出，数据块负载
+ * @param records 输出，数据块中的记录数
+ * @return bool 读到结束块或发现损坏时返回 false
+ */
+inline bool SnapshotReader::next_block(std::string& payload, uint32_t& records) {
+    uint32_t meta[3];
+    _in.read(reinterpret_cast<char*>(meta), sizeof(meta));
+    if (_in.gcount() != sizeof(meta)) {
+        std::cerr << "Snapshot truncated: " << _path << std::endl;
+        _corrupted = true;
+        return false;
+    }
+    _remaining = _remaining > sizeof(meta) ? _remaining - sizeof(meta) : 0;
+    if (meta[0] == 0 && meta[1] == 0) { // 结束块
+        return false;
+    }
+    // 长度、记录数不在 CRC 覆盖范围内，损坏时不按它们分配内存
+    if (meta[0] > _remaining || meta[1] > meta[0] / SNAPSHOT_MIN_RECORD_SIZE) {
+        std::cerr << "Snapshot block corrupted: " << _path << std::endl;
+        _corrupted = true;
+        return false;
+    }
+    _remaining -= meta[0];
+    payload.resize(meta[0]);
+    _in.read(&payload[0], meta[0]);
+    if ((uint32_t)_in.gcount() != meta[0] || snapshot_crc32(payload.data(), payload.size()) != meta[2]) {
+        std::cerr << "Snapshot block corrupted: " << _path << std::endl;
+        _corrupted = true;
+        return false;
+    }
+    records = meta[1];
+    return true;
+}
+
+/**
+ * 从数据块负载中解码一条记录
+ * @param p 输入输出，当前位置，成功后指向下一条记录
+ * @param end 负载末尾
+ * @return bool 是否成功
+ */
+template <typename K, typename V, bool View>
+bool SnapshotReader::decode_record(const char*& p, const char* end, uint32_t flags, K& key, V& value, int& ttl_seconds) {
+    uint32_t len;
+    if (end - p < (ptrdiff_t)sizeof(len)) return false;
+    memcpy(&len, p, sizeof(len));
+    p += sizeof(len);
+    if ((size_t)(end - p) < len || !(View ? SnapshotViewCodec<K>::decode(p, len, key) : SnapshotCodec<K>::decode(p, len, key))) return false;
+    p += len;
+
+    if (end - p < (ptrdiff_t)sizeof(len)) return false;
+    memcpy(&len, p, sizeof(len));
+    p += sizeof(len);
+    if ((size_t)(end - p) < len || !(View ? SnapshotViewCodec<V>::decode(p, len, value) : SnapshotCodec<V>::decode(p, len, value))) return false;
+    p += len;
+
+    ttl_seconds = 0;
+    if (flags & SNAPSHOT_FLAG_TTL) {
+        int32_t ttl;
+        if (end - p < (ptrdiff_t)sizeof(ttl)) return false;
+        memcpy(&ttl, p, sizeof(ttl));
+        p += sizeof(ttl);
+        ttl_seconds = ttl;
+    }
+    return true;
+}
+
+/**
+ * 读取下一条记录
+ * @param key 输出，键
+ * @param value 输出，值
+ * @param ttl_seconds 输出，剩余过期秒数（没有 SNAPSHOT_FLAG_TTL 时为 0）
+ * @return bool 没有更多记录或发现损坏时返回 false
+ */
+template <typename K, typename V>
+bool SnapshotReader::next(K& key, V& value, int& ttl_seconds) {
+    if (_pos >= _block.size()) {
+        uint32_t records;
+        if (!next_block(_block, records)) {
+            return false;
+        }
+        _pos = 0;
+    }
+    const char* p = _block.data() + _pos;
+    if (!decode_record(p, _block.data() + _block.size(), _header.flags, key, value, ttl_seconds)) {
+        std::cerr << "Snapshot record corrupted: " << _path << std::endl;
+        _corrupted = true;
+        return false;
+    }
+    _pos = p - _block.data();
+    return true;
+}
+
+inline const SnapshotHeader& SnapshotReader::header() const {
+    return _header;
+}
+
+inline bool SnapshotReader::corrupted() const {
+    return _corrupted;
+}
+
+// 解码后的一条记录
+template <typename K, typename V>
+struct SnapshotRecord {
+    K key;
+    V value;
+    int ttl; // 剩余过期秒数，没有 SNAPSHOT_FLAG_TTL 时为 0
+};
+
+/**
+ * 解码一个完整的数据块
+ * @param payload 已通过 CRC 校验的数据块负载
+ * @param records 数据块中的记录数
+ * @param flags 文件头中的标志位
+ * @param out 输出，按文件中的顺序存放解码结果
+ * @return bool 记录格式是否正确
+ */
+template <typename K, typename V>
+bool snapshot_decode_block(const std::string& payload, uint32_t records, uint32_t flags, std::vector<SnapshotRecord<K, V>>& out) {
+    out.resize(records);
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    for (uint32_t i = 0; i < records; i++) {
+        if (!SnapshotReader::decode_record(p, end, flags, out[i].key, out[i].value, out[i].ttl)) {
+            return false;
+        }
+    }
+    return p == end;
+}
+
+/**
+ * 多线程解析快照
+ * @param reader 已打开的读取器
+ * @param consume 每条记录的回调 consume(SnapshotRecord<K, V>&)，按文件中的顺序在调用线程中执行
+ * @return uint64_t 交给 consume 的记录数
+ * @description 数据块在调用线程中顺序读入并校验 CRC，每攒够 SNAPSHOT_LOAD_BATCH 个数据块，
+ *              由多个线程并行解码，再按原顺序交给 consume，因此 consume 看到的仍是有序流
+ */
+template <typename K, typename V, typename Consume>
+uint64_t snapshot_parallel_read(SnapshotReader& reader, Consume consume) {
+    unsigned workers = std::thread::hardware_concurrency();
+    if (workers == 0) {
+        workers = 1;
+    }
+
+    std::vector<std::string> payloads(SNAPSHOT_LOAD_BATCH);
+    std::vector<uint32_t> counts(SNAPSHOT_LOAD_BATCH);
+    std::vector<std::vector<SnapshotRecord<K, V>>> decoded(SNAPSHOT_LOAD_BATCH);
+    std::vector<char> ok(SNAPSHOT_LOAD_BATCH);
+    uint64_t consumed = 0;
+
+    bool more = true;
+    while (more) {
+        size_t n = 0;
+        while (n < SNAPSHOT_LOAD_BATCH && (more = reader.next_block(payloads[n], counts[n]))) {
+            n++;
+        }
+        if (n == 0) {
+            break;
+        }
+
+        auto decode_range = [&](size_t first, size_t step) {
+            for (size_t i = first; i < n; i += step) {
+                ok[i] = snapshot_decode_block(payloads[i], counts[i], reader.header().flags, decoded[i]);
+            }
+        };
+        size_t threads = std::min<size_t>(workers, n);
+        if (threads <= 1) {
+            decode_range(0, 1);
+        } else {
+            std::vector<std::thread> pool;
+            for (size_t t = 1; t < threads; t++) {
+                pool.emplace_back(decode_range, t, threads);
+            }
+            decode_range(0, threads);
+            for (auto& th : pool) {
+                th.join();
+            }
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            if (!ok[i]) {
+                std::cerr << "Snapshot record corrupted" << std::endl;
+                return consumed;
+            }
+            for (auto& record : decoded[i]) {
+                consume(record);
+            }
+            consumed += decoded[i].size();
+        }
+    }
+    return consumed;
+}
+
+/**
+ * 把旧的文本持久化文件（key:value 或 key:value:ttl）转换为二进制快照
+ * @param text_path 文本文件路径，如 store/dumpFile
+ * @param snapshot_path 输出的快照路径
+ * @param with_ttl 文本中是否带有第三列剩余过期秒数
+ * @return bool 是否成功
+ */
+inline bool convert_text_snapshot(const std::string& text_path, const std::string& snapshot_path, bool with_ttl) {
+    std::ifstream in(text_path);
+    if (!in.is_open()) {
+        std::cerr << "Failed to open file: " << text_path << std::endl;
+        return false;
+    }
+    SnapshotWriter writer;
+    if (!writer.open(snapshot_path, with_ttl ? SNAPSHOT_FLAG_TTL : 0)) {
+        return false;
+    }
+
+    std::string line;
+    while (getline(in, line)) {
+        size_t pos1 = line.find(':');
+        if (line.empty() || pos1 == std::string::npos) {
+            continue;
+        }
+        std::string key = line.substr(0, pos1);
+        int ttl = 0;
+        std::string value;
+        if (with_ttl) {
+            size_t pos2 = line.find(':', pos1 + 1);
+            if (pos2 == std::string::npos) {
+                continue;
+            }
+            value = line.substr(pos1 + 1, pos2 - pos1 - 1);
+            ttl = atoi(line.c_str() + pos2 + 1);
+        } else {
+            value = line.substr(pos1 + 1);
+        }
+        if (key.empty() || value.empty()) {
+            continue;
+        }
+        writer.append(key, value, -1, ttl);
+    }
+    return writer.close();
+}
+
+#endif
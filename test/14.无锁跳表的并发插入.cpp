@@ -0,0 +1,87 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include "skiplist.h"
+#include "skiplist_lockfree.h"
+
+/*
+ * 比较 SkipList（全局互斥锁）与 LockFreeSkipList 在不同线程数下的插入吞吐量
+ * 每种线程数下都插入 TEST_COUNT 个随机键，之后进行同样数量的随机查找
+ */
+
+using namespace std;
+
+#define TEST_COUNT 2000000
+#define MAX_LEVEL 18
+
+// 每个线程独立的随机数发生器，避免 rand() 的全局锁干扰测量结果
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <typename List>
+double run_insert(List* list, int num_threads) {
+    vector<thread> threads;
+    auto start = chrono::high_resolution_clock::now();
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([list, t, num_threads]() {
+            uint64_t state = 88172645463325252ULL + t * 7919;
+            int count = TEST_COUNT / num_threads;
+            for (int i = 0; i < count; i++) {
+                list->insert_element(next_random(state) % TEST_COUNT, "a");
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+template <typename List>
+double run_search(List* list, int num_threads) {
+    vector<thread> threads;
+    auto start = chrono::high_resolution_clock::now();
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([list, t, num_threads]() {
+            uint64_t state = 0x9E3779B97F4A7C15ULL + t * 104729;
+            int count = TEST_COUNT / num_threads;
+            for (int i = 0; i < count; i++) {
+                list->search_element(next_random(state) % TEST_COUNT);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+int main() {
+    int thread_counts[] = {1, 2, 4, 8, 16};
+
+    cout << "threads\tSkipList insert(s)\tLockFree insert(s)\tLockFree search(s)\tLockFree Mops/s" << endl;
+    for (int num_threads : thread_counts) {
+        SkipList<int, string>* locked = new SkipList<int, string>(MAX_LEVEL);
+        LockFreeSkipList<int, string>* lock_free = new LockFreeSkipList<int, string>(MAX_LEVEL);
+
+        double locked_time = run_insert(locked, num_threads);
+        double lock_free_time = run_insert(lock_free, num_threads);
+        double search_time = run_search(lock_free, num_threads);
+
+        cout << num_threads << "\t" << locked_time << "\t\t\t" << lock_free_time << "\t\t\t" << search_time
+             << "\t\t\t" << TEST_COUNT / lock_free_time / 1e6 << endl;
+
+        delete locked;
+        delete lock_free;
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include "skiplist.h"
+
+/*
+ * 比较两种从快照恢复跳表的方式：
+ *   1. 逐个调用 insert_element（每个键一次 O(log n) 查找 + 一次加锁）
+ *   2. load_file 的批量构建（快照本身有序，每层一个尾指针，线性构建）
+ * 另外把第一个数据块的长度、记录数分别改成远大于实际的值，检查读取时在分配内存之前就判定为损坏
+ * 运行前需要存在 store 目录，测试会覆盖 store/dumpFile
+ */
+
+using namespace std;
+
+#define TEST_COUNT 2000000
+#define MAX_LEVEL 18
+
+int main() {
+    SkipList<int, string>* origin = new SkipList<int, string>(MAX_LEVEL);
+    for (int i = 0; i < TEST_COUNT; i++) {
+        origin->insert_element(i * 2, "value");
+    }
+    origin->dump_file();
+
+    // 1. 逐个插入
+    auto start = chrono::high_resolution_clock::now();
+    SkipList<int, string>* by_insert = new SkipList<int, string>(MAX_LEVEL);
+    for (int i = 0; i < TEST_COUNT; i++) {
+        by_insert->insert_element(i * 2, "value");
+    }
+    chrono::duration<double> insert_time = chrono::high_resolution_clock::now() - start;
+
+    // 2. 批量构建
+    start = chrono::high_resolution_clock::now();
+    SkipList<int, string>* by_load = new SkipList<int, string>(MAX_LEVEL);
+    by_load->load_file();
+    chrono::duration<double> load_time = chrono::high_resolution_clock::now() - start;
+
+    // 校验：所有键都能找到，奇数键都找不到
+    int missing = 0;
+    for (int i = 0; i < TEST_COUNT; i++) {
+        if (!by_load->search_element(i * 2) || by_load->search_element(i * 2 + 1)) {
+            missing++;
+        }
+    }
+
+    cout << "elements: " << by_load->size() << ", mismatches: " << missing << endl;
+    cout << "insert_element: " << insert_time.count() << "s" << endl;
+    cout << "load_file (bulk): " << load_time.count() << "s" << endl;
+
+    // 数据块的长度、记录数损坏：offset 为被改写的字段在数据块头中的偏移
+    auto rejects = [](size_t offset) {
+        {
+            ifstream in(STORE_FILE, ios::binary);
+            string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+            uint32_t huge = 0xFFFFFFF0;
+            memcpy(&data[sizeof(SnapshotHeader) + offset], &huge, sizeof(huge));
+            ofstream(STORE_FILE "_corrupted", ios::binary | ios::trunc) << data;
+        }
+        SnapshotReader reader;
+        string payload;
+        uint32_t records = 0;
+        bool rejected = reader.open(STORE_FILE "_corrupted") && !reader.next_block(payload, records) && reader.corrupted() && payload.empty();
+        remove(STORE_FILE "_corrupted");
+        return rejected;
+    };
+    bool rejected = rejects(0);
+    cout << "oversized block length: " << (rejected ? "rejected" : "NOT REJECTED") << endl;
+    bool count_rejected = rejects(sizeof(uint32_t));
+    cout << "oversized record count: " << (count_rejected ? "rejected" : "NOT REJECTED") << endl;
+
+    delete origin;
+    delete by_insert;
+    delete by_load;
+    return missing == 0 && rejected && count_rejected ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <optional>
+#include "skiplist.h"
+
+/*
+ * 比较两种加载快照的方式：
+ *   1. load_file：ifstream 读取，为每个键值申请 std::string
+ *   2. load_mapped_file：mmap 整个快照，键值为 SnapshotString，直接引用映射区
+ * 输出加载耗时和加载前后 RssAnon（匿名内存）/ RssFile（文件页）的增量
+ * 另外检查 scan、游标、multi_get 复制出来的 SnapshotString 在 clear() 和跳表析构之后仍然可读，
+ * 以及 SnapshotString 键值经 load_file（不经过映射）加载后，内容不依赖读取时的缓冲区
+ * 运行前需要存在 store 目录，测试会覆盖 store/dumpFile
+ */
+
+using namespace std;
+
+#define TEST_COUNT 1000000
+#define MAX_LEVEL 18
+
+// 读取 /proc/self/status 中的某一项，单位 kB
+long read_status_kb(const string& name) {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, name.size(), name) == 0) {
+            return stol(line.substr(name.size() + 1));
+        }
+    }
+    return 0;
+}
+
+int main() {
+    {
+        SkipList<string, string>* origin = new SkipList<string, string>(MAX_LEVEL);
+        for (int i = 0; i < TEST_COUNT; i++) {
+            origin->insert_element("key_" + to_string(1000000000 + i), "value_of_key_" + to_string(i) + "_padding_padding");
+        }
+        origin->dump_file();
+        delete origin;
+    }
+
+    // mmap 加载
+    long anon = read_status_kb("RssAnon"), file = read_status_kb("RssFile");
+    auto start = chrono::high_resolution_clock::now();
+    SkipList<SnapshotString, SnapshotString>* mapped = new SkipList<SnapshotString, SnapshotString>(MAX_LEVEL);
+    mapped->load_mapped_file();
+    chrono::duration<double> mapped_time = chrono::high_resolution_clock::now() - start;
+    cout << "load_mapped_file: " << mapped_time.count() << "s, elements: " << mapped->size()
+         << ", RssAnon +" << read_status_kb("RssAnon") - anon << " kB, RssFile +" << read_status_kb("RssFile") - file << " kB" << endl;
+
+    bool found = mapped->search_element(SnapshotString("key_" + to_string(1000000000 + TEST_COUNT / 2)));
+    cout << "search in mapped list: " << (found ? "found" : "not found") << endl;
+
+    // scan、游标、multi_get 返回的键值已复制为拥有状态，跳表清空、析构后仍然可读
+    SnapshotString first_key = SnapshotString("key_" + to_string(1000000000));
+    vector<pair<SnapshotString, SnapshotString>> rows = mapped->scan(first_key, SnapshotString("key_" + to_string(1000000010)));
+    SkipList<SnapshotString, SnapshotString>::Cursor cursor = mapped->cursor();
+    cursor.seek(first_key);
+    SnapshotString cursor_value = cursor.value();
+    vector<optional<SnapshotString>> got = mapped->multi_get({first_key});
+    mapped->clear();
+    bool readable = rows.size() == 10 && !rows[3].second.is_view() && rows[3].second == SnapshotString("value_of_key_3_padding_padding");
+    delete mapped;
+    mapped = new SkipList<SnapshotString, SnapshotString>(MAX_LEVEL);
+    readable = readable && cursor_value == SnapshotString("value_of_key_0_padding_padding") &&
+               got[0].has_value() && *got[0] == SnapshotString("value_of_key_0_padding_padding") &&
+               rows[9].first == SnapshotString("key_1000000009");
+    cout << "rows copied out after clear: " << (readable ? "readable" : "CORRUPTED") << endl;
+
+    // 普通加载
+    anon = read_status_kb("RssAnon");
+    start = chrono::high_resolution_clock::now();
+    SkipList<string, string>* copied = new SkipList<string, string>(MAX_LEVEL);
+    copied->load_file();
+    chrono::duration<double> copied_time = chrono::high_resolution_clock::now() - start;
+    cout << "load_file: " << copied_time.count() << "s, elements: " << copied->size()
+         << ", RssAnon +" << read_status_kb("RssAnon") - anon << " kB" << endl;
+
+    // SnapshotString 经 load_file 加载：读取缓冲区逐块复用，键值必须复制出来
+    SkipList<SnapshotString, SnapshotString>* loaded = new SkipList<SnapshotString, SnapshotString>(MAX_LEVEL);
+    loaded->load_file();
+    SkipList<SnapshotString, SnapshotString>::Cursor walk = loaded->cursor();
+    int index = 0;
+    bool intact = loaded->size() == TEST_COUNT;
+    for (walk.seek_to_first(); walk.valid() && intact; walk.next(), index++) {
+        intact = walk.key().str() == "key_" + to_string(1000000000 + index) &&
+                 walk.value().str() == "value_of_key_" + to_string(index) + "_padding_padding";
+    }
+    cout << "SnapshotString via load_file: " << (intact && index == TEST_COUNT ? "intact" : "CORRUPTED") << endl;
+    delete loaded;
+
+    delete mapped;
+    delete copied;
+    return readable && intact && index == TEST_COUNT ? 0 : 1;
+}
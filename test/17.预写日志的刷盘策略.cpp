@@ -0,0 +1,139 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <csignal>
+#include <sys/resource.h>
+#include "skiplist_cache.h"
+
+/*
+ * 比较预写日志三种刷盘策略下的写入吞吐量，并检查重启后能否恢复全部数据
+ *   ALWAYS：每次提交都 fdatasync，并发写线程通过组提交共享一次刷盘
+ *   EVERY_N_MS：每 10 毫秒 fdatasync 一次
+ *   OS：只写入内核，由操作系统决定何时落盘
+ * 之后检查 dump_file 写出的快照在 store/wal_bench_snapshot_* 下，重启时只加载它，不加载其他测试留下的 store/dumpFile_cache_*
+ * 再检查 clear() 写入日志，重启后快照和日志中 clear() 之前的键都不会恢复
+ * 最后用 RLIMIT_FSIZE 限制文件大小，让日志写出失败，检查之后的插入、删除都返回 WAL_COMMIT_FAILED
+ * 运行前需要存在 store 目录，日志段和快照写在 store/wal_bench*，测试结束后删除
+ */
+
+using namespace std;
+
+#define TEST_COUNT 20000
+#define MAX_LEVEL 18
+#define WAL_BASE "store/wal_bench"
+
+void remove_wal_segments() {
+    for (const auto& entry : filesystem::directory_iterator("store")) {
+        if (entry.path().filename().string().rfind("wal_bench", 0) == 0) { // 日志段和配套的快照
+            filesystem::remove(entry.path());
+        }
+    }
+}
+
+int main() {
+    const char* names[] = {"ALWAYS", "EVERY_N_MS", "OS"};
+    WalSyncPolicy policies[] = {WalSyncPolicy::ALWAYS, WalSyncPolicy::EVERY_N_MS, WalSyncPolicy::OS};
+    int thread_counts[] = {1, 4, 16};
+
+    cout << "policy\t\tthreads\tops/s\t\trecovered" << endl;
+    for (int p = 0; p < 3; p++) {
+        for (int num_threads : thread_counts) {
+            remove_wal_segments();
+
+            SkipListWithCache<int, string>* list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+            list->open_wal(WAL_BASE, policies[p], 10);
+            int before = list->size();
+
+            vector<thread> threads;
+            auto start = chrono::high_resolution_clock::now();
+            for (int t = 0; t < num_threads; t++) {
+                threads.emplace_back([list, t, num_threads]() {
+                    int count = TEST_COUNT / num_threads;
+                    for (int i = 0; i < count; i++) {
+                        list->insert_element(1000000000 + t * count + i, "value", 3600);
+                    }
+                });
+            }
+            for (auto& th : threads) {
+                th.join();
+            }
+            chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+            int expected = list->size();
+            delete list; // 不做快照，只依赖预写日志
+
+            // 重启：加载快照并重放日志
+            SkipListWithCache<int, string>* recovered = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+            recovered->open_wal(WAL_BASE, policies[p], 10);
+            bool ok = recovered->size() == expected && expected - before == TEST_COUNT / num_threads * num_threads;
+            delete recovered;
+
+            cout << names[p] << (p == 1 ? "\t" : "\t\t") << num_threads << "\t" << (int)(TEST_COUNT / elapsed.count())
+                 << "\t\t" << (ok ? "ok" : "MISMATCH") << endl;
+        }
+    }
+    remove_wal_segments();
+
+    // 快照与日志配套：恢复时加载 dump_file 写出的快照，再重放快照之后的日志
+    SkipListWithCache<int, string>* list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+    list->open_wal(WAL_BASE, WalSyncPolicy::OS);
+    bool empty_start = list->size() == 0;
+    for (int i = 0; i < 100; i++) {
+        list->insert_element(i, "value", 3600);
+    }
+    list->dump_file();
+    for (int i = 100; i < 200; i++) {
+        list->insert_element(i, "value", 3600);
+    }
+    list->delete_element(0);
+    delete list;
+    list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+    list->open_wal(WAL_BASE, WalSyncPolicy::OS);
+    bool paired = empty_start && list->size() == 199 && !list->find(0) && list->find(199);
+    delete list;
+    remove_wal_segments();
+    cout << "snapshot + wal\t\t\t\t" << (paired ? "ok" : "MISMATCH") << endl;
+
+    // clear() 之后只剩清空后插入的键
+    list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+    list->open_wal(WAL_BASE, WalSyncPolicy::OS);
+    for (int i = 0; i < 100; i++) {
+        list->insert_element(i, "value", 3600);
+    }
+    list->dump_file();
+    list->insert_element(100, "value", 3600);
+    list->clear();
+    list->insert_element(200, "value", 3600);
+    delete list;
+    list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+    list->open_wal(WAL_BASE, WalSyncPolicy::OS);
+    bool cleared = list->size() == 1 && !list->find(0) && !list->find(100) && list->find(200);
+    delete list;
+    remove_wal_segments();
+    cout << "clear + wal\t\t\t\t" << (cleared ? "ok" : "MISMATCH") << endl;
+
+    // 日志段写满 4KB 后 write 返回 EFBIG，日志进入失败状态，之后的提交都失败
+    signal(SIGXFSZ, SIG_IGN);
+    struct rlimit old_limit;
+    getrlimit(RLIMIT_FSIZE, &old_limit);
+    list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+    list->open_wal(WAL_BASE, WalSyncPolicy::ALWAYS);
+    struct rlimit limit = old_limit;
+    limit.rlim_cur = 4096;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    int first_failure = -1;
+    for (int i = 0; i < 1000 && first_failure < 0; i++) {
+        if (list->insert_element(i, "value", 3600) == WAL_COMMIT_FAILED) {
+            first_failure = i;
+        }
+    }
+    bool latched = first_failure > 0 && list->insert_element(-1, "value", 3600) == WAL_COMMIT_FAILED &&
+                   list->delete_element(0) == WAL_COMMIT_FAILED && list->multi_put({{-2, "value"}}, 3600) == WAL_COMMIT_FAILED;
+    delete list;
+    setrlimit(RLIMIT_FSIZE, &old_limit);
+    remove_wal_segments();
+    cout << "write failure\t\t\t\t" << (latched ? "ok" : "MISMATCH") << endl;
+    return paired && cleared && latched ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include "skiplist_cache.h"
+
+/*
+ * 比较快照进行期间写线程的插入延迟
+ *   dump_file：在调用线程中遍历跳表，遍历期间持有共享锁，写线程被阻塞
+ *   bgsave：只在 fork 的瞬间持有共享锁，子进程写快照
+ * 预先插入 PRELOAD_COUNT 个键，写线程持续插入新键，主线程触发快照并等待完成，
+ * 输出快照期间插入延迟的 p50 / p99 / max
+ * 运行前需要存在 store 目录
+ */
+
+using namespace std;
+
+#define PRELOAD_COUNT 2000000
+#define MAX_LEVEL 18
+
+template <typename Snapshot>
+void measure(const char* name, SkipListWithCache<int, string>* list, int& next_key, Snapshot snapshot) {
+    atomic<bool> running(true);
+    vector<double> latencies;
+    latencies.reserve(1 << 20);
+
+    thread writer([&]() {
+        while (running) {
+            auto start = chrono::steady_clock::now();
+            list->insert_element(next_key++, "value", PERMANENT_TTL);
+            latencies.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+        }
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(100)); // 让写线程先跑起来
+    auto start = chrono::steady_clock::now();
+    snapshot();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    running = false;
+    writer.join();
+
+    sort(latencies.begin(), latencies.end());
+    cout << name << ": snapshot " << elapsed.count() << "s, inserts " << latencies.size()
+         << ", p50 " << latencies[latencies.size() / 2] << "us"
+         << ", p99 " << latencies[latencies.size() * 99 / 100] << "us"
+         << ", max " << latencies.back() << "us" << endl;
+}
+
+int main() {
+    SkipListWithCache<int, string>* list = new SkipListWithCache<int, string>(MAX_LEVEL, 1000);
+    for (int i = 0; i < PRELOAD_COUNT; i++) {
+        list->insert_element(i, "value", PERMANENT_TTL);
+    }
+    int next_key = PRELOAD_COUNT;
+
+    measure("dump_file", list, next_key, [list]() {
+        list->dump_file();
+    });
+    measure("bgsave", list, next_key, [list]() {
+        list->bgsave();
+        list->wait_bgsave();
+    });
+
+    delete list;
+    return 0;
+}
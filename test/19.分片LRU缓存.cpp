@@ -0,0 +1,92 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include "LRU.h"
+
+/*
+ * 比较两种线程安全的缓存在不同线程数下的命中延迟
+ *   LRUCache + 一把全局互斥锁（SkipListWithCache 原先的做法）
+ *   ShardedLRUCache：按键哈希分片，每个分片一把锁
+ * 缓存预先填满 CAPACITY 个键，每个线程随机读取 OPS_PER_THREAD 次
+ * 分片缓存的每个分片独立淘汰，键分布不均时个别分片会提前淘汰，因此同时输出命中率
+ */
+
+using namespace std;
+
+#define CAPACITY 100000
+#define OPS_PER_THREAD 200000
+#define TTL 3600
+
+// 全局加锁的 LRUCache，接口与 ShardedLRUCache 相同
+class LockedLRUCache {
+public:
+    LockedLRUCache(size_t capacity) : _cache(capacity) {}
+    bool get(const int& k, string& v) {
+        lock_guard<mutex> lock(_mtx);
+        return _cache.get(k, v);
+    }
+    void put(const int& k, const string& v, int ttl) {
+        lock_guard<mutex> lock(_mtx);
+        _cache.put(k, v, ttl);
+    }
+
+private:
+    mutex _mtx;
+    LRUCache<int, string> _cache;
+};
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 返回平均每次 get 的耗时（纳秒），hit_rate 输出命中率
+template <typename Cache>
+double run_gets(Cache& cache, int num_threads, double& hit_rate) {
+    atomic<long> total_hits(0);
+    vector<thread> threads;
+    auto start = chrono::high_resolution_clock::now();
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&cache, &total_hits, t]() {
+            uint64_t state = 88172645463325252ULL + t * 7919;
+            string value;
+            int hits = 0;
+            for (int i = 0; i < OPS_PER_THREAD; i++) {
+                hits += cache.get(next_random(state) % CAPACITY, value);
+            }
+            total_hits += hits;
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    hit_rate = (double)total_hits / ((long)OPS_PER_THREAD * num_threads);
+    chrono::duration<double, nano> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / OPS_PER_THREAD; // 每个线程的平均延迟
+}
+
+int main() {
+    LockedLRUCache locked(CAPACITY);
+    ShardedLRUCache<int, string> sharded(CAPACITY);
+    for (int i = 0; i < CAPACITY; i++) {
+        locked.put(i, "value", TTL);
+        sharded.put(i, "value", TTL);
+    }
+
+    cout << "shards: " << sharded.shard_count() << endl;
+    cout << "threads\tLRUCache+mutex(ns/op)\tShardedLRUCache(ns/op)\tSharded hit rate" << endl;
+    int thread_counts[] = {1, 2, 4, 8, 16};
+    for (int num_threads : thread_counts) {
+        double locked_hit_rate, sharded_hit_rate;
+        double locked_ns = run_gets(locked, num_threads, locked_hit_rate);
+        double sharded_ns = run_gets(sharded, num_threads, sharded_hit_rate);
+        cout << num_threads << "\t" << locked_ns << "\t\t\t" << sharded_ns << "\t\t\t" << sharded_hit_rate << endl;
+    }
+    return 0;
+}
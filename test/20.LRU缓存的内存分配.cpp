@@ -0,0 +1,64 @@
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include "LRU.h"
+
+/*
+ * 统计 LRUCache 的内存分配：
+ *   构造时一次性分配槽位数组和索引，输出每个条目平均占用的字节数
+ *   缓存填满之后进行 OPS 次随机 put / get，输出期间的分配次数（应为 0）
+ * 通过替换全局 operator new 计数
+ */
+
+using namespace std;
+
+#define CAPACITY 100000
+#define OPS 1000000
+#define TTL 3600
+
+static size_t g_alloc_count = 0;
+static size_t g_alloc_bytes = 0;
+
+void* operator new(size_t size) {
+    g_alloc_count++;
+    g_alloc_bytes += size;
+    void* p = malloc(size);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+int main() {
+    size_t bytes_before = g_alloc_bytes;
+    LRUCache<int, int> cache(CAPACITY);
+    cout << "bytes per entry: " << (double)(g_alloc_bytes - bytes_before) / CAPACITY << endl;
+
+    for (int i = 0; i < CAPACITY; i++) { // 填满缓存
+        cache.put(i, i, TTL);
+    }
+
+    size_t count_before = g_alloc_count;
+    uint64_t state = 88172645463325252ULL;
+    int value;
+    for (int i = 0; i < OPS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int key = state % (CAPACITY * 2); // 一半命中，一半触发淘汰
+        if (!cache.get(key, value)) {
+            cache.put(key, key, TTL);
+        }
+    }
+    cout << "allocations during " << OPS << " steady-state operations: " << g_alloc_count - count_before << endl;
+
+    return 0;
+}
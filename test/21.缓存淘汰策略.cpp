@@ -0,0 +1,109 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include "LRU.h"
+
+/*
+ * 用同一条访问轨迹回放不同的淘汰策略，比较命中率和吞吐量
+ * 回放方式与读缓存一致：get 未命中时 put
+ * 轨迹：
+ *   zipf：键服从 Zipf 分布（s = 0.99），少数热点键占据大部分访问
+ *   scan：zipf 访问中穿插大段顺序扫描，扫描的键只出现一次，会把热点键挤出 LRU
+ */
+
+using namespace std;
+
+#define KEY_SPACE 1000000 // 键的取值范围
+#define TRACE_LENGTH 4000000 // 轨迹长度
+#define CACHE_CAPACITY 10000 // 缓存容量
+#define SCAN_LENGTH 20000 // 每段扫描的长度
+#define SCAN_EVERY 100000 // 每隔多少次访问插入一段扫描
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 按 Zipf 分布生成键：预先算好累积分布，再二分查找
+static vector<int> zipf_trace(size_t length, double s, uint64_t seed) {
+    vector<double> cdf(KEY_SPACE);
+    double sum = 0;
+    for (int i = 0; i < KEY_SPACE; i++) {
+        sum += 1.0 / pow(i + 1, s);
+        cdf[i] = sum;
+    }
+
+    vector<int> trace;
+    trace.reserve(length);
+    uint64_t state = seed;
+    for (size_t i = 0; i < length; i++) {
+        double u = (next_random(state) >> 11) * (1.0 / 9007199254740992.0) * sum;
+        int lo = 0, hi = KEY_SPACE - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        trace.push_back((int)((lo * 2654435761ULL) % KEY_SPACE)); // 打散热点键的编号
+    }
+    return trace;
+}
+
+// 在 zipf 轨迹中插入顺序扫描，扫描的键不与 zipf 的键重叠，每段扫描不重复
+static vector<int> scan_trace(const vector<int>& zipf) {
+    vector<int> trace;
+    trace.reserve(zipf.size() + zipf.size() / SCAN_EVERY * SCAN_LENGTH);
+    int scan_key = KEY_SPACE;
+    for (size_t i = 0; i < zipf.size(); i++) {
+        if (i % SCAN_EVERY == 0) {
+            for (int j = 0; j < SCAN_LENGTH; j++) {
+                trace.push_back(scan_key++);
+            }
+        }
+        trace.push_back(zipf[i]);
+    }
+    return trace;
+}
+
+template <typename Policy>
+void replay(const char* policy_name, const char* trace_name, const vector<int>& trace) {
+    LRUCache<int, int, Policy> cache(CACHE_CAPACITY);
+    size_t hits = 0;
+    int value;
+
+    auto start = chrono::high_resolution_clock::now();
+    for (int key : trace) {
+        if (cache.get(key, value)) {
+            hits++;
+        } else {
+            cache.put(key, key, -1);
+        }
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+
+    cout << trace_name << "\t" << policy_name << "\t\t" << (double)hits / trace.size() << "\t\t"
+         << trace.size() / elapsed.count() / 1e6 << endl;
+}
+
+int main() {
+    vector<int> zipf = zipf_trace(TRACE_LENGTH, 0.99, 88172645463325252ULL);
+    vector<int> scan = scan_trace(zipf);
+
+    cout << "trace\tpolicy\t\thit ratio\tMops/s" << endl;
+    replay<LRUPolicy>("LRU", "zipf", zipf);
+    replay<ClockPolicy>("CLOCK", "zipf", zipf);
+    replay<WTinyLFUPolicy>("W-TinyLFU", "zipf", zipf);
+    replay<LRUPolicy>("LRU", "scan", scan);
+    replay<ClockPolicy>("CLOCK", "scan", scan);
+    replay<WTinyLFUPolicy>("W-TinyLFU", "scan", scan);
+
+    return 0;
+}
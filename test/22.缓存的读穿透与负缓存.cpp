@@ -0,0 +1,112 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include "skiplist_cache.h"
+
+/*
+ * 同一组查找分别在三种配置下运行，比较缓存命中率和访问跳表的次数
+ *   off：跳表命中时不放入缓存，缓存里只有插入时留下的键
+ *   read-through：跳表命中时放入缓存
+ *   read-through + negative：另外开启负缓存，反复查找的不存在的键不再访问跳表
+ * 查找中 80% 是存在的键，20% 是不存在的键，两者都服从 Zipf 分布
+ */
+
+using namespace std;
+
+#define KEY_COUNT 200000 // 跳表中的键数
+#define LOOKUP_COUNT 1000000 // 查找次数
+#define CACHE_CAPACITY 10000 // 缓存容量
+#define MAX_LEVEL 18
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 按 Zipf 分布（s = 0.99）生成 [0, n) 内的编号，热点编号被打散
+static vector<int> zipf_keys(int n, size_t length, uint64_t seed) {
+    vector<double> cdf(n);
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1.0 / pow(i + 1, 0.99);
+        cdf[i] = sum;
+    }
+
+    vector<int> keys;
+    keys.reserve(length);
+    uint64_t state = seed;
+    for (size_t i = 0; i < length; i++) {
+        double u = (next_random(state) >> 11) * (1.0 / 9007199254740992.0) * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        keys.push_back((int)((lo * 2654435761ULL) % n));
+    }
+    return keys;
+}
+
+static vector<int> make_workload() {
+    vector<int> present = zipf_keys(KEY_COUNT, LOOKUP_COUNT, 88172645463325252ULL);
+    vector<int> absent = zipf_keys(KEY_COUNT, LOOKUP_COUNT / 4, 0x9E3779B97F4A7C15ULL);
+    vector<int> workload;
+    workload.reserve(LOOKUP_COUNT);
+    uint64_t state = 12345;
+    size_t p = 0, a = 0;
+    for (int i = 0; i < LOOKUP_COUNT; i++) {
+        if (next_random(state) % 5 == 0) {
+            workload.push_back(KEY_COUNT + absent[a++ % absent.size()]); // 不存在的键
+        } else {
+            workload.push_back(present[p++]);
+        }
+    }
+    return workload;
+}
+
+static void run(const char* name, const vector<int>& workload, bool read_through, bool negative) {
+    SkipListWithCache<int, string> kv(MAX_LEVEL, CACHE_CAPACITY);
+    kv.set_read_through(read_through);
+    if (negative) {
+        kv.enable_negative_cache(CACHE_CAPACITY);
+    }
+    for (int i = 0; i < KEY_COUNT; i++) {
+        kv.insert_element(i, "value_" + to_string(i), PERMANENT_TTL);
+    }
+    kv.reset_cache_stats();
+
+    // search_element 会打印每次查找的结果，测量期间把输出丢弃
+    ofstream null_stream("/dev/null");
+    streambuf* old_buf = cout.rdbuf(null_stream.rdbuf());
+    auto start = chrono::high_resolution_clock::now();
+    for (int key : workload) {
+        kv.search_element(key);
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    cout.rdbuf(old_buf);
+
+    CacheStats stats = kv.cache_stats();
+    cout << name << "\t" << stats.hit_ratio() << "\t\t" << stats.list_hits + stats.misses << "\t\t" << elapsed.count()
+         << endl;
+}
+
+int main() {
+    vector<int> workload = make_workload();
+
+    cout << "mode\t\t\thit ratio\tskip list walks\ttime(s)" << endl;
+    run("off\t\t", workload, false, false);
+    run("read-through\t", workload, true, false);
+    run("read-through+negative", workload, true, true);
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include "skiplist_cache.h"
+
+/*
+ * 测量 remove_skiplist_expired 的耗时与数据量、到期键数的关系
+ * 跳表中有 N 个过期时间很长的键，另有 EXPIRED_COUNT 个 1 秒后过期的键
+ * 等待它们过期后调用一次 remove_skiplist_expired（删除 EXPIRED_COUNT 个键），再调用一次（没有键到期）
+ * 使用时间轮后，两次调用的耗时都不随 N 增长
+ */
+
+using namespace std;
+
+#define EXPIRED_COUNT 1000 // 会过期的键数
+#define MAX_LEVEL 18
+
+template <typename F>
+double measure(F f) {
+    auto start = chrono::high_resolution_clock::now();
+    f();
+    chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+int main() {
+    int sizes[] = {100000, 1000000};
+
+    cout << "N\t\texpired\tcleanup(ms)\tidle cleanup(ms)\tremaining" << endl;
+    for (int n : sizes) {
+        SkipListWithCache<int, int>* kv = new SkipListWithCache<int, int>(MAX_LEVEL, 1000);
+        for (int i = 0; i < n; i++) {
+            kv->insert_element(i, i, DEFAULT_TTL);
+        }
+        for (int i = 0; i < EXPIRED_COUNT; i++) {
+            kv->insert_element(n + i, i, 1);
+        }
+        this_thread::sleep_for(chrono::milliseconds(1300));
+
+        double cleanup = measure([kv]() { kv->remove_skiplist_expired(); });
+        double idle = measure([kv]() { kv->remove_skiplist_expired(); });
+
+        cout << n << "\t\t" << EXPIRED_COUNT << "\t" << cleanup << "\t\t" << idle << "\t\t\t" << kv->size() << endl;
+        delete kv;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "skiplist_cache.h"
+
+/*
+ * 比较两种定期删除方式在大量键同时过期时的表现
+ * 跳表中有 KEY_COUNT 个键，其中 EXPIRED_PERCENT% 的键 1 秒后同时过期，其余 1 小时后过期
+ *   WHEEL：一次清理删除所有到期的键，删除期间一直持有写锁
+ *   SAMPLING：每次清理最多运行 BUDGET_US 微秒，每轮写锁只删除抽样中过期的几个键，
+ *             抽样中过期的比例降到 EXPIRY_ACCEPTABLE_STALE% 附近后，剩下的过期键留给惰性删除
+ * 清理的同时有一个线程不断查找，记录单次查找的最大延迟
+ */
+
+using namespace std;
+
+#define KEY_COUNT 500000 // 键数
+#define EXPIRED_PERCENT 20 // 同时过期的键的比例（%）
+#define BUDGET_US 1000 // SAMPLING 方式每次清理的时间预算（微秒）
+#define CLEANUP_CALLS 2000 // 最多清理的次数（模拟 2000 次周期性清理）
+#define MAX_LEVEL 18
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static void run(const char* name, ExpiryMode mode) {
+    SkipListWithCache<int, int>* kv = new SkipListWithCache<int, int>(MAX_LEVEL, 1000);
+    kv->set_expiry_mode(mode, BUDGET_US);
+    for (int i = 0; i < KEY_COUNT; i++) {
+        kv->insert_element(i, i, i % 100 < EXPIRED_PERCENT ? 1 : DEFAULT_TTL);
+    }
+    this_thread::sleep_for(chrono::milliseconds(1100));
+
+    // 查找和删除都会打印，测量期间把输出丢弃
+    ofstream null_stream("/dev/null");
+    streambuf* old_buf = cout.rdbuf(null_stream.rdbuf());
+
+    atomic<bool> running(true);
+    double max_search_ms = 0;
+    thread reader([&]() {
+        uint64_t state = 88172645463325252ULL;
+        while (running) {
+            auto start = chrono::high_resolution_clock::now();
+            kv->search_element((int)(next_random(state) % KEY_COUNT));
+            chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+            max_search_ms = max(max_search_ms, elapsed.count());
+        }
+    });
+
+    int calls = 0;
+    double max_cleanup_ms = 0;
+    double total_cleanup_ms = 0;
+    int before = kv->size();
+    while (calls < CLEANUP_CALLS) {
+        auto start = chrono::high_resolution_clock::now();
+        kv->remove_skiplist_expired();
+        chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+        max_cleanup_ms = max(max_cleanup_ms, elapsed.count());
+        total_cleanup_ms += elapsed.count();
+        calls++;
+        if (mode == ExpiryMode::WHEEL) { // 时间轮一次就删除了所有到期的键
+            break;
+        }
+        this_thread::yield(); // 给查找线程运行的机会，模拟两次清理之间的间隔
+    }
+
+    running = false;
+    reader.join();
+    cout.rdbuf(old_buf);
+
+    int expired = KEY_COUNT * EXPIRED_PERCENT / 100;
+    int remaining = kv->size() - (KEY_COUNT - expired);
+    cout << name << "\t" << calls << "\t" << total_cleanup_ms << "\t\t" << max_cleanup_ms << "\t\t" << before - kv->size()
+         << "\t" << remaining << "\t\t" << max_search_ms << endl;
+    delete kv;
+}
+
+int main() {
+    cout << "mode\t\tcalls\tcleanup(ms)\tmax cleanup(ms)\tdeleted\tstale left\tmax search(ms)" << endl;
+    run("WHEEL\t", ExpiryMode::WHEEL);
+    run("SAMPLING", ExpiryMode::SAMPLING);
+    return 0;
+}
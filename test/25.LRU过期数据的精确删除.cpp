@@ -0,0 +1,58 @@
+#include "LRU.h"
+#include "check.h"
+#include <iostream>
+#include <string>
+#include <thread>
+
+/*
+ * 回归测试：过期数据必须被精确删除
+ * 1. get 发现过期的条目时，删除的是该条目本身，而不是链表尾部的条目
+ * 2. remove_expired 能删除不在链表尾部的过期条目
+ */
+
+using namespace std;
+
+int main() {
+    string value;
+
+    // 1. 过期的条目位于链表头部，尾部的条目没有过期
+    LRUCache<int, string> cache(3);
+    cache.put(1, "one", 10);
+    cache.put(2, "two", 10);
+    cache.put(3, "three", 1); // 链表：3 2 1，只有 3 会过期
+    this_thread::sleep_for(chrono::milliseconds(1100));
+
+    expect(!cache.get(3, value), "get(3) reports the expired entry as missing");
+    expect(cache.size() == 2, "get(3) removes exactly one entry");
+    expect(cache.get(1, value) && value == "one", "tail entry 1 is still cached");
+    expect(cache.get(2, value) && value == "two", "entry 2 is still cached");
+
+    // 2. 过期的条目夹在中间，remove_expired 也要把它删除
+    LRUCache<int, string> cache2(4);
+    cache2.put(1, "one", 10);
+    cache2.put(2, "two", 1);
+    cache2.put(3, "three", 10);
+    cache2.put(4, "four", 1);
+    cache2.get(1, value); // 链表：1 4 3 2，过期的 4 和 2 一个在中间、一个在尾部
+    cache2.put(5, "five", -1); // 缓存已满，淘汰尾部的 2
+    this_thread::sleep_for(chrono::milliseconds(1100));
+
+    cache2.remove_expired();
+    expect(cache2.size() == 3, "remove_expired removes the expired entry in the middle");
+    expect(!cache2.get(4, value), "entry 4 is gone");
+    expect(cache2.get(1, value) && cache2.get(3, value) && cache2.get(5, value), "live entries 1, 3, 5 are kept");
+
+    // 3. 更新过期时间后，按新的过期时间删除
+    LRUCache<int, string> cache3(3);
+    cache3.put(1, "one", 1);
+    cache3.put(1, "one", 10); // 延长过期时间
+    cache3.put(2, "two", -1);
+    cache3.put(2, "two", 1); // 永不过期改为 1 秒后过期
+    this_thread::sleep_for(chrono::milliseconds(1100));
+
+    cache3.remove_expired();
+    expect(cache3.get(1, value), "entry 1 survives after its ttl was extended");
+    expect(!cache3.get(2, value) && cache3.size() == 1, "entry 2 expires after its ttl was shortened");
+
+    return check_summary();
+}
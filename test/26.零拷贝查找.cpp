@@ -0,0 +1,105 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "skiplist.h"
+#include "check.h"
+
+/*
+ * 字符串键的查找开销：
+ *   跳表中有 KEY_COUNT 个长度超过短字符串优化（SSO）的键，随机查找 LOOKUPS 次
+ *   search_element：只返回是否存在
+ *   find：返回引用节点中的值的句柄，读取值时不复制
+ * getKey 返回引用，查找路径上逐个节点比较时不复制键，两种查找期间的内存分配次数都应为 0
+ * 通过替换全局 operator new 计数
+ */
+
+using namespace std;
+
+#define KEY_COUNT 200000
+#define LOOKUPS 1000000
+#define MAX_LEVEL 18
+
+static size_t g_alloc_count = 0;
+
+void* operator new(size_t size) {
+    g_alloc_count++;
+    void* p = malloc(size);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+static string make_key(int i) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "user:%010d:profile", i);
+    return buf;
+}
+
+int main() {
+    SkipList<string, string> skiplist(MAX_LEVEL);
+    vector<string> keys;
+    keys.reserve(KEY_COUNT * 2);
+    for (int i = 0; i < KEY_COUNT * 2; i++) { // 一半的键存在，一半不存在
+        keys.push_back(make_key(i));
+    }
+    for (int i = 0; i < KEY_COUNT * 2; i += 2) {
+        skiplist.insert_element(keys[i], "value of " + keys[i]);
+    }
+
+    vector<int> order(LOOKUPS);
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < LOOKUPS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        order[i] = state % keys.size();
+    }
+
+    cout << "api\t\tfound\tallocations\tns/lookup" << endl;
+
+    size_t before = g_alloc_count;
+    int found = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        found += skiplist.search_element(keys[order[i]]);
+    }
+    chrono::duration<double, nano> elapsed = chrono::high_resolution_clock::now() - start;
+    size_t search_allocs = g_alloc_count - before;
+    int search_found = found;
+    cout << "search_element\t" << found << "\t" << search_allocs << "\t\t" << elapsed.count() / LOOKUPS << endl;
+
+    before = g_alloc_count;
+    found = 0;
+    size_t value_bytes = 0;
+    bool values_match = true;
+    start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        const string& key = keys[order[i]];
+        SkipList<string, string>::Ref ref = skiplist.find(key);
+        if (ref) {
+            found++;
+            value_bytes += ref->size();
+            values_match = values_match && ref->compare(9, string::npos, key) == 0; // 值为 "value of " + key
+        }
+    }
+    elapsed = chrono::high_resolution_clock::now() - start;
+    size_t find_allocs = g_alloc_count - before;
+    cout << "find\t\t" << found << "\t" << find_allocs << "\t\t" << elapsed.count() / LOOKUPS << endl;
+
+    expect(values_match && found == search_found, "find returns the stored values (" + to_string(value_bytes) + " bytes read in place)");
+    expect(search_allocs == 0 && find_allocs == 0, "search_element and find do not allocate");
+    return check_summary();
+}
@@ -0,0 +1,214 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "skiplist_cache.h"
+#include "check.h"
+
+/*
+ * 范围读取和有序游标
+ * 1. 性能：跳表中有 KEY_COUNT 个键，随机读取 WINDOWS 个长度为 WINDOW 的键区间，
+ *    比较 scan 一次定位后顺序读取与逐个 find 的耗时
+ * 2. 正确性：
+ *    游标正向、反向遍历的顺序和个数
+ *    游标所在的键被删除、前方插入新键后，next / prev 仍然正确
+ *    一个线程不断插入、删除奇数键的同时遍历整个跳表，结果严格递增，且包含所有不会被删除的偶数键
+ *    SkipListWithCache 的 scan 和游标跳过过期的节点
+ */
+
+using namespace std;
+
+#define KEY_COUNT 1000000 // 键数
+#define WINDOW 10000 // 每个区间的键数
+#define WINDOWS 200 // 读取的区间数
+#define MAX_LEVEL 18
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static void benchmark() {
+    SkipList<int, int> skiplist(MAX_LEVEL);
+    for (int i = 0; i < KEY_COUNT; i++) {
+        skiplist.insert_element(i, i);
+    }
+
+    vector<int> starts(WINDOWS);
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < WINDOWS; i++) {
+        starts[i] = next_random(state) % (KEY_COUNT - WINDOW);
+    }
+
+    long long sum_scan = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int s : starts) {
+        for (const pair<int, int>& kv : skiplist.scan(s, s + WINDOW)) {
+            sum_scan += kv.second;
+        }
+    }
+    chrono::duration<double, milli> scan_ms = chrono::high_resolution_clock::now() - start;
+
+    long long sum_find = 0;
+    start = chrono::high_resolution_clock::now();
+    for (int s : starts) {
+        for (int k = s; k < s + WINDOW; k++) {
+            SkipList<int, int>::Ref ref = skiplist.find(k);
+            if (ref) {
+                sum_find += *ref;
+            }
+        }
+    }
+    chrono::duration<double, milli> find_ms = chrono::high_resolution_clock::now() - start;
+
+    cout << "api\t\tms/window" << endl;
+    cout << "scan\t\t" << scan_ms.count() / WINDOWS << endl;
+    cout << "find x " << WINDOW << "\t" << find_ms.count() / WINDOWS << endl;
+    expect(sum_scan == sum_find, "scan and point lookups read the same values");
+}
+
+static void cursor_order() {
+    SkipList<int, int> skiplist(MAX_LEVEL);
+    for (int i = 0; i < 1000; i++) {
+        skiplist.insert_element(i * 2, i);
+    }
+
+    SkipList<int, int>::Cursor cursor = skiplist.cursor();
+    int count = 0;
+    int last = -1;
+    bool ascending = true;
+    for (cursor.seek_to_first(); cursor.valid(); cursor.next()) {
+        ascending = ascending && cursor.key() > last && cursor.value() == cursor.key() / 2;
+        last = cursor.key();
+        count++;
+    }
+    expect(count == 1000 && ascending, "forward iteration visits every key in ascending order");
+
+    count = 0;
+    last = 1 << 30;
+    bool descending = true;
+    for (cursor.seek_to_last(); cursor.valid(); cursor.prev()) {
+        descending = descending && cursor.key() < last;
+        last = cursor.key();
+        count++;
+    }
+    expect(count == 1000 && descending, "backward iteration visits every key in descending order");
+
+    cursor.seek(501);
+    bool seek_ok = cursor.valid() && cursor.key() == 502;
+    cursor.seek_for_prev(501);
+    seek_ok = seek_ok && cursor.valid() && cursor.key() == 500;
+    cursor.seek_for_prev(500);
+    seek_ok = seek_ok && cursor.valid() && cursor.key() == 500;
+    cursor.seek(5000);
+    seek_ok = seek_ok && !cursor.valid();
+    expect(seek_ok, "seek / seek_for_prev land on the nearest key");
+
+    // 游标停在 500 上，删除它并在前方插入 501
+    cursor.seek(500);
+    skiplist.delete_element(500);
+    skiplist.insert_element(501, -1);
+    cursor.next();
+    bool next_ok = cursor.valid() && cursor.key() == 501 && cursor.value() == -1;
+    skiplist.delete_element(501);
+    cursor.prev();
+    expect(next_ok && cursor.valid() && cursor.key() == 498, "cursor survives deletion of its own key and sees new keys");
+
+    vector<pair<int, int>> range = skiplist.scan(100, 120, 5);
+    expect(range.size() == 5 && range.front().first == 100 && range.back().first == 108, "scan honours start and limit");
+    range = skiplist.scan(1990, 5000);
+    expect(range.size() == 5 && range.back().first == 1998, "scan stops at the end of the list");
+}
+
+static void concurrent_iteration() {
+    SkipList<int, int> skiplist(MAX_LEVEL);
+    for (int i = 0; i < 20000; i += 2) {
+        skiplist.insert_element(i, i);
+    }
+
+    atomic<bool> running(true);
+    thread writer([&]() {
+        uint64_t state = 2463534242ULL;
+        while (running) {
+            int key = (int)(next_random(state) % 10000) * 2 + 1; // 只修改奇数键
+            if (next_random(state) % 2) {
+                skiplist.insert_element(key, key);
+            } else {
+                skiplist.delete_element(key);
+            }
+        }
+    });
+
+    bool ordered = true;
+    bool complete = true;
+    for (int round = 0; round < 50; round++) {
+        SkipList<int, int>::Cursor cursor = skiplist.cursor();
+        int last = -1;
+        int evens = 0;
+        for (cursor.seek_to_first(); cursor.valid(); cursor.next()) {
+            ordered = ordered && cursor.key() > last;
+            last = cursor.key();
+            evens += (cursor.key() % 2 == 0);
+            if (cursor.key() % 64 == 0) {
+                this_thread::yield(); // 让写线程在遍历中途修改跳表
+            }
+        }
+        complete = complete && evens == 10000;
+    }
+    running = false;
+    writer.join();
+    expect(ordered, "iteration under concurrent inserts and deletes stays strictly ascending");
+    expect(complete, "iteration under concurrent inserts and deletes sees every stable key");
+}
+
+static void expired_nodes() {
+    // 插入、删除会打印，期间把输出丢弃
+    ofstream null_stream("/dev/null");
+    streambuf* old_buf = cout.rdbuf(null_stream.rdbuf());
+
+    SkipListWithCache<int, string> kv(MAX_LEVEL, 100);
+    for (int i = 0; i < 10; i++) {
+        kv.insert_element(i, to_string(i), i % 3 == 0 ? 1 : PERMANENT_TTL); // 0 3 6 9 一秒后过期
+    }
+    this_thread::sleep_for(chrono::milliseconds(1100));
+
+    vector<pair<int, string>> range = kv.scan(0, 10);
+    SkipListWithCache<int, string>::Cursor cursor = kv.cursor();
+    vector<int> forward, backward;
+    for (cursor.seek_to_first(); cursor.valid(); cursor.next()) {
+        forward.push_back(cursor.key());
+    }
+    for (cursor.seek_to_last(); cursor.valid(); cursor.prev()) {
+        backward.push_back(cursor.key());
+    }
+    cursor.seek_for_prev(6);
+    int before_six = cursor.valid() ? cursor.key() : -1;
+    cursor.seek(2);
+    kv.delete_element(2); // 删除游标所在的键
+    cursor.next();
+    int after_two = cursor.valid() ? cursor.key() : -1;
+
+    cout.rdbuf(old_buf);
+
+    vector<int> live = {1, 2, 4, 5, 7, 8};
+    vector<int> scanned;
+    for (const pair<int, string>& kv_pair : range) {
+        scanned.push_back(kv_pair.first);
+    }
+    expect(scanned == live, "SkipListWithCache::scan skips expired nodes");
+    expect(forward == live && vector<int>(backward.rbegin(), backward.rend()) == live, "SkipListWithCache cursor skips expired nodes both ways");
+    expect(before_six == 5 && after_two == 4, "SkipListWithCache cursor re-seeks after deletes and skips expired nodes");
+}
+
+int main() {
+    benchmark();
+    cursor_order();
+    concurrent_iteration();
+    expired_nodes();
+    return check_summary();
+}
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "skiplist_cache.h"
+#include "check.h"
+
+/*
+ * 比较批量接口与逐个调用的吞吐量
+ * 跳表中预先有 KEY_COUNT 个偶数键，每批 100 或 1000 个键：
+ *   get：逐个 find / search_element 与一次 multi_get（一半的键存在）
+ *   put：逐个 insert_element 与一次 multi_put（插入不存在的奇数键）
+ * 批量接口先按键排序，每个键从上一个键的前驱继续查找，整批只加一次锁
+ * 键的分布：
+ *   random：在整个键空间中随机，同一批的键相距很远，finger search 省下的只是上层的几步
+ *   clustered：同一批的键落在一个随机的小区间内（如同一个用户的多条记录），相邻的键只隔几个节点
+ */
+
+using namespace std;
+
+#define KEY_COUNT 1000000 // SkipList 中预先插入的键数
+#define CACHE_KEY_COUNT 200000 // SkipListWithCache 中预先插入的键数
+#define OPS 400000 // 每种方式的操作总数
+#define MAX_LEVEL 18
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <typename F>
+double measure(F f) {
+    auto start = chrono::high_resolution_clock::now();
+    f();
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+// 键的范围为 [0, 2 * key_count)，偶数键存在；clustered 时同一批的键落在长度为 8 * batch_size 的区间内
+static vector<vector<int>> make_batches(int key_count, int batch_size, bool clustered, bool odd_only, uint64_t seed) {
+    vector<vector<int>> batches(OPS / batch_size);
+    int width = clustered ? 8 * batch_size : 2 * key_count;
+    for (vector<int>& batch : batches) {
+        int base = clustered ? (int)(next_random(seed) % (2 * key_count - width)) : 0;
+        for (int i = 0; i < batch_size; i++) {
+            int key = base + (int)(next_random(seed) % width);
+            batch.push_back(odd_only ? (key | 1) : key);
+        }
+    }
+    return batches;
+}
+
+static void report(const string& name, bool clustered, int batch_size, double single_s, double batch_s) {
+    cout << name << "\t" << (clustered ? "clustered" : "random\t") << "\t" << batch_size << "\t" << OPS / single_s / 1e6
+         << "\t\t" << OPS / batch_s / 1e6 << "\t\t" << single_s / batch_s << "x" << endl;
+}
+
+// 返回批量接口与逐个调用的结果是否一致
+static bool bench_skiplist(int batch_size, bool clustered) {
+    vector<pair<int, int>> elements;
+    for (int i = 0; i < KEY_COUNT; i++) {
+        elements.emplace_back(i * 2, i * 2);
+    }
+
+    // get
+    SkipList<int, int> skiplist(MAX_LEVEL);
+    skiplist.bulk_load(elements);
+    vector<vector<int>> batches = make_batches(KEY_COUNT, batch_size, clustered, false, 88172645463325252ULL);
+    long long sum_single = 0, sum_batch = 0;
+    double single_s = measure([&]() {
+        for (const vector<int>& batch : batches) {
+            for (int key : batch) {
+                SkipList<int, int>::Ref ref = skiplist.find(key);
+                if (ref) {
+                    sum_single += *ref;
+                }
+            }
+        }
+    });
+    double batch_s = measure([&]() {
+        for (const vector<int>& batch : batches) {
+            for (const optional<int>& value : skiplist.multi_get(batch)) {
+                if (value) {
+                    sum_batch += *value;
+                }
+            }
+        }
+    });
+    report("SkipList get", clustered, batch_size, single_s, batch_s);
+    bool agree = sum_single == sum_batch;
+
+    // put，两种方式各自从同样的初始状态开始
+    batches = make_batches(KEY_COUNT, batch_size, clustered, true, 2463534242ULL);
+    vector<vector<pair<int, int>>> put_batches;
+    for (const vector<int>& batch : batches) {
+        vector<pair<int, int>> put_batch;
+        for (int key : batch) {
+            put_batch.emplace_back(key, key);
+        }
+        put_batches.push_back(put_batch);
+    }
+    SkipList<int, int> single_list(MAX_LEVEL);
+    single_list.bulk_load(elements);
+    single_s = measure([&]() {
+        for (const vector<pair<int, int>>& batch : put_batches) {
+            for (const pair<int, int>& kv : batch) {
+                single_list.insert_element(kv.first, kv.second);
+            }
+        }
+    });
+    SkipList<int, int> batch_list(MAX_LEVEL);
+    batch_list.bulk_load(elements);
+    batch_s = measure([&]() {
+        for (const vector<pair<int, int>>& batch : put_batches) {
+            batch_list.multi_put(batch);
+        }
+    });
+    report("SkipList put", clustered, batch_size, single_s, batch_s);
+    return agree && single_list.size() == batch_list.size();
+}
+
+// 返回批量接口与逐个调用的结果是否一致
+static bool bench_cache(int batch_size, bool clustered) {
+    // 查找、删除会打印，测量期间把输出丢弃
+    ofstream null_stream("/dev/null");
+    streambuf* old_buf = cout.rdbuf(null_stream.rdbuf());
+
+    vector<pair<int, int>> elements;
+    for (int i = 0; i < CACHE_KEY_COUNT; i++) {
+        elements.emplace_back(i * 2, i * 2);
+    }
+
+    // put
+    vector<vector<int>> batches = make_batches(CACHE_KEY_COUNT, batch_size, clustered, true, 2463534242ULL);
+    vector<vector<pair<int, int>>> put_batches;
+    for (const vector<int>& batch : batches) {
+        vector<pair<int, int>> put_batch;
+        for (int key : batch) {
+            put_batch.emplace_back(key, key);
+        }
+        put_batches.push_back(put_batch);
+    }
+    SkipListWithCache<int, int> single_kv(MAX_LEVEL, 1000);
+    SkipListWithCache<int, int> batch_kv(MAX_LEVEL, 1000);
+    single_kv.multi_put(elements, DEFAULT_TTL);
+    batch_kv.multi_put(elements, DEFAULT_TTL);
+    double put_single_s = measure([&]() {
+        for (const vector<pair<int, int>>& batch : put_batches) {
+            for (const pair<int, int>& kv : batch) {
+                single_kv.insert_element(kv.first, kv.second, DEFAULT_TTL);
+            }
+        }
+    });
+    double put_batch_s = measure([&]() {
+        for (const vector<pair<int, int>>& batch : put_batches) {
+            batch_kv.multi_put(batch, DEFAULT_TTL);
+        }
+    });
+    bool agree = single_kv.size() == batch_kv.size();
+
+    // get，缓存很小，大部分查找落到跳表
+    batches = make_batches(CACHE_KEY_COUNT, batch_size, clustered, false, 88172645463325252ULL);
+    int found_single = 0, found_batch = 0;
+    double get_single_s = measure([&]() {
+        for (const vector<int>& batch : batches) {
+            for (int key : batch) {
+                found_single += single_kv.search_element(key);
+            }
+        }
+    });
+    double get_batch_s = measure([&]() {
+        for (const vector<int>& batch : batches) {
+            for (const optional<int>& value : batch_kv.multi_get(batch)) {
+                found_batch += value.has_value();
+            }
+        }
+    });
+    agree = agree && found_single == found_batch;
+
+    cout.rdbuf(old_buf);
+    report("Cache get", clustered, batch_size, get_single_s, get_batch_s);
+    report("Cache put", clustered, batch_size, put_single_s, put_batch_s);
+    return agree;
+}
+
+int main() {
+    cout << "op\t\tkeys\t\tbatch\tsingle(Mops/s)\tbatch(Mops/s)\tspeedup" << endl;
+    bool skiplist_agree = true, cache_agree = true;
+    for (bool clustered : {false, true}) {
+        for (int batch_size : {100, 1000}) {
+            skiplist_agree = bench_skiplist(batch_size, clustered) && skiplist_agree;
+        }
+    }
+    for (bool clustered : {false, true}) {
+        for (int batch_size : {100, 1000}) {
+            cache_agree = bench_cache(batch_size, clustered) && cache_agree;
+        }
+    }
+    expect(skiplist_agree, "SkipList multi_get / multi_put agree with find / insert_element");
+    expect(cache_agree, "SkipListWithCache multi_get / multi_put agree with search_element / insert_element");
+    return check_summary();
+}
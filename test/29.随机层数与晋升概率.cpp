@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#include "skiplist.h"
+
+/*
+ * 晋升概率 p 对内存和查找长度的影响
+ * 对 p = 1/2、1/4、1/e 各建一个 KEY_COUNT 个键的跳表（随机顺序插入，最大层数由元素个数决定），输出：
+ *   bytes/key：每个键占用的节点内存（memory_usage，按内存池整块计算），节点大小随平均指针数 1/(1-p) 变化
+ *   cmp/lookup：每次查找比较键的次数，即查找路径的长度（键类型的比较运算符计数）
+ *   ns/lookup：每次查找的耗时
+ * 另外比较 rand() 与 LevelGenerator 生成一个随机层数的耗时
+ */
+
+using namespace std;
+
+#define KEY_COUNT 1000000
+#define LOOKUPS 1000000
+#define DRAWS 10000000
+
+static uint64_t g_compares = 0;
+
+// 比较时计数的键
+struct CountedKey {
+    int value;
+    bool operator<(const CountedKey& other) const {
+        g_compares++;
+        return value < other.value;
+    }
+    bool operator==(const CountedKey& other) const {
+        g_compares++;
+        return value == other.value;
+    }
+};
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static void run(const char* name, LevelProbability p) {
+    vector<int> keys(KEY_COUNT);
+    for (int i = 0; i < KEY_COUNT; i++) {
+        keys[i] = i;
+    }
+    uint64_t state = 88172645463325252ULL;
+    for (int i = KEY_COUNT - 1; i > 0; i--) { // 打乱插入顺序
+        swap(keys[i], keys[next_random(state) % (i + 1)]);
+    }
+
+    SkipList<CountedKey, int>* skiplist = new SkipList<CountedKey, int>(AUTO_MAX_LEVEL, p);
+    for (int key : keys) {
+        skiplist->insert_element(CountedKey{key}, key);
+    }
+    double bytes_per_key = (double)skiplist->memory_usage() / KEY_COUNT;
+
+    g_compares = 0;
+    int found = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        found += skiplist->search_element(CountedKey{(int)(next_random(state) % KEY_COUNT)});
+    }
+    chrono::duration<double, nano> elapsed = chrono::high_resolution_clock::now() - start;
+
+    cout << name << "\t" << bytes_per_key << "\t\t" << (double)g_compares / LOOKUPS << "\t\t" << elapsed.count() / LOOKUPS
+         << "\t\t" << (found == LOOKUPS ? "yes" : "NO") << endl;
+    delete skiplist;
+}
+
+int main() {
+    cout << "p\tbytes/key\tcmp/lookup\tns/lookup\tall found" << endl;
+    run("1/2", LevelProbability::HALF);
+    run("1/4", LevelProbability::QUARTER);
+    run("1/e", LevelProbability::INV_E);
+
+    // 生成随机层数的耗时
+    long long sum = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < DRAWS; i++) {
+        int k = 1;
+        while (rand() % 2) {
+            k++;
+        }
+        sum += k;
+    }
+    chrono::duration<double, nano> rand_ns = chrono::high_resolution_clock::now() - start;
+
+    LevelGenerator generator(LevelProbability::HALF);
+    start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < DRAWS; i++) {
+        sum += generator.next(LEVEL_GENERATOR_MAX_LEVEL);
+    }
+    chrono::duration<double, nano> generator_ns = chrono::high_resolution_clock::now() - start;
+
+    cout << "\nrand() loop\t" << rand_ns.count() / DRAWS << " ns/level" << endl;
+    cout << "LevelGenerator\t" << generator_ns.count() / DRAWS << " ns/level" << (sum == 0 ? " " : "") << endl;
+    return 0;
+}
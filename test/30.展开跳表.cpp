@@ -0,0 +1,161 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include "skiplist.h"
+#include "skiplist_unrolled.h"
+#include "check.h"
+
+/*
+ * 展开跳表（每个节点存放 B 个键）与 SkipList 的比较
+ * 1. 性能：随机顺序插入 KEY_COUNT 个键，输出
+ *      insert / search / delete：每次操作的耗时（查找一半命中一半不命中，删除一半的键）
+ *      scan：读取 WINDOWS 个长度为 WINDOW 的区间，每个区间的耗时
+ *      bytes/key：节点占用的内存
+ * 2. 正确性：B = 4 时随机插入、删除、查找、范围读取，与 std::map 的结果一致
+ */
+
+using namespace std;
+
+#define KEY_COUNT 2000000
+#define LOOKUPS 1000000
+#define WINDOW 1000
+#define WINDOWS 1000
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <typename F>
+double measure_ns(F f, int ops) {
+    auto start = chrono::high_resolution_clock::now();
+    f();
+    chrono::duration<double, nano> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+template <typename List>
+void bench(const string& name, List& list, const vector<int>& keys, const vector<int>& lookups, const vector<int>& starts) {
+    double insert_ns = measure_ns([&]() {
+        for (int key : keys) {
+            list.insert_element(key * 2, key);
+        }
+    }, KEY_COUNT);
+
+    int found = 0;
+    double search_ns = measure_ns([&]() {
+        for (int key : lookups) {
+            found += list.search_element(key); // 偶数键存在
+        }
+    }, LOOKUPS);
+
+    long long sum = 0;
+    double scan_ns = measure_ns([&]() {
+        for (int s : starts) {
+            for (const pair<int, int>& kv : list.scan(s, s + 2 * WINDOW)) {
+                sum += kv.second;
+            }
+        }
+    }, WINDOWS);
+
+    double bytes_per_key = (double)list.memory_usage() / KEY_COUNT;
+
+    double delete_ns = measure_ns([&]() {
+        for (int i = 0; i < KEY_COUNT; i += 2) {
+            list.delete_element(keys[i] * 2);
+        }
+    }, KEY_COUNT / 2);
+
+    cout << name << "\t" << insert_ns << "\t\t" << search_ns << "\t\t" << scan_ns / 1000 << "\t\t" << delete_ns << "\t\t"
+         << bytes_per_key << "\t\t" << found << "/" << sum % 1000003 << "/" << list.size() << endl;
+}
+
+static void benchmark() {
+    vector<int> keys(KEY_COUNT);
+    for (int i = 0; i < KEY_COUNT; i++) {
+        keys[i] = i;
+    }
+    uint64_t state = 88172645463325252ULL;
+    for (int i = KEY_COUNT - 1; i > 0; i--) { // 打乱插入顺序
+        swap(keys[i], keys[next_random(state) % (i + 1)]);
+    }
+    vector<int> lookups(LOOKUPS);
+    for (int& key : lookups) {
+        key = (int)(next_random(state) % (2 * KEY_COUNT));
+    }
+    vector<int> starts(WINDOWS);
+    for (int& s : starts) {
+        s = (int)(next_random(state) % (2 * KEY_COUNT - 2 * WINDOW));
+    }
+
+    cout << "list\t\tinsert(ns)\tsearch(ns)\tscan(us)\tdelete(ns)\tbytes/key\tfound/checksum/left" << endl;
+    {
+        SkipList<int, int> list(AUTO_MAX_LEVEL);
+        bench("SkipList\t", list, keys, lookups, starts);
+    }
+    {
+        UnrolledSkipList<int, int, 8> list;
+        bench("Unrolled B=8\t", list, keys, lookups, starts);
+    }
+    {
+        UnrolledSkipList<int, int, 16> list;
+        bench("Unrolled B=16\t", list, keys, lookups, starts);
+    }
+    {
+        UnrolledSkipList<int, int, 32> list;
+        bench("Unrolled B=32\t", list, keys, lookups, starts);
+    }
+}
+
+static void compare_with_map() {
+    UnrolledSkipList<int, string, 4> list;
+    map<int, string> reference;
+    uint64_t state = 2463534242ULL;
+    bool agree = true;
+    for (int i = 0; i < 200000 && agree; i++) {
+        int key = (int)(next_random(state) % 5000);
+        switch (next_random(state) % 4) {
+        case 0:
+        case 1: {
+            bool inserted = reference.emplace(key, to_string(key)).second;
+            agree = list.insert_element(key, to_string(key)) == (inserted ? 0 : 1);
+            break;
+        }
+        case 2:
+            reference.erase(key);
+            list.delete_element(key);
+            break;
+        default:
+            agree = list.search_element(key) == (reference.count(key) == 1);
+            break;
+        }
+    }
+    expect(agree && list.size() == (int)reference.size(), "insert / delete / search agree with std::map");
+
+    vector<pair<int, string>> range = list.scan(1000, 2000);
+    vector<pair<int, string>> expected(reference.lower_bound(1000), reference.lower_bound(2000));
+    vector<pair<int, string>> all = list.scan(-1, 5000);
+    expect(range == expected && all.size() == reference.size(), "scan agrees with std::map");
+
+    range = list.scan(1000, 5000, 10);
+    expect(range.size() == 10 && range.front().first == reference.lower_bound(1000)->first, "scan honours limit");
+
+    for (int key = 0; key < 5000; key++) {
+        list.delete_element(key);
+    }
+    list.insert_element(7, "7");
+    expect(list.size() == 1 && list.search_element(7) && list.scan(0, 10).size() == 1, "empty blocks are unlinked and the list is reusable");
+
+    list.clear();
+    expect(list.size() == 0 && !list.search_element(7) && list.memory_usage() == 0, "clear releases every block");
+}
+
+int main() {
+    benchmark();
+    compare_with_map();
+    return check_summary();
+}
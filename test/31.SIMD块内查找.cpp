@@ -0,0 +1,149 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "skiplist_unrolled.h"
+#include "check.h"
+
+/*
+ * int 键的 SIMD 块内查找
+ * 指令集在编译期选择，对照时分别用默认选项（SSE2）、-mavx2、-mavx512f 和 -DBLOCK_PROBE_SCALAR 编译
+ * 1. 正确性：键数为 0 ~ 40 的随机有序块，block_lower_bound 与 std::lower_bound 的结果一致
+ * 2. 块内查找：PROBE_BLOCKS 个块（放得进缓存）中随机查找，比较二分查找与当前指令集的计数版本，每次查找的耗时
+ * 3. 整体查找：KEY_COUNT 个键的 UnrolledSkipList，int 键走 SIMD 版本，包装成 BoxedInt 的键走通用的二分查找
+ */
+
+using namespace std;
+
+#define PROBE_BLOCKS 4096
+#define PROBES 20000000
+#define KEY_COUNT 2000000
+#define LOOKUPS 1000000
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 只提供比较运算符的 int，UnrolledSkipList 对它使用通用的二分查找
+struct BoxedInt {
+    int value;
+    bool operator<(const BoxedInt& other) const { return value < other.value; }
+    bool operator==(const BoxedInt& other) const { return value == other.value; }
+};
+
+static const char* instruction_set() {
+#if defined(BLOCK_PROBE_SCALAR)
+    return "scalar";
+#elif defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+static void check_against_lower_bound() {
+    uint64_t state = 88172645463325252ULL;
+    bool agree = true;
+    for (int round = 0; round < 100000 && agree; round++) {
+        int count = (int)(next_random(state) % 41);
+        vector<int> keys(count);
+        for (int& key : keys) {
+            key = (int)(next_random(state) % 200) - 100; // 包含负数
+        }
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        count = (int)keys.size();
+        int key = (int)(next_random(state) % 240) - 120;
+        int expected = (int)(lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        agree = block_lower_bound(keys.data(), count, key) == expected;
+    }
+    expect(agree, string("block_lower_bound (") + instruction_set() + ") agrees with std::lower_bound");
+}
+
+static void probe_benchmark() {
+    cout << "\nblock\tbinary(ns)\t" << instruction_set() << "(ns)\tspeedup" << endl;
+    for (int block : {8, 16, 32}) {
+        vector<int> keys(PROBE_BLOCKS * block);
+        for (size_t i = 0; i < keys.size(); i++) {
+            keys[i] = (int)i * 3;
+        }
+        uint64_t state = 2463534242ULL;
+        vector<pair<int, int>> probes(1 << 16); // (块的下标, 键)
+        for (pair<int, int>& probe : probes) {
+            probe.first = (int)(next_random(state) % PROBE_BLOCKS);
+            probe.second = probe.first * block * 3 + (int)(next_random(state) % (block * 3));
+        }
+
+        long long sum_binary = 0, sum_simd = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < PROBES; i++) {
+            const pair<int, int>& probe = probes[i & 0xFFFF];
+            sum_binary += block_lower_bound<int>(&keys[probe.first * block], block, probe.second); // 通用版本
+        }
+        chrono::duration<double, nano> binary_ns = chrono::high_resolution_clock::now() - start;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < PROBES; i++) {
+            const pair<int, int>& probe = probes[i & 0xFFFF];
+            sum_simd += block_lower_bound(&keys[probe.first * block], block, probe.second);
+        }
+        chrono::duration<double, nano> simd_ns = chrono::high_resolution_clock::now() - start;
+
+        cout << block << "\t" << binary_ns.count() / PROBES << "\t\t" << simd_ns.count() / PROBES << "\t\t"
+             << binary_ns.count() / simd_ns.count() << "x" << (sum_binary == sum_simd ? "" : " MISMATCH") << endl;
+        failures += sum_binary != sum_simd;
+    }
+}
+
+template <typename Key>
+static double lookup_ns(const vector<int>& keys, const vector<int>& lookups, int& found) {
+    UnrolledSkipList<Key, int, UNROLLED_BLOCK_SIZE> list;
+    for (int key : keys) {
+        list.insert_element(Key{key * 2}, key);
+    }
+    found = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int key : lookups) {
+        found += list.search_element(Key{key});
+    }
+    chrono::duration<double, nano> elapsed = chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / LOOKUPS;
+}
+
+static void list_benchmark() {
+    vector<int> keys(KEY_COUNT);
+    for (int i = 0; i < KEY_COUNT; i++) {
+        keys[i] = i;
+    }
+    uint64_t state = 88172645463325252ULL;
+    for (int i = KEY_COUNT - 1; i > 0; i--) {
+        swap(keys[i], keys[next_random(state) % (i + 1)]);
+    }
+    vector<int> lookups(LOOKUPS);
+    for (int& key : lookups) {
+        key = (int)(next_random(state) % (2 * KEY_COUNT));
+    }
+
+    int found_binary = 0, found_simd = 0;
+    double binary_ns = lookup_ns<BoxedInt>(keys, lookups, found_binary);
+    double simd_ns = lookup_ns<int>(keys, lookups, found_simd);
+    cout << "\nUnrolledSkipList (B = " << UNROLLED_BLOCK_SIZE << ", " << KEY_COUNT << " keys)" << endl;
+    cout << "binary probe\t" << binary_ns << " ns/lookup" << endl;
+    cout << instruction_set() << " probe\t" << simd_ns << " ns/lookup" << endl;
+    expect(found_binary == found_simd, "both probes find the same keys");
+}
+
+int main() {
+    check_against_lower_bound();
+    probe_benchmark();
+    list_benchmark();
+    return check_summary();
+}
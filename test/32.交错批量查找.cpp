@@ -0,0 +1,104 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "skiplist.h"
+#include "check.h"
+
+/*
+ * 交错执行的批量查找（multi_search）
+ * 跳表中有 key_count 个偶数键（bulk_load 构建），在整个键空间中随机查找 LOOKUPS 次，一半命中：
+ *   search_element：逐个查找，每一步都等待上一个节点读入
+ *   multi_get：按键排序后从上一个键的前驱继续查找
+ *   multi_search：SEARCH_BATCH_WIDTH 个查找交错执行，每一步预取下一个节点
+ * 分别在远大于末级缓存（800 万个键，约 350MB）和放得进缓存（1 万个键）的跳表上比较每次查找的耗时
+ */
+
+using namespace std;
+
+#define LARGE_KEY_COUNT 8000000
+#define SMALL_KEY_COUNT 10000
+#define LOOKUPS 2000000
+#define BATCH 1000 // 每次批量调用的键数
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static void bench(int key_count) {
+    SkipList<int, int>* skiplist = new SkipList<int, int>(AUTO_MAX_LEVEL);
+    vector<pair<int, int>> elements;
+    elements.reserve(key_count);
+    for (int i = 0; i < key_count; i++) {
+        elements.emplace_back(i * 2, i);
+    }
+    skiplist->bulk_load(elements);
+    vector<pair<int, int>>().swap(elements);
+
+    vector<vector<int>> batches(LOOKUPS / BATCH, vector<int>(BATCH));
+    uint64_t state = 88172645463325252ULL;
+    for (vector<int>& batch : batches) {
+        for (int& key : batch) {
+            key = (int)(next_random(state) % (2 * key_count));
+        }
+    }
+
+    vector<bool> expected; // search_element 的结果，用于核对批量接口
+    expected.reserve(LOOKUPS);
+    auto start = chrono::high_resolution_clock::now();
+    for (const vector<int>& batch : batches) {
+        for (int key : batch) {
+            expected.push_back(skiplist->search_element(key));
+        }
+    }
+    chrono::duration<double, nano> single_ns = chrono::high_resolution_clock::now() - start;
+
+    size_t found_get = 0;
+    start = chrono::high_resolution_clock::now();
+    for (const vector<int>& batch : batches) {
+        for (const optional<int>& value : skiplist->multi_get(batch)) {
+            found_get += value.has_value();
+        }
+    }
+    chrono::duration<double, nano> get_ns = chrono::high_resolution_clock::now() - start;
+
+    bool agree = true;
+    size_t found_search = 0;
+    size_t position = 0;
+    start = chrono::high_resolution_clock::now();
+    for (const vector<int>& batch : batches) {
+        vector<bool> found = skiplist->multi_search(batch);
+        for (size_t i = 0; i < found.size(); i++) {
+            found_search += found[i];
+            agree = agree && found[i] == expected[position++];
+        }
+    }
+    chrono::duration<double, nano> search_ns = chrono::high_resolution_clock::now() - start;
+
+    size_t found_single = 0;
+    for (bool found : expected) {
+        found_single += found;
+    }
+
+    cout << key_count << " keys" << endl;
+    cout << "  search_element\t" << single_ns.count() / LOOKUPS << " ns/lookup" << endl;
+    cout << "  multi_get\t\t" << get_ns.count() / LOOKUPS << " ns/lookup\t" << single_ns.count() / get_ns.count() << "x" << endl;
+    cout << "  multi_search\t\t" << search_ns.count() / LOOKUPS << " ns/lookup\t" << single_ns.count() / search_ns.count() << "x" << endl;
+    expect(agree && found_get == found_single && found_search == found_single, "multi_search and multi_get agree with search_element");
+
+    delete skiplist;
+}
+
+int main() {
+    bench(LARGE_KEY_COUNT);
+    bench(SMALL_KEY_COUNT);
+
+    SkipList<int, int> empty(AUTO_MAX_LEVEL);
+    vector<bool> found = empty.multi_search({1, 2, 3});
+    expect(found.size() == 3 && !found[0] && !found[1] && !found[2] && empty.multi_search({}).empty(), "multi_search on an empty list or batch");
+
+    return check_summary();
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "skiplist.h"
+#include "check.h"
+
+/*
+ * 节点内嵌键前缀的字符串比较
+ * 跳表中有 KEY_COUNT 个 UUID 形式的键（36 个字符，内容在堆上），随机顺序插入，随机查找 LOOKUPS 次，一半命中：
+ *   std::string：节点保存前 8 个字节，前缀不同时不访问键的内容
+ *   PlainString：同样的字符串，没有开启 KeyPrefix，每次比较都读取键的内容（原来的方式）
+ * 输出每次查找的耗时、访问完整键的比较次数（CountedString 计数）和每键内存
+ * 另外检查前缀相同、长度不足 8 字节、含 '\0' 和大于 0x7F 的字节的键，顺序与 std::sort 一致
+ */
+
+using namespace std;
+
+#define KEY_COUNT 1000000
+#define LOOKUPS 1000000
+
+static inline uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 不开启前缀的字符串
+struct PlainString {
+    string s;
+    bool operator<(const PlainString& other) const { return s < other.s; }
+    bool operator==(const PlainString& other) const { return s == other.s; }
+};
+
+// 统计访问完整键的比较次数，Prefixed 为 true 时开启前缀
+static uint64_t g_full_compares = 0;
+
+template <bool Prefixed>
+struct CountedString {
+    string s;
+    bool operator<(const CountedString& other) const {
+        g_full_compares++;
+        return s < other.s;
+    }
+    bool operator==(const CountedString& other) const {
+        g_full_compares++;
+        return s == other.s;
+    }
+};
+
+template <>
+struct KeyPrefix<CountedString<true>> {
+    static const bool enabled = true;
+    static uint64_t of(const CountedString<true>& key) { return pack_key_prefix(key.s.data(), key.s.size()); }
+};
+
+static string make_uuid(uint64_t& state) {
+    static const char* hex = "0123456789abcdef";
+    uint64_t high = next_random(state), low = next_random(state);
+    string uuid;
+    for (int i = 0; i < 32; i++) {
+        uint64_t word = i < 16 ? high : low;
+        uuid.push_back(hex[(word >> ((i % 16) * 4)) & 0xF]);
+        if (i == 7 || i == 11 || i == 15 || i == 19) {
+            uuid.push_back('-');
+        }
+    }
+    return uuid;
+}
+
+template <typename Key>
+static void bench(const string& name, const vector<string>& keys, const vector<int>& order) {
+    SkipList<Key, string>* skiplist = new SkipList<Key, string>(AUTO_MAX_LEVEL);
+    for (size_t i = 0; i < keys.size(); i += 2) { // 偶数下标的键存在
+        skiplist->insert_element(Key{keys[i]}, "v");
+    }
+    vector<Key> lookups;
+    lookups.reserve(order.size());
+    for (int index : order) {
+        lookups.push_back(Key{keys[index]});
+    }
+
+    g_full_compares = 0;
+    int found = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (const Key& key : lookups) {
+        found += skiplist->search_element(key);
+    }
+    chrono::duration<double, nano> elapsed = chrono::high_resolution_clock::now() - start;
+
+    cout << name << elapsed.count() / LOOKUPS << "\t\t" << (double)g_full_compares / LOOKUPS << "\t\t"
+         << (double)skiplist->memory_usage() / skiplist->size() << "\t\t" << found << endl;
+    delete skiplist;
+}
+
+static void check_order() {
+    vector<string> keys = {"", "a", string("a\0", 2), string("a\0b", 3), "ab", "abcdefgh", "abcdefgh0", "abcdefgh1",
+                           "abcdefgi", "abcdefg", "\x7f", "\x80", "\xff\xff", "zzzzzzzzzzzzzzzzzzzzzz", "zzzzzzzz"};
+    SkipList<string, int> skiplist(AUTO_MAX_LEVEL);
+    for (size_t i = 0; i < keys.size(); i++) {
+        skiplist.insert_element(keys[i], (int)i);
+    }
+    vector<string> sorted = keys;
+    sort(sorted.begin(), sorted.end());
+
+    SkipList<string, int>::Cursor cursor = skiplist.cursor();
+    vector<string> iterated;
+    for (cursor.seek_to_first(); cursor.valid(); cursor.next()) {
+        iterated.push_back(cursor.key());
+    }
+    bool all_found = true;
+    for (const string& key : keys) {
+        all_found = all_found && skiplist.search_element(key);
+    }
+    all_found = all_found && !skiplist.search_element("abcdefgh2") && !skiplist.search_element(string("ab\0", 3));
+    expect(iterated == sorted, "prefix comparison keeps std::string order for ties, short keys, NUL and high bytes");
+    expect(all_found, "keys sharing a prefix are told apart by the full comparison");
+    skiplist.delete_element("abcdefgh0");
+    expect(!skiplist.search_element("abcdefgh0") && skiplist.search_element("abcdefgh1") && skiplist.size() == (int)keys.size() - 1,
+           "delete with a shared prefix removes only the exact key");
+}
+
+int main() {
+    check_order();
+
+    uint64_t state = 88172645463325252ULL;
+    vector<string> keys;
+    for (int i = 0; i < KEY_COUNT * 2; i++) {
+        keys.push_back(make_uuid(state));
+    }
+    vector<int> order(LOOKUPS);
+    for (int& index : order) {
+        index = (int)(next_random(state) % keys.size());
+    }
+
+    cout << "\nkey type\t\tns/lookup\tfull compares\tbytes/key\tfound" << endl;
+    bench<PlainString>("PlainString\t\t", keys, order);
+    bench<string>("std::string\t\t", keys, order);
+    bench<CountedString<false>>("CountedString\t\t", keys, order);
+    bench<CountedString<true>>("CountedString+prefix\t", keys, order);
+
+    return check_summary();
+}
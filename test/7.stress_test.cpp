@@ -1,117 +1,205 @@
-#include <iostream>
-#include <chrono>   // 用于高精度时间计算
-#include <cstdlib>
-#include <pthread.h>
-#include <time.h>
-#include "skiplist.h"
-
-using namespace std;
-
-#define NUM_THREADS 10
-#define TEST_COUNT 100000000
-
-SkipList<int, string>* skipList = new SkipList<int, string>(18);  // 创建最大层为18的跳表实例
-
-// 插入元素的线程函数
-void *insertElement(void* threadid) {
-    intptr_t tid;                                                 // 线程id
-    tid = (intptr_t)threadid;                                     // 将void*类型的threadid转换为long类型
-    cout << tid << endl;                                          // 输出线程id
-    int tmp = TEST_COUNT/NUM_THREADS;                             // 每个线程需要插入的元素个数
-
-    // 循环插入元素
-    for (int i=tid * tmp, count = 0; count <  tmp; i++) {
-        count++;                                                  // 计数器加1
-        skipList->insert_element(rand() % TEST_COUNT, "a");       // 随机生成一个键值对并插入跳表
-    }
-    pthread_exit(NULL);                                           // 退出线程
-    return NULL;                                                  // 返回NULL
-}
-
-// 检索元素的线程函数
-void* getElement(void* threadid) { 
-    intptr_t tid;                                                 // 线程id
-    tid = (intptr_t)threadid;                                     // 将void*类型的threadid转换为long类型
-    cout << tid << endl;                                          // 输出线程id
-    int tmp = TEST_COUNT/NUM_THREADS;                             // 每个线程需要检索的元素个数
-
-    // 循环检索元素
-    for (int i = tid * tmp, count = 0; count < tmp; i++) {                  
-        count++;                                                  // 计数器加1
-        skipList->search_element(rand() % TEST_COUNT);            // 随机生成一个键值并检索跳表
-    }
-    pthread_exit(NULL);                                           // 退出线程
-    return NULL;                                                  // 返回NULL
-}
-
-int main() { 
-    srand(time(NULL));
-
-    {
-        pthread_t threads[NUM_THREADS];                           // 创建线程数组
-        int rc;                                                   // 用于存储pthread_create函数的返回值
-        int i;                                                    // 循环变量
-
-        auto start = chrono::high_resolution_clock::now();        // 记录开始时间
-
-        // 创建插入元素的线程
-        for (i = 0; i < NUM_THREADS; i++) {
-            cout << "main() : creating thread, " << i << endl;    // 输出线程创建信息
-            rc = pthread_create(&threads[i], NULL, insertElement, (void *)i);  // 创建线程
-
-            if (rc) {                                             // 如果创建线程失败
-                cout << "Error:unable to create thread," << rc << endl;  // 输出错误信息
-                exit(-1);                                         // 退出程序
-            }
-        }
-
-        void *ret;                                                // 用于存储线程返回值
-        for(i = 0; i < NUM_THREADS; i++) {                        // 循环等待线程结束
-            if (pthread_join(threads[i], &ret) != 0) { 
-                perror("pthread_create() error");                 // 输出错误信息
-                exit(3);                                          // 退出程序
-            }
-        }
-
-        auto finish = chrono::high_resolution_clock::now();       // 记录结束时间
-        chrono::duration<double> elapsed = finish - start;        // 计算时间差
-        cout << "Elapsed time: " << elapsed.count() << " s\n";    // 输出时间差
-    }
-
-    /*
-    {
-        pthread_t threads[NUM_THREADS];                           // 创建线程数组
-        int rc;                                                   // 用于存储pthread_create函数的返回值
-        int i;                                                    // 循环变量
-
-        auto start = chrono::high_resolution_clock::now();        // 记录开始时间
-
-        // 创建插入元素的线程
-        for (i = 0; i < NUM_THREADS; i++) {
-            cout << "main() : creating thread, " << i << endl;    // 输出线程创建信息
-            rc = pthread_create(&threads[i], NULL, getElement, (void *)i);  // 创建线程
-
-            if (rc) {                                             // 如果创建线程失败
-                cout << "Error:unable to create thread," << rc << endl;  // 输出错误信息
-                exit(-1);                                         // 退出程序
-            }
-        }
-
-        void *ret;                                                // 用于存储线程返回值
-        for(i = 0; i < NUM_THREADS; i++) {                        // 循环等待线程结束
-            if (pthread_join(threads[i], &ret) != 0) { 
-                perror("pthread_create() error");                 // 输出错误信息
-                exit(3);                                          // 退出程序
-            }
-        }
-
-        auto finish = chrono::high_resolution_clock::now();       // 记录结束时间
-        chrono::duration<double> elapsed = finish - start;        // 计算时间差
-        cout << "Elapsed time: " << elapsed.count() << " s\n";    // 输出时间差
-    }
-    */
-
-    pthread_exit(NULL);                                           // 退出线程
-
-    return 0;
+#include <iostream>
+#include <chrono>   // 用于高精度时间计算
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <string.h>
+#include "skiplist.h"
+
+using namespace std;
+
+#define NUM_THREADS 10
+#define TEST_COUNT 100000000
+
+// 读写混合模式：一半线程插入，另一半线程查找并记录每次查找的延迟
+#define MIXED_TEST_COUNT 10000000
+#define MIXED_WRITERS (NUM_THREADS / 2)
+#define MIXED_READERS (NUM_THREADS - MIXED_WRITERS)
+
+SkipList<int, string>* skipList = new SkipList<int, string>(18);  // 创建最大层为18的跳表实例
+
+// 插入元素的线程函数
+void *insertElement(void* threadid) {
+    intptr_t tid;                                                 // 线程id
+    tid = (intptr_t)threadid;                                     // 将void*类型的threadid转换为long类型
+    cout << tid << endl;                                          // 输出线程id
+    int tmp = TEST_COUNT/NUM_THREADS;                             // 每个线程需要插入的元素个数
+
+    // 循环插入元素
+    for (int i=tid * tmp, count = 0; count <  tmp; i++) {
+        count++;                                                  // 计数器加1
+        skipList->insert_element(rand() % TEST_COUNT, "a");       // 随机生成一个键值对并插入跳表
+    }
+    pthread_exit(NULL);                                           // 退出线程
+    return NULL;                                                  // 返回NULL
+}
+
+// 检索元素的线程函数
+void* getElement(void* threadid) { 
+    intptr_t tid;                                                 // 线程id
+    tid = (intptr_t)threadid;                                     // 将void*类型的threadid转换为long类型
+    cout << tid << endl;                                          // 输出线程id
+    int tmp = TEST_COUNT/NUM_THREADS;                             // 每个线程需要检索的元素个数
+
+    // 循环检索元素
+    for (int i = tid * tmp, count = 0; count < tmp; i++) {                  
+        count++;                                                  // 计数器加1
+        skipList->search_element(rand() % TEST_COUNT);            // 随机生成一个键值并检索跳表
+    }
+    pthread_exit(NULL);                                           // 退出线程
+    return NULL;                                                  // 返回NULL
+}
+
+atomic<int> writers_running{0};                                   // 仍在运行的写线程数
+vector<uint32_t> read_latencies[MIXED_READERS];                   // 每个读线程记录的查找延迟（纳秒）
+
+// 读写混合模式下的插入线程
+void* mixedInsertElement(void* threadid) {
+    intptr_t tid = (intptr_t)threadid;
+    unsigned int seed = (unsigned int)tid + 1;                    // rand_r 避免 rand() 的全局锁
+    int tmp = MIXED_TEST_COUNT / MIXED_WRITERS;
+    for (int count = 0; count < tmp; count++) {
+        skipList->insert_element(rand_r(&seed) % MIXED_TEST_COUNT, "a");
+    }
+    writers_running--;
+    pthread_exit(NULL);
+    return NULL;
+}
+
+// 读写混合模式下的查找线程：只要还有写线程在运行就持续查找
+void* mixedGetElement(void* threadid) {
+    intptr_t tid = (intptr_t)threadid;
+    unsigned int seed = (unsigned int)tid + 1000;
+    vector<uint32_t>& latencies = read_latencies[tid];
+    latencies.reserve(MIXED_TEST_COUNT / MIXED_READERS);
+    while (writers_running > 0 && latencies.size() < latencies.capacity()) {
+        int key = rand_r(&seed) % MIXED_TEST_COUNT;
+        auto begin = chrono::steady_clock::now();
+        skipList->search_element(key);
+        auto end = chrono::steady_clock::now();
+        latencies.push_back((uint32_t)chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+    }
+    pthread_exit(NULL);
+    return NULL;
+}
+
+// 读写混合测试，输出查找延迟的 p50 / p99
+void mixedTest() {
+    pthread_t writers[MIXED_WRITERS];
+    pthread_t readers[MIXED_READERS];
+    writers_running = MIXED_WRITERS;
+
+    auto start = chrono::high_resolution_clock::now();
+    for (intptr_t i = 0; i < MIXED_WRITERS; i++) {
+        pthread_create(&writers[i], NULL, mixedInsertElement, (void*)i);
+    }
+    for (intptr_t i = 0; i < MIXED_READERS; i++) {
+        pthread_create(&readers[i], NULL, mixedGetElement, (void*)i);
+    }
+    for (int i = 0; i < MIXED_WRITERS; i++) {
+        pthread_join(writers[i], NULL);
+    }
+    for (int i = 0; i < MIXED_READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+
+    vector<uint32_t> all;
+    for (int i = 0; i < MIXED_READERS; i++) {
+        all.insert(all.end(), read_latencies[i].begin(), read_latencies[i].end());
+    }
+    if (all.empty()) {
+        cout << "No lookups recorded" << endl;
+        return;
+    }
+    size_t p50 = all.size() * 50 / 100;
+    size_t p99 = all.size() * 99 / 100;
+    nth_element(all.begin(), all.begin() + p50, all.end());
+    uint32_t p50_ns = all[p50];
+    nth_element(all.begin(), all.begin() + p99, all.end());
+    uint32_t p99_ns = all[p99];
+
+    cout << "Elapsed time: " << elapsed.count() << " s\n";
+    cout << "Lookups: " << all.size() << ", p50: " << p50_ns << " ns, p99: " << p99_ns << " ns" << endl;
+}
+
+// 运行方式：./stress_test 只插入；./stress_test mixed 读写混合并统计查找延迟
+int main(int argc, char* argv[]) { 
+    srand(time(NULL));
+
+    if (argc > 1 && strcmp(argv[1], "mixed") == 0) {
+        mixedTest();
+        pthread_exit(NULL);
+    }
+
+    {
+        pthread_t threads[NUM_THREADS];                           // 创建线程数组
+        int rc;                                                   // 用于存储pthread_create函数的返回值
+        int i;                                                    // 循环变量
+
+        auto start = chrono::high_resolution_clock::now();        // 记录开始时间
+
+        // 创建插入元素的线程
+        for (i = 0; i < NUM_THREADS; i++) {
+            cout << "main() : creating thread, " << i << endl;    // 输出线程创建信息
+            rc = pthread_create(&threads[i], NULL, insertElement, (void *)i);  // 创建线程
+
+            if (rc) {                                             // 如果创建线程失败
+                cout << "Error:unable to create thread," << rc << endl;  // 输出错误信息
+                exit(-1);                                         // 退出程序
+            }
+        }
+
+        void *ret;                                                // 用于存储线程返回值
+        for(i = 0; i < NUM_THREADS; i++) {                        // 循环等待线程结束
+            if (pthread_join(threads[i], &ret) != 0) { 
+                perror("pthread_create() error");                 // 输出错误信息
+                exit(3);                                          // 退出程序
+            }
+        }
+
+        auto finish = chrono::high_resolution_clock::now();       // 记录结束时间
+        chrono::duration<double> elapsed = finish - start;        // 计算时间差
+        cout << "Elapsed time: " << elapsed.count() << " s\n";    // 输出时间差
+    }
+
+    /*
+    {
+        pthread_t threads[NUM_THREADS];                           // 创建线程数组
+        int rc;                                                   // 用于存储pthread_create函数的返回值
+        int i;                                                    // 循环变量
+
+        auto start = chrono::high_resolution_clock::now();        // 记录开始时间
+
+        // 创建插入元素的线程
+        for (i = 0; i < NUM_THREADS; i++) {
+            cout << "main() : creating thread, " << i << endl;    // 输出线程创建信息
+            rc = pthread_create(&threads[i], NULL, getElement, (void *)i);  // 创建线程
+
+            if (rc) {                                             // 如果创建线程失败
+                cout << "Error:unable to create thread," << rc << endl;  // 输出错误信息
+                exit(-1);                                         // 退出程序
+            }
+        }
+
+        void *ret;                                                // 用于存储线程返回值
+        for(i = 0; i < NUM_THREADS; i++) {                        // 循环等待线程结束
+            if (pthread_join(threads[i], &ret) != 0) { 
+                perror("pthread_create() error");                 // 输出错误信息
+                exit(3);                                          // 退出程序
+            }
+        }
+
+        auto finish = chrono::high_resolution_clock::now();       // 记录结束时间
+        chrono::duration<double> elapsed = finish - start;        // 计算时间差
+        cout << "Elapsed time: " << elapsed.count() << " s\n";    // 输出时间差
+    }
+    */
+
+    pthread_exit(NULL);                                           // 退出线程
+
+    return 0;
 }
\ No newline at end of file
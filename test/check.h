@@ -0,0 +1,27 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <iostream>
+#include <string>
+
+/*
+ * 回归测试共用的检查函数
+ *   expect：输出 [OK] / [FAIL] 和说明，失败时计数
+ *   check_summary：输出汇总，返回 main 的退出码
+ */
+
+inline int failures = 0; // 失败的检查数
+
+inline void expect(bool condition, const std::string& message) {
+    std::cout << (condition ? "[OK]   " : "[FAIL] ") << message << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+inline int check_summary() {
+    std::cout << (failures == 0 ? "All passed" : "Some checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+#define TIMING_WHEEL_TICK_MS 100 // 时间轮的刻度（毫秒）
+#define TIMING_WHEEL_LEVELS 4 // 层数
+#define TIMING_WHEEL_ROOT_BITS 8 // 第 0 层 256 个槽
+#define TIMING_WHEEL_LEVEL_BITS 6 // 其余各层 64 个槽
+
+/* ************************************************************************
+> 分层时间轮，按过期时间索引条目，用于 TTL 过期
+> 结构（与 Linux 内核的定时器轮相同）：
+    > 第 0 层 256 个槽，每槽 1 个刻度；第 1 ~ 3 层各 64 个槽，每槽分别覆盖 2^8、2^14、2^20 个刻度
+    > 条目按"距离当前刻度还有多久"放入能容纳它的最低一层，槽下标取过期刻度的对应位
+    > 每前进一个刻度，触发第 0 层当前槽中的全部条目；第 0 层转满一圈时，
+      把上一层的下一个槽取出来重新放置（级联），高层的条目逐步下沉到第 0 层
+    > 超出最高层范围（100ms 刻度下约 77 天）的条目先放在最高层，级联时再按真实过期时间重新放置
+    > 条目保存精确的过期时间：前进到的最后一个刻度中尚未过期的条目放入 _pending，下次前进时先检查，
+      因此 advance(now) 取出的恰好是过期时间不晚于 now 的条目，不会因为刻度而推迟
+> 代价：
+    > schedule 为 O(1)；advance 的代价与经过的刻度数和到期（及级联）的条目数成正比，与条目总数无关
+> 时间轮本身不是线程安全的，由使用者加锁；条目不支持取消，使用者在条目触发时检查它是否仍然有效
+ ************************************************************************/
+
+template <typename T>
+class TimingWheel {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    TimingWheel(int tick_ms = TIMING_WHEEL_TICK_MS); // 构造函数
+
+    void schedule(const T& item, TimePoint expire_time); // 添加条目
+    size_t advance(TimePoint now, std::vector<T>& expired); // 前进到 now，取出所有到期的条目
+    size_t size() const; // 条目数
+    void clear(); // 清空
+
+private:
+    struct Entry {
+        T item;
+        TimePoint expire_time; // 过期时间
+        uint64_t expire_tick; // 过期时间所在的刻度
+    };
+
+    uint64_t tick_of(TimePoint t) const; // 时间点所在的刻度
+    void place(Entry&& entry); // 按距离当前刻度的远近放入对应的层
+    void cascade(int level); // 把某层的当前槽重新放置
+
+    std::vector<Entry> _root[1 << TIMING_WHEEL_ROOT_BITS]; // 第 0 层
+    std::vector<Entry> _levels[TIMING_WHEEL_LEVELS - 1][1 << TIMING_WHEEL_LEVEL_BITS]; // 第 1 层及以上
+    std::vector<Entry> _cascading; // 级联时取出的槽，复用其容量
+    std::vector<Entry> _pending; // 所在刻度已经处理过、但还没有过期的条目
+    int _tick_ms; // 刻度（毫秒）
+    uint64_t _current; // 已经处理到的刻度
+    size_t _size; // 条目数
+};
+
+/**
+ * 构造函数
+ * @param tick_ms 刻度（毫秒），刻度越小前进时经过的槽越多，每个槽中的条目越少
+ */
+template <typename T>
+TimingWheel<T>::TimingWheel(int tick_ms) : _tick_ms(tick_ms > 0 ? tick_ms : 1), _size(0) {
+    _current = tick_of(std::chrono::steady_clock::now());
+}
+
+template <typename T>
+uint64_t TimingWheel<T>::tick_of(TimePoint t) const {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+    return ms > 0 ? (uint64_t)ms / _tick_ms : 0;
+}
+
+/**
+ * 添加条目
+ * @param item 条目
+ * @param expire_time 过期时间
+ * @note 过期时间所在的刻度已经处理过时（包括已经过期的条目）放入 _pending，下次前进时检查
+ */
+template <typename T>
+void TimingWheel<T>::schedule(const T& item, TimePoint expire_time) {
+    uint64_t expire_tick = tick_of(expire_time);
+    if (expire_tick <= _current) {
+        _pending.push_back(Entry{item, expire_time, expire_tick});
+    } else {
+        place(Entry{item, expire_time, expire_tick});
+    }
+    _size++;
+}
+
+/**
+ * 按距离当前刻度的远近放入对应的层
+ * @note 级联时条目的过期刻度可能等于当前刻度，此时放入第 0 层的当前槽，随后在同一刻度触发
+ */
+template <typename T>
+void TimingWheel<T>::place(Entry&& entry) {
+    uint64_t delta = entry.expire_tick - _current;
+    if (delta < (1ULL << TIMING_WHEEL_ROOT_BITS)) {
+        _root[entry.expire_tick & ((1 << TIMING_WHEEL_ROOT_BITS) - 1)].push_back(std::move(entry));
+        return;
+    }
+    for (int level = 1; level < TIMING_WHEEL_LEVELS; level++) {
+        int shift = TIMING_WHEEL_ROOT_BITS + level * TIMING_WHEEL_LEVEL_BITS;
+        bool last = level == TIMING_WHEEL_LEVELS - 1;
+        if (delta < (1ULL << shift) || last) {
+            // 超出最高层范围时按最高层能表示的最远刻度放置，级联时再按真实过期刻度重新放置
+            uint64_t tick = delta < (1ULL << shift) ? entry.expire_tick : _current + (1ULL << shift) - 1;
+            size_t index = (tick >> (shift - TIMING_WHEEL_LEVEL_BITS)) & ((1 << TIMING_WHEEL_LEVEL_BITS) - 1);
+            _levels[level - 1][index].push_back(std::move(entry));
+            return;
+        }
+    }
+}
+
+/**
+ * 把第 level 层中与当前刻度对应的槽取出，重新放置
+ */
+template <typename T>
+void TimingWheel<T>::cascade(int level) {
+    int shift = TIMING_WHEEL_ROOT_BITS + (level - 1) * TIMING_WHEEL_LEVEL_BITS;
+    size_t index = (_current >> shift) & ((1 << TIMING_WHEEL_LEVEL_BITS) - 1);
+    _cascading.clear();
+    _cascading.swap(_levels[level - 1][index]);
+    for (Entry& entry : _cascading) {
+        place(std::move(entry));
+    }
+}
+
+/**
+ * 前进到 now
+ * @param now 当前时间
+ * @param expired 输出，到期的条目追加在末尾
+ * @return size_t 到期的条目数
+ * @note 第 0 层转满一圈时先从最高的需要级联的层开始级联，下沉到低层当前槽的条目随后在低层级联
+ */
+template <typename T>
+size_t TimingWheel<T>::advance(TimePoint now, std::vector<T>& expired) {
+    uint64_t target = tick_of(now);
+    size_t fired = 0;
+
+    // 先检查上次留下的条目
+    size_t kept = 0;
+    for (Entry& entry : _pending) {
+        if (entry.expire_time <= now) {
+            expired.push_back(std::move(entry.item));
+            fired++;
+        } else {
+            _pending[kept++] = std::move(entry);
+        }
+    }
+    _pending.erase(_pending.begin() + kept, _pending.end());
+
+    if (_size == fired + _pending.size() && _current < target) { // 轮中没有条目时直接跳到目标刻度
+        _current = target;
+    }
+    while (_current < target) {
+        _current++;
+        if ((_current & ((1 << TIMING_WHEEL_ROOT_BITS) - 1)) == 0) {
+            int top = 1;
+            while (top < TIMING_WHEEL_LEVELS - 1 &&
+                   (_current & ((1ULL << (TIMING_WHEEL_ROOT_BITS + top * TIMING_WHEEL_LEVEL_BITS)) - 1)) == 0) {
+                top++;
+            }
+            for (int level = top; level >= 1; level--) {
+                cascade(level);
+            }
+        }
+
+        std::vector<Entry>& slot = _root[_current & ((1 << TIMING_WHEEL_ROOT_BITS) - 1)];
+        for (Entry& entry : slot) {
+            if (entry.expire_time <= now) {
+                expired.push_back(std::move(entry.item));
+                fired++;
+            } else { // 只可能出现在最后一个刻度
+                _pending.push_back(std::move(entry));
+            }
+        }
+        slot.clear(); // 保留容量，下一圈复用
+    }
+    _size -= fired;
+    return fired;
+}
+
+template <typename T>
+size_t TimingWheel<T>::size() const {
+    return _size;
+}
+
+template <typename T>
+void TimingWheel<T>::clear() {
+    for (auto& slot : _root) {
+        slot.clear();
+    }
+    for (auto& level : _levels) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    _pending.clear();
+    _size = 0;
+}
+
+#endif
@@ -0,0 +1,523 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include "snapshot.h"
+
+#define WAL_OP_INSERT 1          // 插入记录
+#define WAL_OP_DELETE 2          // 删除记录
+#define WAL_OP_CLEAR 3           // 清空记录
+#define WAL_PERMANENT -1         // 永不过期的绝对过期时间
+#define WAL_FLUSH_INTERVAL 1000  // EVERY_N_MS 策略默认的刷盘间隔（毫秒）
+
+/* ************************************************************************
+> 预写日志（Write-Ahead Log）
+> 文件组织：
+    > 日志由多个段文件组成：<base>.00000001、<base>.00000002 ...，编号递增
+    > 每次持久化快照前调用 rotate() 切换到新段，快照写成功后删除旧段
+    > 恢复时先加载快照，再按编号顺序重放所有段（重放全部历史是幂等的，见 SkipListWithCache::open_wal）
+> 记录格式：
+    > [ u32 负载长度 | u32 负载 CRC32 | 负载 ]
+    > 负载：[ u8 操作 | u32 键长度 | 键 | u32 值长度 | 值 | i64 绝对过期时间（毫秒，system_clock） ]
+    > 过期时间使用绝对时间，重启后剩余时间依然正确；删除记录的值为空
+    > 清空记录的负载只有操作码，重放时之前的所有修改（包括快照中的键）都被清空
+    > 崩溃时最后一条记录可能只写了一半，重放时遇到长度或 CRC 不对的记录即停止
+> 刷盘策略：
+    > ALWAYS：commit 返回时记录已 fdatasync
+    > EVERY_N_MS：commit 返回时记录已写入内核，后台线程每隔 N 毫秒 fdatasync 一次
+    > OS：commit 返回时记录已写入内核，何时落盘由操作系统决定
+> 组提交：
+    > append 只把记录追加到内存缓冲区，并返回记录序号
+    > commit 等待自己的序号写出：没有人在写时自己成为 leader，把缓冲区中所有线程的记录一次写出（并刷盘）；
+      否则等待当前 leader 完成。并发的写线程因此共享同一次 write 和 fdatasync
+> 错误处理：
+    > write 或 fdatasync 失败后不再推进已写出、已刷盘的序号，日志进入失败状态并保持（failed() 返回 true），
+      之后所有的 commit 都返回 false：无法确定段文件中已经写入了哪些内容，fdatasync 失败后也不能靠重试补救
+ ************************************************************************/
+
+enum class WalSyncPolicy {
+    ALWAYS,     // 每次提交都刷盘
+    EVERY_N_MS, // 每隔 N 毫秒刷盘
+    OS          // 由操作系统决定
+};
+
+class WriteAheadLog {
+public:
+    WriteAheadLog();
+    ~WriteAheadLog();
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    bool open(const std::string& base, WalSyncPolicy policy, int interval_ms = WAL_FLUSH_INTERVAL); // 打开日志，写入新的段
+    void close(); // 写出并刷盘所有记录后关闭
+    bool is_open() const; // 是否已打开
+
+    template <typename K, typename V>
+    uint64_t append_insert(const K& key, const V& value, int64_t expire_at_ms); // 追加插入记录，返回序号
+    template <typename K>
+    uint64_t append_delete(const K& key); // 追加删除记录，返回序号
+    uint64_t append_clear(); // 追加清空记录，返回序号
+    bool commit(uint64_t seq); // 按刷盘策略等待序号 seq 及之前的记录写出，失败返回 false
+    bool failed(); // 是否因写出或刷盘失败进入失败状态
+
+    uint64_t rotate(); // 切换到新段，返回新段编号
+    void remove_segments_before(uint64_t segment); // 删除编号小于 segment 的段
+
+    template <typename K, typename V, typename Apply>
+    static uint64_t replay(const std::string& base, Apply apply); // 按顺序重放所有段
+
+    static int64_t expire_at_ms(int ttl_seconds); // 把剩余秒数转换为绝对过期时间
+    static int ttl_seconds(int64_t expire_at_ms); // 把绝对过期时间转换为剩余秒数，已过期返回 0
+
+private:
+    static std::vector<std::pair<uint64_t, std::string>> list_segments(const std::string& base); // 按编号排列的段
+    static std::string segment_path(const std::string& base, uint64_t segment); // 段文件路径
+    bool open_segment(uint64_t segment); // 打开一个新段
+    uint64_t append_record(uint8_t op); // 把 _record 加上长度和 CRC 后追加到缓冲区
+    bool flush(uint64_t seq, bool sync, std::unique_lock<std::mutex>& lock); // 组提交，失败返回 false
+    void flush_loop(); // EVERY_N_MS 策略的后台刷盘线程
+    template <typename T>
+    static bool decode_field(const char*& p, const char* end, T& out); // 重放时解码一个字段
+    static bool skip_field(const char*& p, const char* end); // 重放时跳过一个字段
+
+    std::string _base; // 段文件路径前缀
+    WalSyncPolicy _policy; // 刷盘策略
+    int _interval_ms; // 刷盘间隔
+    int _fd; // 当前段的文件描述符
+    uint64_t _segment; // 当前段编号
+
+    std::mutex _mtx; // 保护以下所有成员
+    std::condition_variable _cv; // leader 完成时唤醒等待者
+    std::string _pending; // 尚未写出的记录
+    std::string _flushing; // leader 正在写出的记录，与 _pending 交换使用
+    std::string _record; // 编码记录时复用的缓冲区
+    uint64_t _appended_seq; // 最后追加的记录序号
+    uint64_t _written_seq; // 已写入内核的记录序号
+    uint64_t _synced_seq; // 已刷盘的记录序号
+    bool _leader; // 是否有线程正在写出
+    bool _failed; // 写出或刷盘失败，一旦置位不再清除
+
+    std::atomic<bool> _running; // 后台刷盘线程是否运行
+    std::thread _flush_thread; // 后台刷盘线程
+};
+
+inline WriteAheadLog::WriteAheadLog()
+    : _policy(WalSyncPolicy::ALWAYS), _interval_ms(WAL_FLUSH_INTERVAL), _fd(-1), _segment(0),
+      _appended_seq(0), _written_seq(0), _synced_seq(0), _leader(false), _failed(false), _running(false) {}
+
+inline WriteAheadLog::~WriteAheadLog() {
+    close();
+}
+
+inline std::string WriteAheadLog::segment_path(const std::string& base, uint64_t segment) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%08llu", (unsigned long long)segment);
+    return base + suffix;
+}
+
+inline std::vector<std::pair<uint64_t, std::string>> WriteAheadLog::list_segments(const std::string& base) {
+    std::vector<std::pair<uint64_t, std::string>> segments;
+    std::filesystem::path base_path(base);
+    std::filesystem::path dir = base_path.has_parent_path() ? base_path.parent_path() : std::filesystem::path(".");
+    std::string prefix = base_path.filename().string() + ".";
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() != prefix.size() + 8 || name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        std::string digits = name.substr(prefix.size());
+        if (!std::all_of(digits.begin(), digits.end(), ::isdigit)) {
+            continue;
+        }
+        segments.emplace_back(std::stoull(digits), entry.path().string());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+/**
+ * 打开日志
+ * @param base 段文件路径前缀，如 store/wal
+ * @param policy 刷盘策略
+ * @param interval_ms EVERY_N_MS 策略的刷盘间隔
+ * @return bool 是否成功
+ * @description 已有的段保持不变（应先重放），新记录写入编号更大的新段
+ */
+inline bool WriteAheadLog::open(const std::string& base, WalSyncPolicy policy, int interval_ms) {
+    close();
+    _base = base;
+    _policy = policy;
+    _failed = false;
+    _interval_ms = interval_ms > 0 ? interval_ms : WAL_FLUSH_INTERVAL;
+
+    std::vector<std::pair<uint64_t, std::string>> segments = list_segments(base);
+    if (!open_segment(segments.empty() ? 1 : segments.back().first + 1)) {
+        return false;
+    }
+
+    if (_policy == WalSyncPolicy::EVERY_N_MS) {
+        _running = true;
+        _flush_thread = std::thread(&WriteAheadLog::flush_loop, this);
+    }
+    return true;
+}
+
+inline bool WriteAheadLog::open_segment(uint64_t segment) {
+    std::string path = segment_path(_base, segment);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    // 新段的目录项落盘之前，即使记录已经 fdatasync，崩溃后整个段文件也可能消失
+    if (!snapshot_sync_parent(path)) {
+        std::cerr << "Failed to sync directory of wal segment: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+    _fd = fd;
+    _segment = segment;
+    return true;
+}
+
+/**
+ * 关闭日志
+ * @return void
+ * @description 停止后台线程，写出并刷盘所有记录
+ */
+inline void WriteAheadLog::close() {
+    if (_running) {
+        _running = false;
+        _cv.notify_all();
+        if (_flush_thread.joinable()) {
+            _flush_thread.join();
+        }
+    }
+    std::unique_lock<std::mutex> lock(_mtx);
+    if (_fd < 0) {
+        return;
+    }
+    if (!flush(_appended_seq, true, lock)) {
+        std::cerr << "Wal closed with unwritten records: " << segment_path(_base, _segment) << std::endl;
+    }
+    ::close(_fd);
+    _fd = -1;
+}
+
+inline bool WriteAheadLog::is_open() const {
+    return _fd >= 0;
+}
+
+inline int64_t WriteAheadLog::expire_at_ms(int ttl_seconds) {
+    if (ttl_seconds == WAL_PERMANENT) {
+        return WAL_PERMANENT;
+    }
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+    return now.count() + (int64_t)ttl_seconds * 1000;
+}
+
+inline int WriteAheadLog::ttl_seconds(int64_t expire_at_ms) {
+    if (expire_at_ms == WAL_PERMANENT) {
+        return WAL_PERMANENT;
+    }
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+    int64_t remaining = expire_at_ms - now.count();
+    return remaining <= 0 ? 0 : (int)((remaining + 999) / 1000); // 向上取整，避免把未过期的记录当成过期
+}
+
+inline uint64_t WriteAheadLog::append_record(uint8_t op) {
+    _record[0] = (char)op;
+    uint32_t meta[2] = {(uint32_t)_record.size(), snapshot_crc32(_record.data(), _record.size())};
+    _pending.append(reinterpret_cast<const char*>(meta), sizeof(meta));
+    _pending += _record;
+    return ++_appended_seq;
+}
+
+/**
+ * 追加插入记录
+ * @param key 键
+ * @param value 值
+ * @param expire_at_ms 绝对过期时间，WAL_PERMANENT 表示永不过期
+ * @return uint64_t 记录序号，交给 commit 等待落盘
+ * @description 只写内存缓冲区，调用者可以在持有跳表写锁时调用，保证日志顺序与修改顺序一致
+ */
+template <typename K, typename V>
+uint64_t WriteAheadLog::append_insert(const K& key, const V& value, int64_t expire_at_ms) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _record.assign(1, '\0');
+
+    size_t pos = _record.size();
+    _record.append(sizeof(uint32_t), '\0');
+    SnapshotCodec<K>::encode(key, _record);
+    uint32_t len = _record.size() - pos - sizeof(uint32_t);
+    memcpy(&_record[pos], &len, sizeof(len));
+
+    pos = _record.size();
+    _record.append(sizeof(uint32_t), '\0');
+    SnapshotCodec<V>::encode(value, _record);
+    len = _record.size() - pos - sizeof(uint32_t);
+    memcpy(&_record[pos], &len, sizeof(len));
+
+    _record.append(reinterpret_cast<const char*>(&expire_at_ms), sizeof(expire_at_ms));
+    return append_record(WAL_OP_INSERT);
+}
+
+/**
+ * 追加删除记录
+ * @param key 键
+ * @return uint64_t 记录序号
+ */
+template <typename K>
+uint64_t WriteAheadLog::append_delete(const K& key) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _record.assign(1, '\0');
+
+    size_t pos = _record.size();
+    _record.append(sizeof(uint32_t), '\0');
+    SnapshotCodec<K>::encode(key, _record);
+    uint32_t len = _record.size() - pos - sizeof(uint32_t);
+    memcpy(&_record[pos], &len, sizeof(len));
+
+    _record.append(sizeof(uint32_t), '\0'); // 空值
+    int64_t expire = WAL_PERMANENT;
+    _record.append(reinterpret_cast<const char*>(&expire), sizeof(expire));
+    return append_record(WAL_OP_DELETE);
+}
+
+/**
+ * 追加清空记录
+ * @return uint64_t 记录序号
+ */
+inline uint64_t WriteAheadLog::append_clear() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _record.assign(1, '\0');
+    return append_record(WAL_OP_CLEAR);
+}
+
+/**
+ * 提交
+ * @param seq append_* 返回的记录序号
+ * @return bool 记录是否已按刷盘策略写出；日志处于失败状态时返回 false
+ * @description 不要在持有跳表锁时调用，否则其他写线程无法加入同一次组提交
+ */
+inline bool WriteAheadLog::commit(uint64_t seq) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    if (_fd < 0) {
+        return true;
+    }
+    return flush(seq, _policy == WalSyncPolicy::ALWAYS, lock);
+}
+
+inline bool WriteAheadLog::failed() {
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _failed;
+}
+
+/**
+ * 组提交
+ * @param seq 需要写出的最大序号
+ * @param sync 是否需要刷盘
+ * @param lock 已持有的 _mtx
+ * @return bool 是否成功，失败时不推进 _written_seq / _synced_seq，并置位 _failed
+ */
+inline bool WriteAheadLog::flush(uint64_t seq, bool sync, std::unique_lock<std::mutex>& lock) {
+    while (_written_seq < seq || (sync && _synced_seq < seq)) {
+        if (_failed) { // 之后追加的记录也不会再写出，丢弃缓冲区避免无限增长
+            _pending.clear();
+            return false;
+        }
+        if (_leader) { // 已有 leader，等它写完后再检查
+            _cv.wait(lock);
+            continue;
+        }
+
+        _leader = true;
+        _flushing.swap(_pending); // 带走缓冲区中所有线程的记录
+        uint64_t upto = _appended_seq;
+        int fd = _fd;
+        lock.unlock();
+
+        bool ok = true;
+        const char* p = _flushing.data();
+        size_t left = _flushing.size();
+        while (left > 0) {
+            ssize_t n = ::write(fd, p, left);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Failed to write wal: " << strerror(errno) << std::endl;
+                ok = false;
+                break;
+            }
+            p += n;
+            left -= n;
+        }
+        if (ok && sync && fdatasync(fd) != 0) {
+            std::cerr << "Failed to sync wal: " << strerror(errno) << std::endl;
+            ok = false;
+        }
+        _flushing.clear();
+
+        lock.lock();
+        if (ok) {
+            _written_seq = upto;
+            if (sync) {
+                _synced_seq = upto;
+            }
+        } else {
+            _failed = true;
+        }
+        _leader = false;
+        _cv.notify_all();
+    }
+    return true;
+}
+
+// EVERY_N_MS 策略：每隔 _interval_ms 把已追加的记录写出并刷盘
+inline void WriteAheadLog::flush_loop() {
+    std::unique_lock<std::mutex> lock(_mtx);
+    while (_running) {
+        _cv.wait_for(lock, std::chrono::milliseconds(_interval_ms), [this] { return !_running; });
+        flush(_appended_seq, true, lock);
+    }
+}
+
+/**
+ * 切换到新段
+ * @return uint64_t 新段编号，日志处于失败状态时返回 0
+ * @description 先把当前段全部写出并刷盘。在持久化快照前调用（此时不能有并发的修改），
+ *              快照写成功后用返回值调用 remove_segments_before
+ */
+inline uint64_t WriteAheadLog::rotate() {
+    std::unique_lock<std::mutex> lock(_mtx);
+    if (_fd < 0 || !flush(_appended_seq, true, lock)) {
+        return 0;
+    }
+    while (_leader) {
+        _cv.wait(lock);
+    }
+    int old_fd = _fd;
+    if (open_segment(_segment + 1)) {
+        ::close(old_fd);
+    }
+    return _segment;
+}
+
+/**
+ * 删除旧段
+ * @param segment 编号小于它的段都会被删除
+ */
+inline void WriteAheadLog::remove_segments_before(uint64_t segment) {
+    for (const auto& seg : list_segments(_base)) {
+        if (seg.first < segment) {
+            std::remove(seg.second.c_str());
+        }
+    }
+}
+
+/**
+ * 重放日志
+ * @param base 段文件路径前缀
+ * @param apply 回调 apply(op, key, value, expire_at_ms)，op 为 WAL_OP_INSERT、WAL_OP_DELETE 或 WAL_OP_CLEAR（键值为空）
+ * @return uint64_t 重放的记录数
+ * @description 按编号顺序读取所有段，某一段中遇到不完整或校验失败的记录时，跳过该段剩余部分
+ */
+// 解码一个 [ u32 长度 | 内容 ] 字段
+template <typename T>
+bool WriteAheadLog::decode_field(const char*& p, const char* end, T& out) {
+    uint32_t len;
+    if (end - p < (ptrdiff_t)sizeof(len)) {
+        return false;
+    }
+    memcpy(&len, p, sizeof(len));
+    p += sizeof(len);
+    if ((size_t)(end - p) < len || !SnapshotCodec<T>::decode(p, len, out)) {
+        return false;
+    }
+    p += len;
+    return true;
+}
+
+// 跳过一个 [ u32 长度 | 内容 ] 字段
+inline bool WriteAheadLog::skip_field(const char*& p, const char* end) {
+    uint32_t len;
+    if (end - p < (ptrdiff_t)sizeof(len)) {
+        return false;
+    }
+    memcpy(&len, p, sizeof(len));
+    p += sizeof(len);
+    if ((size_t)(end - p) < len) {
+        return false;
+    }
+    p += len;
+    return true;
+}
+
+template <typename K, typename V, typename Apply>
+uint64_t WriteAheadLog::replay(const std::string& base, Apply apply) {
+    uint64_t replayed = 0;
+    for (const auto& seg : list_segments(base)) {
+        std::ifstream in(seg.second, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        const char* p = data.data();
+        const char* end = p + data.size();
+        while (end - p >= 8) {
+            uint32_t meta[2];
+            memcpy(meta, p, sizeof(meta));
+            if ((size_t)(end - p - 8) < meta[0] || meta[0] < 1 || snapshot_crc32(p + 8, meta[0]) != meta[1]) {
+                std::cerr << "Wal record corrupted, skip the rest of " << seg.second << std::endl;
+                break;
+            }
+            const char* rec = p + 8;
+            const char* rec_end = rec + meta[0];
+            p = rec_end;
+
+            uint8_t op = (uint8_t)rec[0];
+            rec++;
+            K key{};
+            V value{};
+            int64_t expire = WAL_PERMANENT;
+            bool corrupted = op == WAL_OP_CLEAR
+                ? rec != rec_end // 清空记录只有操作码
+                : (!decode_field(rec, rec_end, key) ||
+                   (op == WAL_OP_INSERT && !decode_field(rec, rec_end, value)) ||
+                   (op == WAL_OP_DELETE && !skip_field(rec, rec_end)) ||
+                   rec_end - rec != (ptrdiff_t)sizeof(expire));
+            if (corrupted) {
+                std::cerr << "Wal record corrupted, skip the rest of " << seg.second << std::endl;
+                break;
+            }
+            if (op != WAL_OP_CLEAR) {
+                memcpy(&expire, rec, sizeof(expire));
+            }
+
+            apply(op, key, value, expire);
+            replayed++;
+        }
+    }
+    return replayed;
+}
+
+#endif